@@ -0,0 +1,653 @@
+/**
+ * @file libcacao/allocator.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/allocator.hpp>
+#include <libcacao/util/align.hpp>
+
+// Third Party Libraries
+
+#include <magic_enum.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <bit>
+#include <set>
+#include <string>
+#include <utility>
+
+using reglisse::maybe;
+using reglisse::none;
+using reglisse::some;
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   struct allocator_error_category : std::error_category
+   {
+      /**
+       * The name of the vkn object the error appeared from.
+       */
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "cacao_allocator";
+      }
+      /**
+       * Get the message associated with a specific error code.
+       */
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return std::string(magic_enum::enum_name(static_cast<allocator_error>(err)));
+      }
+   };
+
+   inline static const allocator_error_category allocator_category{};
+
+   auto make_error_condition(allocator_error code) -> std::error_condition
+   {
+      return std::error_condition({static_cast<int>(code), allocator_category});
+   }
+
+   namespace detail
+   {
+      enum class block_kind
+      {
+         buddy,
+         dedicated,
+         linear
+      };
+
+      struct memory_block
+      {
+         vk::Device device;
+         vk::UniqueDeviceMemory memory;
+         vk::MemoryPropertyFlags flags{};
+
+         u32 memory_type{};
+         u64 size{};
+         u64 non_coherent_atom_size{};
+
+         std::byte* p_mapped{nullptr};
+
+         block_kind kind{block_kind::buddy};
+         u64 pool_index{}; ///< Index of the allocator pool owning the block
+
+         std::vector<std::set<u64>> free_lists; ///< Free buddy nodes, indexed by order
+         u64 cursor{};                          ///< Linear allocation head
+
+         u64 allocation_count{};
+         u64 bytes_allocated{};
+         u64 bytes_requested{};
+      };
+   } // namespace detail
+
+   namespace
+   {
+      /**
+       * Smallest range handed out by the buddy allocator. Every buddy node of order `n` has a size
+       * of `min_node_size << n` and is aligned to its size.
+       */
+      constexpr u64 min_node_size = 256;
+
+      auto to_order(u64 node_size) noexcept -> u32
+      {
+         return static_cast<u32>(std::countr_zero(node_size) - std::countr_zero(min_node_size));
+      }
+
+      auto to_node_size(u32 order) noexcept -> u64 { return min_node_size << order; }
+
+      auto buddy_allocate(detail::memory_block& block, u32 order) -> maybe<u64>
+      {
+         auto& free_lists = block.free_lists;
+
+         u32 current = order;
+         while (current < std::size(free_lists) && std::empty(free_lists[current]))
+         {
+            ++current;
+         }
+
+         if (current >= std::size(free_lists))
+         {
+            return none;
+         }
+
+         const u64 offset = *std::begin(free_lists[current]);
+         free_lists[current].erase(std::begin(free_lists[current]));
+
+         // Split the node until it reaches the requested order, keeping the upper halves free
+         while (current > order)
+         {
+            --current;
+            free_lists[current].insert(offset + to_node_size(current));
+         }
+
+         return some(offset);
+      }
+
+      void buddy_free(detail::memory_block& block, u64 offset, u32 order)
+      {
+         auto& free_lists = block.free_lists;
+
+         // Merge the node with its buddy for as long as the buddy is free
+         while (order + 1 < std::size(free_lists))
+         {
+            const u64 buddy = offset ^ to_node_size(order);
+            const auto it = free_lists[order].find(buddy);
+            if (it == std::end(free_lists[order]))
+            {
+               break;
+            }
+
+            free_lists[order].erase(it);
+            offset = std::min(offset, buddy);
+            ++order;
+         }
+
+         free_lists[order].insert(offset);
+      }
+
+      auto largest_free_range(const detail::memory_block& block) noexcept -> u64
+      {
+         switch (block.kind)
+         {
+            case detail::block_kind::buddy:
+               for (auto order = std::size(block.free_lists); order > 0; --order)
+               {
+                  if (!std::empty(block.free_lists[order - 1]))
+                  {
+                     return to_node_size(static_cast<u32>(order - 1));
+                  }
+               }
+               return 0;
+            case detail::block_kind::linear:
+               return block.size - block.cursor;
+            default:
+               return 0;
+         }
+      }
+   } // namespace
+
+   memory_allocation::memory_allocation(memory_allocation&& other) noexcept :
+      mp_allocator(std::exchange(other.mp_allocator, nullptr)),
+      mp_block(std::exchange(other.mp_block, nullptr)), m_offset(other.m_offset),
+      m_size(other.m_size), m_order(other.m_order)
+   {}
+   memory_allocation::~memory_allocation() { release(); }
+
+   auto memory_allocation::operator=(memory_allocation&& rhs) noexcept -> memory_allocation&
+   {
+      if (this != &rhs)
+      {
+         release();
+
+         mp_allocator = std::exchange(rhs.mp_allocator, nullptr);
+         mp_block = std::exchange(rhs.mp_block, nullptr);
+         m_offset = rhs.m_offset;
+         m_size = rhs.m_size;
+         m_order = rhs.m_order;
+      }
+
+      return *this;
+   }
+
+   auto memory_allocation::memory() const noexcept -> vk::DeviceMemory
+   {
+      return mp_block ? mp_block->memory.get() : vk::DeviceMemory{};
+   }
+   auto memory_allocation::offset() const noexcept -> u64 { return m_offset; }
+   auto memory_allocation::size() const noexcept -> u64 { return m_size; }
+   auto memory_allocation::memory_flags() const noexcept -> vk::MemoryPropertyFlags
+   {
+      return mp_block ? mp_block->flags : vk::MemoryPropertyFlags{};
+   }
+
+   auto memory_allocation::is_mapped() const noexcept -> bool
+   {
+      return mp_block && mp_block->p_mapped;
+   }
+   auto memory_allocation::is_coherent() const noexcept -> bool
+   {
+      return (memory_flags() & vk::MemoryPropertyFlagBits::eHostCoherent) ==
+         vk::MemoryPropertyFlagBits::eHostCoherent;
+   }
+
+   auto memory_allocation::mapped() const noexcept -> std::span<std::byte>
+   {
+      if (is_mapped())
+      {
+         return {mp_block->p_mapped + m_offset, m_size}; // NOLINT
+      }
+
+      return {};
+   }
+
+   void memory_allocation::flush(u64 offset, u64 size) const
+   {
+      if (is_mapped() && !is_coherent())
+      {
+         mp_block->device.flushMappedMemoryRanges({to_mapped_range(offset, size)});
+      }
+   }
+   void memory_allocation::invalidate(u64 offset, u64 size) const
+   {
+      if (is_mapped() && !is_coherent())
+      {
+         mp_block->device.invalidateMappedMemoryRanges({to_mapped_range(offset, size)});
+      }
+   }
+
+   auto memory_allocation::to_mapped_range(u64 offset, u64 size) const -> vk::MappedMemoryRange
+   {
+      const u64 atom = std::max<u64>(mp_block->non_coherent_atom_size, 1);
+      const u64 begin = align_down(m_offset + offset, atom);
+      const u64 last = size == VK_WHOLE_SIZE ? m_offset + m_size : m_offset + offset + size;
+      const u64 end = std::min(align_up(last, atom), mp_block->size);
+
+      if (end == mp_block->size)
+      {
+         return {.memory = mp_block->memory.get(), .offset = begin, .size = VK_WHOLE_SIZE};
+      }
+
+      return {.memory = mp_block->memory.get(), .offset = begin, .size = end - begin};
+   }
+
+   void memory_allocation::release() noexcept
+   {
+      if (mp_allocator && mp_block)
+      {
+         mp_allocator->release(*this);
+      }
+
+      mp_allocator = nullptr;
+      mp_block = nullptr;
+   }
+
+   allocator::allocator(const allocator_create_info& info) :
+      m_device(info.device.logical()),
+      m_memory_properties(info.device.physical().getMemoryProperties()),
+      m_non_coherent_atom_size(info.device.physical().getProperties().limits.nonCoherentAtomSize),
+      m_separate_linear_resources(
+         info.device.physical().getProperties().limits.bufferImageGranularity > 1),
+      m_pools(std::size(m_block_sizes) * 2), m_transient_block_size(info.transient_block_size),
+      m_transient_pools(std::max<u64>(info.transient_frame_count, 1)), m_logger(info.logger)
+   {
+      for (auto& frame_pools : m_transient_pools)
+      {
+         frame_pools.resize(std::size(m_pools));
+      }
+
+      const u64 block_size = std::bit_ceil(std::max(info.block_size, min_node_size));
+
+      for (u32 i = 0; i < m_memory_properties.memoryTypeCount; ++i)
+      {
+         const auto heap_index = m_memory_properties.memoryTypes.at(i).heapIndex;
+         const u64 heap_size = m_memory_properties.memoryHeaps.at(heap_index).size;
+
+         // Small heaps, such as the resizable BAR window, can't afford large reservations
+         m_block_sizes.at(i) =
+            std::min(block_size, std::bit_floor(std::max(heap_size / 8, min_node_size)));
+      }
+
+      m_logger.debug("Device memory allocator created with {} byte blocks", block_size);
+   }
+   allocator::~allocator() = default;
+
+   auto allocator::allocate(const allocation_create_info& info) -> memory_allocation
+   {
+      std::scoped_lock lock{m_mutex};
+
+      std::vector<vk::MemoryPropertyFlags> candidates;
+      if (info.is_frequently_updated)
+      {
+         candidates.push_back(info.desired_mem_flags | vk::MemoryPropertyFlagBits::eDeviceLocal |
+                              vk::MemoryPropertyFlagBits::eHostVisible);
+      }
+      candidates.push_back(info.desired_mem_flags);
+      candidates.push_back(info.fallback_mem_flags);
+
+      bool is_type_found = false;
+      for (const auto& flags : candidates)
+      {
+         const auto memory_type = find_memory_type(info.requirements.memoryTypeBits, flags);
+         if (!memory_type)
+         {
+            continue;
+         }
+
+         is_type_found = true;
+
+         try
+         {
+            return allocate_from_type(memory_type.borrow(), info);
+         }
+         catch (const vk::OutOfDeviceMemoryError&)
+         {
+            // The device local & host visible heap is usually small, try the next candidate
+            m_logger.debug("Out of memory for memory type {}, trying next candidate",
+                           vk::to_string(flags));
+         }
+      }
+
+      if (!is_type_found)
+      {
+         throw runtime_error{
+            make_error_condition(allocator_error::failed_to_find_desired_memory_type)};
+      }
+
+      throw runtime_error{make_error_condition(allocator_error::out_of_device_memory)};
+   }
+
+   void allocator::begin_frame(u64 frame_index)
+   {
+      std::scoped_lock lock{m_mutex};
+
+      m_current_transient_frame = frame_index % std::size(m_transient_pools);
+
+      for (auto& pool : m_transient_pools[m_current_transient_frame])
+      {
+         for (auto& block : pool.blocks)
+         {
+            block->cursor = 0;
+            block->allocation_count = 0;
+            block->bytes_allocated = 0;
+            block->bytes_requested = 0;
+         }
+      }
+   }
+
+   auto allocator::statistics() const -> allocator_statistics
+   {
+      std::scoped_lock lock{m_mutex};
+
+      allocator_statistics stats{};
+      u64 total_free = 0;
+
+      const auto accumulate = [&](const detail::memory_block& block) {
+         stats.allocation_count += block.allocation_count;
+         stats.bytes_reserved += block.size;
+         stats.bytes_allocated += block.bytes_allocated;
+         stats.bytes_requested += block.bytes_requested;
+
+         switch (block.kind)
+         {
+            case detail::block_kind::buddy:
+               ++stats.block_count;
+               break;
+            case detail::block_kind::dedicated:
+               ++stats.dedicated_block_count;
+               break;
+            case detail::block_kind::linear:
+               ++stats.transient_block_count;
+               break;
+         }
+
+         total_free += block.size - block.bytes_allocated;
+         stats.largest_free_range =
+            std::max(stats.largest_free_range, largest_free_range(block));
+      };
+
+      for (const auto& pool : m_pools)
+      {
+         for (const auto& block : pool.blocks)
+         {
+            accumulate(*block);
+         }
+      }
+
+      for (const auto& frame_pools : m_transient_pools)
+      {
+         for (const auto& pool : frame_pools)
+         {
+            for (const auto& block : pool.blocks)
+            {
+               accumulate(*block);
+            }
+         }
+      }
+
+      if (total_free != 0)
+      {
+         stats.fragmentation = 1.0 -
+            static_cast<double>(stats.largest_free_range) / static_cast<double>(total_free);
+      }
+
+      return stats;
+   }
+
+   void allocator::log_statistics() const
+   {
+      const auto stats = statistics();
+
+      m_logger.info("Device memory: {} blocks, {} dedicated, {} transient, {} allocations",
+                    stats.block_count, stats.dedicated_block_count, stats.transient_block_count,
+                    stats.allocation_count);
+      m_logger.info("Device memory: {} bytes reserved, {} allocated, {} requested",
+                    stats.bytes_reserved, stats.bytes_allocated, stats.bytes_requested);
+      m_logger.info("Device memory: largest free range of {} bytes, {:.2f}% fragmentation",
+                    stats.largest_free_range, stats.fragmentation * 100.0);
+   }
+
+   auto allocator::find_memory_type(u32 type_filter,
+                                    const vk::MemoryPropertyFlags& properties) const noexcept
+      -> maybe<u32>
+   {
+      for (u32 i = 0; i < m_memory_properties.memoryTypeCount; ++i)
+      {
+         const auto& type = m_memory_properties.memoryTypes.at(i);
+         if ((type_filter & (1U << i)) && (type.propertyFlags & properties) == properties)
+         {
+            return some(i);
+         }
+      }
+
+      return none;
+   }
+
+   auto allocator::pool_index(u32 memory_type, bool is_linear) const noexcept -> u64
+   {
+      // Keeping linear and optimal resources apart removes the need to pad allocations to the
+      // bufferImageGranularity
+      return memory_type * 2 + (m_separate_linear_resources && !is_linear ? 1 : 0);
+   }
+
+   auto allocator::allocate_from_type(u32 memory_type, const allocation_create_info& info)
+      -> memory_allocation
+   {
+      const u64 index = pool_index(memory_type, info.is_linear);
+      const auto& requirements = info.requirements;
+
+      if (info.is_transient)
+      {
+         return allocate_linear(m_transient_pools[m_current_transient_frame][index], memory_type,
+                                requirements);
+      }
+
+      const u64 node_size = std::bit_ceil(
+         std::max({requirements.size, requirements.alignment, min_node_size}));
+
+      if (node_size > m_block_sizes.at(memory_type) / 2)
+      {
+         return allocate_dedicated(index, memory_type, requirements);
+      }
+
+      return allocate_buddy(index, memory_type, requirements);
+   }
+
+   auto allocator::allocate_buddy(u64 index, u32 memory_type,
+                                  const vk::MemoryRequirements& requirements) -> memory_allocation
+   {
+      auto& pool = m_pools[index];
+
+      const u64 node_size = std::bit_ceil(
+         std::max({requirements.size, requirements.alignment, min_node_size}));
+      const u32 order = to_order(node_size);
+
+      const auto make_allocation = [&](detail::memory_block& block, u64 offset) {
+         block.allocation_count += 1;
+         block.bytes_allocated += node_size;
+         block.bytes_requested += requirements.size;
+
+         memory_allocation allocation{};
+         allocation.mp_allocator = this;
+         allocation.mp_block = &block;
+         allocation.m_offset = offset;
+         allocation.m_size = requirements.size;
+         allocation.m_order = order;
+
+         return allocation;
+      };
+
+      for (auto& block : pool.blocks)
+      {
+         if (auto offset = buddy_allocate(*block, order))
+         {
+            return make_allocation(*block, offset.borrow());
+         }
+      }
+
+      auto block = create_block(memory_type, m_block_sizes.at(memory_type));
+      block->kind = detail::block_kind::buddy;
+      block->pool_index = index;
+      block->free_lists.resize(to_order(block->size) + 1);
+      block->free_lists.back().insert(0);
+
+      m_logger.debug("Reserved a {} byte block for memory type {} ({})", block->size, memory_type,
+                     vk::to_string(block->flags));
+
+      const u64 offset = buddy_allocate(*block, order).take();
+      auto& inserted = *pool.blocks.emplace_back(std::move(block));
+
+      return make_allocation(inserted, offset);
+   }
+
+   auto allocator::allocate_dedicated(u64 index, u32 memory_type,
+                                      const vk::MemoryRequirements& requirements)
+      -> memory_allocation
+   {
+      auto block = create_block(memory_type, requirements.size);
+      block->kind = detail::block_kind::dedicated;
+      block->pool_index = index;
+      block->allocation_count = 1;
+      block->bytes_allocated = requirements.size;
+      block->bytes_requested = requirements.size;
+
+      m_logger.debug("Dedicated {} byte allocation for memory type {} ({})", requirements.size,
+                     memory_type, vk::to_string(block->flags));
+
+      memory_allocation allocation{};
+      allocation.mp_allocator = this;
+      allocation.mp_block = m_pools[index].blocks.emplace_back(std::move(block)).get();
+      allocation.m_offset = 0;
+      allocation.m_size = requirements.size;
+
+      return allocation;
+   }
+
+   auto allocator::allocate_linear(memory_pool& pool, u32 memory_type,
+                                   const vk::MemoryRequirements& requirements)
+      -> memory_allocation
+   {
+      const auto make_allocation = [&](detail::memory_block& block, u64 offset) {
+         const u64 end = offset + requirements.size;
+
+         block.allocation_count += 1;
+         block.bytes_allocated += end - block.cursor;
+         block.bytes_requested += requirements.size;
+         block.cursor = end;
+
+         memory_allocation allocation{};
+         allocation.mp_allocator = this;
+         allocation.mp_block = &block;
+         allocation.m_offset = offset;
+         allocation.m_size = requirements.size;
+
+         return allocation;
+      };
+
+      for (auto& block : pool.blocks)
+      {
+         const u64 offset = align_up(block->cursor, requirements.alignment);
+         if (offset + requirements.size <= block->size)
+         {
+            return make_allocation(*block, offset);
+         }
+      }
+
+      auto block =
+         create_block(memory_type, std::max(m_transient_block_size, requirements.size));
+      block->kind = detail::block_kind::linear;
+
+      m_logger.debug("Reserved a {} byte transient block for memory type {} ({})", block->size,
+                     memory_type, vk::to_string(block->flags));
+
+      return make_allocation(*pool.blocks.emplace_back(std::move(block)), 0);
+   }
+
+   auto allocator::create_block(u32 memory_type, u64 size) const
+      -> std::unique_ptr<detail::memory_block>
+   {
+      auto block = std::make_unique<detail::memory_block>();
+      block->device = m_device;
+      block->memory = m_device.allocateMemoryUnique(
+         vk::MemoryAllocateInfo{.allocationSize = size, .memoryTypeIndex = memory_type});
+      block->flags = m_memory_properties.memoryTypes.at(memory_type).propertyFlags;
+      block->memory_type = memory_type;
+      block->size = size;
+      block->non_coherent_atom_size = m_non_coherent_atom_size;
+
+      if ((block->flags & vk::MemoryPropertyFlagBits::eHostVisible) ==
+          vk::MemoryPropertyFlagBits::eHostVisible)
+      {
+         block->p_mapped =
+            static_cast<std::byte*>(m_device.mapMemory(block->memory.get(), 0, VK_WHOLE_SIZE, {}));
+      }
+
+      return block;
+   }
+
+   void allocator::release(const memory_allocation& allocation) noexcept
+   {
+      std::scoped_lock lock{m_mutex};
+
+      auto* p_block = allocation.mp_block;
+
+      if (p_block->kind == detail::block_kind::linear)
+      {
+         // Transient memory is reclaimed all at once in begin_frame
+         return;
+      }
+
+      auto& pool = m_pools[p_block->pool_index];
+      const auto erase_block = [&] {
+         std::erase_if(pool.blocks, [&](const auto& block) {
+            return block.get() == p_block;
+         });
+      };
+
+      if (p_block->kind == detail::block_kind::dedicated)
+      {
+         erase_block();
+
+         return;
+      }
+
+      buddy_free(*p_block, allocation.m_offset, allocation.m_order);
+
+      p_block->allocation_count -= 1;
+      p_block->bytes_allocated -= to_node_size(allocation.m_order);
+      p_block->bytes_requested -= allocation.m_size;
+
+      // Keep one empty block around per pool to avoid reallocating it on the next request
+      if (p_block->allocation_count == 0 && std::size(pool.blocks) > 1)
+      {
+         erase_block();
+      }
+   }
+} // namespace cacao
@@ -0,0 +1,259 @@
+/**
+ * @file libcacao/allocator.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_ALLOCATOR_HPP_
+#define LIBCACAO_ALLOCATOR_HPP_
+
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+#include <libreglisse/maybe.hpp>
+
+// C++ Standard Library
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <system_error> // NOLINT
+#include <vector>
+
+namespace cacao
+{
+   /**
+    * The possible errors that may occur during a device memory allocation
+    */
+   enum class allocator_error
+   {
+      failed_to_find_desired_memory_type,
+      out_of_device_memory
+   };
+
+   auto LIBCACAO_SYMEXPORT make_error_condition(allocator_error code) -> std::error_condition;
+
+   namespace detail
+   {
+      struct memory_block;
+   } // namespace detail
+
+   class allocator;
+
+   struct LIBCACAO_SYMEXPORT allocator_create_info
+   {
+      const cacao::device& device;
+
+      /**
+       * Size of the memory blocks reserved for sub-allocation. Rounded up to a power of two and
+       * clamped to an eighth of the memory heap the block is taken from.
+       */
+      mannele::u64 block_size = 64ULL * 1024ULL * 1024ULL;
+
+      /**
+       * Number of frames in flight the transient linear pools are split into.
+       */
+      mannele::u64 transient_frame_count = 2;
+      mannele::u64 transient_block_size = 8ULL * 1024ULL * 1024ULL;
+
+      mannele::log_ptr logger;
+   };
+
+   struct allocation_create_info
+   {
+      vk::MemoryRequirements requirements{};
+
+      vk::MemoryPropertyFlags desired_mem_flags{};
+      vk::MemoryPropertyFlags fallback_mem_flags{};
+
+      /**
+       * Whether the resource bound to the memory is a buffer or a linearly tiled image. Linear and
+       * non-linear resources are kept in separate blocks when the device reports a
+       * bufferImageGranularity greater than one.
+       */
+      bool is_linear{true};
+
+      /**
+       * Prefer device local memory that is also host visible (resizable BAR) over the desired
+       * memory flags.
+       */
+      bool is_frequently_updated{false};
+
+      /**
+       * Allocate from the linear pool of the current frame. The memory is reclaimed on the next
+       * call to allocator::begin_frame for the same frame and must not be used after that.
+       */
+      bool is_transient{false};
+   };
+
+   /**
+    * @brief Handle to a range of device memory owned by a cacao::allocator. The range is returned
+    * to the allocator when the handle is destroyed.
+    */
+   class LIBCACAO_SYMEXPORT memory_allocation
+   {
+   public:
+      memory_allocation() = default;
+      memory_allocation(const memory_allocation&) = delete;
+      memory_allocation(memory_allocation&& other) noexcept;
+      ~memory_allocation();
+
+      auto operator=(const memory_allocation&) -> memory_allocation& = delete;
+      auto operator=(memory_allocation&& rhs) noexcept -> memory_allocation&;
+
+      [[nodiscard]] auto memory() const noexcept -> vk::DeviceMemory;
+      [[nodiscard]] auto offset() const noexcept -> mannele::u64;
+      [[nodiscard]] auto size() const noexcept -> mannele::u64;
+      [[nodiscard]] auto memory_flags() const noexcept -> vk::MemoryPropertyFlags;
+
+      [[nodiscard]] auto is_mapped() const noexcept -> bool;
+      [[nodiscard]] auto is_coherent() const noexcept -> bool;
+
+      /**
+       * Access the host visible memory of the allocation. Empty if the memory is not host visible.
+       */
+      [[nodiscard]] auto mapped() const noexcept -> std::span<std::byte>;
+
+      /**
+       * Make host writes to a range of the allocation visible to the device. The range is expanded
+       * to the device's nonCoherentAtomSize. Does nothing for host coherent memory.
+       */
+      void flush(mannele::u64 offset = 0, mannele::u64 size = VK_WHOLE_SIZE) const;
+      /**
+       * Make device writes to a range of the allocation visible to the host. The range is expanded
+       * to the device's nonCoherentAtomSize. Does nothing for host coherent memory.
+       */
+      void invalidate(mannele::u64 offset = 0, mannele::u64 size = VK_WHOLE_SIZE) const;
+
+   private:
+      [[nodiscard]] auto to_mapped_range(mannele::u64 offset, mannele::u64 size) const
+         -> vk::MappedMemoryRange;
+
+      void release() noexcept;
+
+   private:
+      allocator* mp_allocator{nullptr};
+      detail::memory_block* mp_block{nullptr};
+
+      mannele::u64 m_offset{};
+      mannele::u64 m_size{};
+      mannele::u32 m_order{};
+
+      friend class allocator;
+   };
+
+   struct allocator_statistics
+   {
+      mannele::u64 block_count{};
+      mannele::u64 dedicated_block_count{};
+      mannele::u64 transient_block_count{};
+      mannele::u64 allocation_count{};
+
+      mannele::u64 bytes_reserved{};  ///< Device memory allocated from the driver
+      mannele::u64 bytes_allocated{}; ///< Memory handed out, including rounding to buddy sizes
+      mannele::u64 bytes_requested{}; ///< Memory requested by the resources
+
+      mannele::u64 largest_free_range{};
+
+      /**
+       * Ratio of the free memory that is unusable for an allocation of the size of the largest
+       * free range. 0 means all free memory is contiguous.
+       */
+      double fragmentation{};
+   };
+
+   /**
+    * @brief Device memory allocator reserving large blocks per memory type and sub-allocating them
+    * with a buddy scheme. Allocations too large for a block get a dedicated VkDeviceMemory. A
+    * separate linear pool per frame in flight serves transient resources. Host visible blocks are
+    * persistently mapped.
+    *
+    * The allocator must outlive every memory_allocation made from it.
+    */
+   class LIBCACAO_SYMEXPORT allocator
+   {
+   public:
+      explicit allocator(const allocator_create_info& info);
+      allocator(const allocator&) = delete;
+      allocator(allocator&&) = delete;
+      ~allocator();
+
+      auto operator=(const allocator&) -> allocator& = delete;
+      auto operator=(allocator&&) -> allocator& = delete;
+
+      /**
+       * Allocate device memory satisfying the requirements of a resource. The candidate memory
+       * flags are tried in order of preference, moving on to the next one when a memory type is
+       * out of memory.
+       */
+      [[nodiscard]] auto allocate(const allocation_create_info& info) -> memory_allocation;
+
+      /**
+       * Reset the transient linear pool associated with a frame in flight. Must only be called once
+       * the GPU is done with the previous use of that frame.
+       */
+      void begin_frame(mannele::u64 frame_index);
+
+      [[nodiscard]] auto statistics() const -> allocator_statistics;
+      void log_statistics() const;
+
+   private:
+      struct memory_pool
+      {
+         std::vector<std::unique_ptr<detail::memory_block>> blocks;
+      };
+
+      [[nodiscard]] auto find_memory_type(mannele::u32 type_filter,
+                                          const vk::MemoryPropertyFlags& properties) const noexcept
+         -> reglisse::maybe<mannele::u32>;
+      [[nodiscard]] auto pool_index(mannele::u32 memory_type, bool is_linear) const noexcept
+         -> mannele::u64;
+
+      [[nodiscard]] auto allocate_from_type(mannele::u32 memory_type,
+                                            const allocation_create_info& info)
+         -> memory_allocation;
+      [[nodiscard]] auto allocate_buddy(mannele::u64 index, mannele::u32 memory_type,
+                                        const vk::MemoryRequirements& requirements)
+         -> memory_allocation;
+      [[nodiscard]] auto allocate_dedicated(mannele::u64 index, mannele::u32 memory_type,
+                                            const vk::MemoryRequirements& requirements)
+         -> memory_allocation;
+      [[nodiscard]] auto allocate_linear(memory_pool& pool, mannele::u32 memory_type,
+                                         const vk::MemoryRequirements& requirements)
+         -> memory_allocation;
+
+      [[nodiscard]] auto create_block(mannele::u32 memory_type, mannele::u64 size) const
+         -> std::unique_ptr<detail::memory_block>;
+
+      void release(const memory_allocation& allocation) noexcept;
+
+   private:
+      vk::Device m_device;
+      vk::PhysicalDeviceMemoryProperties m_memory_properties{};
+
+      mannele::u64 m_non_coherent_atom_size{};
+      bool m_separate_linear_resources{false};
+
+      std::array<mannele::u64, VK_MAX_MEMORY_TYPES> m_block_sizes{};
+      std::vector<memory_pool> m_pools;
+
+      mannele::u64 m_transient_block_size{};
+      mannele::u64 m_current_transient_frame{};
+      std::vector<std::vector<memory_pool>> m_transient_pools;
+
+      mutable std::mutex m_mutex;
+
+      mannele::log_ptr m_logger;
+
+      friend class memory_allocation;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_ALLOCATOR_HPP_
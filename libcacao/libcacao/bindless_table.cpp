@@ -0,0 +1,184 @@
+/**
+ * @file libcacao/bindless_table.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/bindless_table.hpp>
+
+// Third Party Libraries
+
+#include <magic_enum.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+using mannele::u32;
+
+namespace cacao
+{
+   struct bindless_table_error_category : std::error_category
+   {
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "cacao_bindless_table";
+      }
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return std::string(magic_enum::enum_name(static_cast<bindless_table_error>(err)));
+      }
+   };
+
+   inline static const bindless_table_error_category bindless_table_category{};
+
+   auto make_error_condition(bindless_table_error code) -> std::error_condition
+   {
+      return std::error_condition({static_cast<int>(code), bindless_table_category});
+   }
+
+   auto create_bindless_layout(const bindless_table_create_info& info) -> descriptor_set_layout
+   {
+      if (!info.device.has_descriptor_indexing())
+      {
+         throw runtime_error{
+            make_error_condition(bindless_table_error::descriptor_indexing_not_enabled)};
+      }
+
+      const auto properties =
+         info.device.physical()
+            .getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceVulkan12Properties>()
+            .get<vk::PhysicalDeviceVulkan12Properties>();
+
+      const u32 storage_buffer_count =
+         std::min({info.max_storage_buffers,
+                   properties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                   properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers});
+      const u32 sampled_image_count = std::min(
+         {info.max_sampled_images, properties.maxDescriptorSetUpdateAfterBindSampledImages,
+          properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+          properties.maxPerStageDescriptorUpdateAfterBindSamplers});
+
+      const auto binding_flags = vk::DescriptorBindingFlagBits::ePartiallyBound |
+         vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+
+      return descriptor_set_layout(
+         {.device = info.device,
+          .bindings = {{.binding = bindless_table::storage_buffer_binding,
+                        .descriptorType = vk::DescriptorType::eStorageBuffer,
+                        .descriptorCount = storage_buffer_count,
+                        .stageFlags = info.stages},
+                       {.binding = bindless_table::sampled_image_binding,
+                        .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+                        .descriptorCount = sampled_image_count,
+                        .stageFlags = info.stages}},
+          .binding_flags = {binding_flags, binding_flags},
+          .flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+          .logger = info.logger});
+   }
+
+   bindless_table::bindless_table(const bindless_table_create_info& info) :
+      m_device(info.device.logical()), m_layout(create_bindless_layout(info)),
+      m_logger(info.logger)
+   {
+      const auto bindings = m_layout.bindings();
+
+      m_storage_buffers.capacity = bindings[storage_buffer_binding].descriptorCount;
+      m_sampled_images.capacity = bindings[sampled_image_binding].descriptorCount;
+
+      const std::array pool_sizes{
+         vk::DescriptorPoolSize{.type = vk::DescriptorType::eStorageBuffer,
+                                .descriptorCount = m_storage_buffers.capacity},
+         vk::DescriptorPoolSize{.type = vk::DescriptorType::eCombinedImageSampler,
+                                .descriptorCount = m_sampled_images.capacity}};
+
+      m_pool = m_device.createDescriptorPoolUnique(
+         {.flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+          .maxSets = 1,
+          .poolSizeCount = static_cast<u32>(std::size(pool_sizes)),
+          .pPoolSizes = std::data(pool_sizes)});
+
+      const auto set_layout = m_layout.value();
+      m_set = m_device
+                 .allocateDescriptorSets({.descriptorPool = m_pool.get(),
+                                          .descriptorSetCount = 1,
+                                          .pSetLayouts = &set_layout})
+                 .front();
+
+      m_logger.debug("Bindless table created with {} storage buffers and {} sampled images",
+                     m_storage_buffers.capacity, m_sampled_images.capacity);
+   }
+
+   auto bindless_table::add_storage_buffer(vk::Buffer buffer, vk::DeviceSize offset,
+                                           vk::DeviceSize range) -> u32
+   {
+      const u32 index =
+         acquire_slot(m_storage_buffers, bindless_table_error::out_of_storage_buffer_slots);
+
+      const vk::DescriptorBufferInfo buffer_info{
+         .buffer = buffer, .offset = offset, .range = range};
+      m_device.updateDescriptorSets({vk::WriteDescriptorSet{
+                                       .dstSet = m_set,
+                                       .dstBinding = storage_buffer_binding,
+                                       .dstArrayElement = index,
+                                       .descriptorCount = 1,
+                                       .descriptorType = vk::DescriptorType::eStorageBuffer,
+                                       .pBufferInfo = &buffer_info}},
+                                    {});
+
+      return index;
+   }
+   auto bindless_table::add_sampled_image(vk::ImageView view, vk::Sampler sampler,
+                                          vk::ImageLayout layout) -> u32
+   {
+      const u32 index =
+         acquire_slot(m_sampled_images, bindless_table_error::out_of_sampled_image_slots);
+
+      const vk::DescriptorImageInfo image_info{
+         .sampler = sampler, .imageView = view, .imageLayout = layout};
+      m_device.updateDescriptorSets({vk::WriteDescriptorSet{
+                                       .dstSet = m_set,
+                                       .dstBinding = sampled_image_binding,
+                                       .dstArrayElement = index,
+                                       .descriptorCount = 1,
+                                       .descriptorType = vk::DescriptorType::eCombinedImageSampler,
+                                       .pImageInfo = &image_info}},
+                                    {});
+
+      return index;
+   }
+
+   void bindless_table::remove_storage_buffer(u32 index)
+   {
+      m_storage_buffers.free.push_back(index);
+   }
+   void bindless_table::remove_sampled_image(u32 index)
+   {
+      m_sampled_images.free.push_back(index);
+   }
+
+   auto bindless_table::layout() const noexcept -> const descriptor_set_layout& { return m_layout; }
+   auto bindless_table::set() const noexcept -> vk::DescriptorSet { return m_set; }
+
+   auto bindless_table::acquire_slot(slot_list& slots, bindless_table_error error) -> u32
+   {
+      if (!std::empty(slots.free))
+      {
+         const u32 index = slots.free.back();
+         slots.free.pop_back();
+
+         return index;
+      }
+
+      if (slots.next == slots.capacity)
+      {
+         throw runtime_error{make_error_condition(error)};
+      }
+
+      return slots.next++;
+   }
+} // namespace cacao
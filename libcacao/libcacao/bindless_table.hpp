@@ -0,0 +1,118 @@
+/**
+ * @file libcacao/bindless_table.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_BINDLESS_TABLE_HPP_
+#define LIBCACAO_BINDLESS_TABLE_HPP_
+
+#include <libcacao/descriptor_set_layout.hpp>
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+// C++ Standard Library
+
+#include <vector>
+
+namespace cacao
+{
+   enum class bindless_table_error
+   {
+      descriptor_indexing_not_enabled,
+      out_of_storage_buffer_slots,
+      out_of_sampled_image_slots
+   };
+
+   auto LIBCACAO_SYMEXPORT make_error_condition(bindless_table_error code) -> std::error_condition;
+
+   struct LIBCACAO_SYMEXPORT bindless_table_create_info
+   {
+      const cacao::device& device;
+
+      /**
+       * Capacity of each array, clamped to the update after bind limits of the device.
+       */
+      mannele::u32 max_storage_buffers{1024};
+      mannele::u32 max_sampled_images{1024};
+
+      vk::ShaderStageFlags stages{vk::ShaderStageFlagBits::eAll};
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief A single descriptor set holding every storage buffer and sampled image of the
+    * application in two arrays, so shaders index them with values given through push constants
+    * instead of having a set bound per draw.
+    *
+    * Storage buffers are bound as an array at `storage_buffer_binding` and combined image samplers
+    * as an array at `sampled_image_binding`. Both are partially bound and updated after bind, so
+    * slots may be added while the set is in use by the GPU. A removed slot is handed out again by
+    * the next add, it must only be removed once the GPU is done with it.
+    *
+    * Requires a device created with descriptor indexing enabled.
+    *
+    * @throw runtime_error when the device doesn't have descriptor indexing enabled.
+    */
+   class LIBCACAO_SYMEXPORT bindless_table
+   {
+   public:
+      static constexpr mannele::u32 storage_buffer_binding = 0;
+      static constexpr mannele::u32 sampled_image_binding = 1;
+
+   public:
+      bindless_table() = default;
+      explicit bindless_table(const bindless_table_create_info& info);
+
+      /**
+       * @return The index of the buffer in the storage buffer array.
+       * @throw runtime_error when every slot is in use.
+       */
+      auto add_storage_buffer(vk::Buffer buffer, vk::DeviceSize offset = 0,
+                              vk::DeviceSize range = VK_WHOLE_SIZE) -> mannele::u32;
+      /**
+       * @return The index of the image in the sampled image array.
+       * @throw runtime_error when every slot is in use.
+       */
+      auto add_sampled_image(vk::ImageView view, vk::Sampler sampler,
+                             vk::ImageLayout layout = vk::ImageLayout::eShaderReadOnlyOptimal)
+         -> mannele::u32;
+
+      void remove_storage_buffer(mannele::u32 index);
+      void remove_sampled_image(mannele::u32 index);
+
+      [[nodiscard]] auto layout() const noexcept -> const descriptor_set_layout&;
+      [[nodiscard]] auto set() const noexcept -> vk::DescriptorSet;
+
+   private:
+      struct slot_list
+      {
+         mannele::u32 capacity{};
+         mannele::u32 next{}; ///< First slot never handed out
+         std::vector<mannele::u32> free;
+      };
+
+      static auto acquire_slot(slot_list& slots, bindless_table_error error) -> mannele::u32;
+
+   private:
+      vk::Device m_device;
+
+      descriptor_set_layout m_layout;
+      vk::UniqueDescriptorPool m_pool;
+      vk::DescriptorSet m_set;
+
+      slot_list m_storage_buffers;
+      slot_list m_sampled_images;
+
+      mannele::log_ptr m_logger;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_BINDLESS_TABLE_HPP_
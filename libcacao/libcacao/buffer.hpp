@@ -9,6 +9,7 @@
 #ifndef LIBCACAO_BUFFER_HPP_
 #define LIBCACAO_BUFFER_HPP_
 
+#include <libcacao/allocator.hpp>
 #include <libcacao/device.hpp>
 #include <libcacao/export.hpp>
 
@@ -18,24 +19,15 @@
 
 // C++ Standard Library
 
+#include <span>
 #include <system_error> // NOLINT
 
 namespace cacao
 {
-   /**
-    * The possible errors that may occur the construction of the
-    * buffer object
-    */
-   enum class buffer_error
-   {
-      failed_to_find_desired_memory_type
-   };
-
-   auto LIBCACAO_SYMEXPORT make_error_condition(buffer_error) -> std::error_condition;
-
    struct buffer_create_info
    {
       const cacao::device& device;
+      cacao::allocator& allocator;
 
       mannele::u64 buffer_size{};
 
@@ -45,6 +37,18 @@ namespace cacao
 
       bool set_concurrent{false};
 
+      /**
+       * Hint that the buffer is rewritten by the host often. When set, device local memory that is
+       * also host visible (resizable BAR) is preferred over the desired memory flags.
+       */
+      bool is_frequently_updated{false};
+
+      /**
+       * Allocate the buffer from the allocator's per-frame linear pool. See
+       * allocation_create_info::is_transient.
+       */
+      bool is_transient{false};
+
       mannele::log_ptr logger;
    };
 
@@ -57,21 +61,58 @@ namespace cacao
 
       [[nodiscard]] auto value() const noexcept -> vk::Buffer;
       [[nodiscard]] auto memory() const noexcept -> vk::DeviceMemory;
+      [[nodiscard]] auto memory_offset() const noexcept -> mannele::u64;
+      [[nodiscard]] auto size() const noexcept -> mannele::u64;
+
+      /**
+       * Check if the buffer's memory is host visible and was mapped at creation.
+       */
+      [[nodiscard]] auto is_mapped() const noexcept -> bool;
+      /**
+       * Check if writes to the mapped memory need an explicit flush to be visible to the device.
+       */
+      [[nodiscard]] auto is_coherent() const noexcept -> bool;
+
+      /**
+       * Access the persistently mapped memory of the buffer. Empty if the buffer is not mapped.
+       */
+      [[nodiscard]] auto mapped() const noexcept -> std::span<std::byte>;
+
+      /**
+       * Access the persistently mapped memory of the buffer as an array of `Any`.
+       */
+      template <typename Any>
+      [[nodiscard]] auto mapped_as() const noexcept -> std::span<Any>
+      {
+         const auto bytes = mapped();
+
+         // NOLINTNEXTLINE
+         return {reinterpret_cast<Any*>(std::data(bytes)), std::size(bytes) / sizeof(Any)};
+      }
+
+      /**
+       * Make host writes to a range of the mapped memory visible to the device. Does nothing for
+       * host coherent memory.
+       */
+      void flush(mannele::u64 offset = 0, mannele::u64 size = VK_WHOLE_SIZE) const;
+      /**
+       * Make device writes to a range of the mapped memory visible to the host. Does nothing for
+       * host coherent memory.
+       */
+      void invalidate(mannele::u64 offset = 0, mannele::u64 size = VK_WHOLE_SIZE) const;
 
    private:
       [[nodiscard]] auto create_buffer(vk::Device logical, const buffer_create_info& info) const
          -> vk::UniqueBuffer;
       [[nodiscard]] auto allocate_memory(vk::Device logical, const buffer_create_info& info) const
-         -> vk::UniqueDeviceMemory;
-
-      [[nodiscard]] auto
-      find_memory_requirements(vk::PhysicalDevice physical, std::uint32_t type_filter,
-                               const vk::MemoryPropertyFlags& properties) const noexcept
-         -> reglisse::maybe<std::uint32_t>;
+         -> memory_allocation;
 
    private:
+      mannele::u64 m_size{};
+
+      // Declared before the buffer so the buffer is destroyed before its memory is released
+      memory_allocation m_allocation;
       vk::UniqueBuffer m_buffer;
-      vk::UniqueDeviceMemory m_memory;
 
       mannele::log_ptr m_logger;
    };
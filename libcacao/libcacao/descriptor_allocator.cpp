@@ -0,0 +1,116 @@
+/**
+ * @file libcacao/descriptor_allocator.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/descriptor_allocator.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   descriptor_allocator::descriptor_allocator(const descriptor_allocator_create_info& info) :
+      m_device(info.device.logical()), m_sets_per_pool(std::max(info.sets_per_pool, 1U)),
+      m_logger(info.logger)
+   {}
+
+   auto descriptor_allocator::allocate(const descriptor_set_layout& layout) -> vk::DescriptorSet
+   {
+      auto& pools = find_pools(layout);
+
+      if (pools.allocated_in_current == m_sets_per_pool)
+      {
+         ++pools.current;
+         pools.allocated_in_current = 0;
+      }
+
+      if (pools.current == std::size(pools.pools))
+      {
+         pools.pools.push_back(m_device.createDescriptorPoolUnique(
+            {.flags = pools.flags,
+             .maxSets = m_sets_per_pool,
+             .poolSizeCount = static_cast<u32>(std::size(pools.sizes)),
+             .pPoolSizes = std::data(pools.sizes)}));
+
+         m_logger.debug("Descriptor pool {} created for {} sets", std::size(pools.pools),
+                        m_sets_per_pool);
+      }
+
+      const auto set_layout = layout.value();
+      const auto sets = m_device.allocateDescriptorSets(
+         {.descriptorPool = pools.pools[pools.current].get(),
+          .descriptorSetCount = 1,
+          .pSetLayouts = &set_layout});
+
+      ++pools.allocated_in_current;
+
+      return sets.front();
+   }
+
+   void descriptor_allocator::reset()
+   {
+      for (auto& [layout, pools] : m_layouts)
+      {
+         const u64 used = std::min(pools.current + 1, std::size(pools.pools));
+         for (u64 i = 0; i < used; ++i)
+         {
+            m_device.resetDescriptorPool(pools.pools[i].get());
+         }
+
+         pools.current = 0;
+         pools.allocated_in_current = 0;
+      }
+   }
+
+   auto descriptor_allocator::pool_count() const noexcept -> u64
+   {
+      u64 count = 0;
+      for (const auto& [layout, pools] : m_layouts)
+      {
+         count += std::size(pools.pools);
+      }
+
+      return count;
+   }
+
+   auto descriptor_allocator::find_pools(const descriptor_set_layout& layout) -> layout_pools&
+   {
+      const auto [it, is_inserted] = m_layouts.try_emplace(layout.value());
+      if (!is_inserted)
+      {
+         return it->second;
+      }
+
+      auto& pools = it->second;
+
+      for (const auto& binding : layout.bindings())
+      {
+         const auto size_it = std::ranges::find(pools.sizes, binding.descriptorType,
+                                                &vk::DescriptorPoolSize::type);
+         if (size_it != std::end(pools.sizes))
+         {
+            size_it->descriptorCount += binding.descriptorCount * m_sets_per_pool;
+         }
+         else
+         {
+            pools.sizes.push_back({.type = binding.descriptorType,
+                                   .descriptorCount = binding.descriptorCount * m_sets_per_pool});
+         }
+      }
+
+      if (layout.flags() & vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool)
+      {
+         pools.flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind;
+      }
+
+      return pools;
+   }
+} // namespace cacao
@@ -0,0 +1,87 @@
+/**
+ * @file libcacao/descriptor_allocator.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_DESCRIPTOR_ALLOCATOR_HPP_
+#define LIBCACAO_DESCRIPTOR_ALLOCATOR_HPP_
+
+#include <libcacao/descriptor_set_layout.hpp>
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+// C++ Standard Library
+
+#include <map>
+#include <vector>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT descriptor_allocator_create_info
+   {
+      const cacao::device& device;
+
+      mannele::u32 sets_per_pool{64}; ///< Number of sets of a single layout each pool holds
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief Allocate descriptor sets of any layout without sizing pools up front.
+    *
+    * Each layout allocated from gets its own list of pools sized for `sets_per_pool` sets of that
+    * layout, so pools never fragment and a new pool is only created once every pool of the list is
+    * full. reset() frees every set at once while keeping the pools for the next allocations, which
+    * makes an allocator per frame in flight, reset when its frame begins, a cheap source of
+    * transient sets.
+    *
+    * Layouts created with eUpdateAfterBindPool are allocated from update after bind pools. Pools
+    * are looked up by layout handle, so layouts must outlive the allocator.
+    */
+   class LIBCACAO_SYMEXPORT descriptor_allocator
+   {
+   public:
+      descriptor_allocator() = default;
+      explicit descriptor_allocator(const descriptor_allocator_create_info& info);
+
+      [[nodiscard]] auto allocate(const descriptor_set_layout& layout) -> vk::DescriptorSet;
+
+      /**
+       * @brief Free every set allocated since the last reset. The GPU must be done with them.
+       */
+      void reset();
+
+      [[nodiscard]] auto pool_count() const noexcept -> mannele::u64;
+
+   private:
+      struct layout_pools
+      {
+         std::vector<vk::DescriptorPoolSize> sizes;
+         vk::DescriptorPoolCreateFlags flags{};
+
+         std::vector<vk::UniqueDescriptorPool> pools;
+         mannele::u64 current{0}; ///< Pools after the current one are empty
+         mannele::u32 allocated_in_current{0};
+      };
+
+      auto find_pools(const descriptor_set_layout& layout) -> layout_pools&;
+
+   private:
+      vk::Device m_device;
+
+      mannele::u32 m_sets_per_pool{};
+
+      std::map<VkDescriptorSetLayout, layout_pools> m_layouts;
+
+      mannele::log_ptr m_logger;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_DESCRIPTOR_ALLOCATOR_HPP_
@@ -15,12 +15,19 @@
 namespace cacao
 {
    descriptor_set_layout::descriptor_set_layout(descriptor_set_layout_create_info&& info) :
-      m_bindings{std::move(info.bindings)},
-      m_set_layout{info.device.logical().createDescriptorSetLayoutUnique(
+      m_bindings{std::move(info.bindings)}, m_flags{info.flags}
+   {
+      const vk::DescriptorSetLayoutBindingFlagsCreateInfo binding_flags{
+         .bindingCount = static_cast<std::uint32_t>(std::size(info.binding_flags)),
+         .pBindingFlags = std::data(info.binding_flags)};
+
+      m_set_layout = info.device.logical().createDescriptorSetLayoutUnique(
          vk::DescriptorSetLayoutCreateInfo{}
+            .setPNext(std::empty(info.binding_flags) ? nullptr : &binding_flags)
+            .setFlags(m_flags)
             .setBindingCount(static_cast<std::uint32_t>(std::size(m_bindings)))
-            .setPBindings(std::data(m_bindings)))}
-   {
+            .setPBindings(std::data(m_bindings)));
+
       /*
       std::string msg = "Descriptor set layout created with:";
 
@@ -52,4 +59,8 @@ namespace cacao
    {
       return m_bindings;
    }
+   auto descriptor_set_layout::flags() const -> vk::DescriptorSetLayoutCreateFlags
+   {
+      return m_flags;
+   }
 } // namespace cacao
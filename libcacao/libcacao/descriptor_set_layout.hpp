@@ -24,6 +24,12 @@ namespace cacao
 
       std::vector<vk::DescriptorSetLayoutBinding> bindings;
 
+      /**
+       * Flags of each binding, in the same order as `bindings`. Either empty or one per binding.
+       */
+      std::vector<vk::DescriptorBindingFlags> binding_flags{};
+      vk::DescriptorSetLayoutCreateFlags flags{};
+
       mannele::log_ptr logger;
    };
 
@@ -35,9 +41,11 @@ namespace cacao
 
       [[nodiscard]] auto value() const -> vk::DescriptorSetLayout;
       [[nodiscard]] auto bindings() const -> std::span<const vk::DescriptorSetLayoutBinding>;
+      [[nodiscard]] auto flags() const -> vk::DescriptorSetLayoutCreateFlags;
 
    private:
       std::vector<vk::DescriptorSetLayoutBinding> m_bindings;
+      vk::DescriptorSetLayoutCreateFlags m_flags;
 
       vk::UniqueDescriptorSetLayout m_set_layout;
    };
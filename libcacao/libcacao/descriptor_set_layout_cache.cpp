@@ -0,0 +1,73 @@
+/**
+ * @file libcacao/descriptor_set_layout_cache.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/descriptor_set_layout_cache.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <cassert>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   descriptor_set_layout_cache::descriptor_set_layout_cache(
+      const descriptor_set_layout_cache_create_info& info) :
+      mp_device(&info.device),
+      m_logger(info.logger)
+   {}
+
+   auto descriptor_set_layout_cache::get(std::span<const vk::DescriptorSetLayoutBinding> bindings,
+                                         std::span<const vk::DescriptorBindingFlags> binding_flags,
+                                         vk::DescriptorSetLayoutCreateFlags flags)
+      -> const descriptor_set_layout&
+   {
+      // NOLINTNEXTLINE
+      assert(std::empty(binding_flags) || std::size(binding_flags) == std::size(bindings));
+
+      layout_signature signature{.flags = static_cast<u32>(static_cast<VkFlags>(flags))};
+      signature.bindings.reserve(std::size(bindings));
+
+      for (u64 i = 0; i < std::size(bindings); ++i)
+      {
+         const auto& binding = bindings[i];
+         const auto binding_flag =
+            std::empty(binding_flags) ? vk::DescriptorBindingFlags{} : binding_flags[i];
+
+         signature.bindings.push_back(
+            {.binding = binding.binding,
+             .type = static_cast<u32>(binding.descriptorType),
+             .count = binding.descriptorCount,
+             .stages = static_cast<u32>(static_cast<VkFlags>(binding.stageFlags)),
+             .flags = static_cast<u32>(static_cast<VkFlags>(binding_flag))});
+      }
+
+      std::ranges::sort(signature.bindings);
+
+      if (auto it = m_layouts.find(signature); it != std::end(m_layouts))
+      {
+         return it->second;
+      }
+
+      auto layout = descriptor_set_layout(
+         {.device = *mp_device,
+          .bindings = {std::begin(bindings), std::end(bindings)},
+          .binding_flags = {std::begin(binding_flags), std::end(binding_flags)},
+          .flags = flags,
+          .logger = m_logger});
+
+      m_logger.debug("Descriptor set layout created with {} bindings, {} cached layouts",
+                     std::size(bindings), std::size(m_layouts) + 1);
+
+      return m_layouts.emplace(std::move(signature), std::move(layout)).first->second;
+   }
+
+   auto descriptor_set_layout_cache::size() const noexcept -> u64 { return std::size(m_layouts); }
+} // namespace cacao
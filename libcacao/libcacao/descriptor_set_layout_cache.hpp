@@ -0,0 +1,92 @@
+/**
+ * @file libcacao/descriptor_set_layout_cache.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_DESCRIPTOR_SET_LAYOUT_CACHE_HPP_
+#define LIBCACAO_DESCRIPTOR_SET_LAYOUT_CACHE_HPP_
+
+#include <libcacao/descriptor_set_layout.hpp>
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+// C++ Standard Library
+
+#include <compare>
+#include <map>
+#include <span>
+#include <vector>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT descriptor_set_layout_cache_create_info
+   {
+      const cacao::device& device;
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief Share descriptor set layouts between every user asking for the same bindings.
+    *
+    * Layouts are identified by their binding signature: the binding number, descriptor type,
+    * descriptor count, shader stages and binding flags of each binding, regardless of the order the
+    * bindings are given in, along with the layout flags. Immutable samplers are not part of the
+    * signature and must not be used with cached layouts.
+    *
+    * Layouts live as long as the cache.
+    */
+   class LIBCACAO_SYMEXPORT descriptor_set_layout_cache
+   {
+   public:
+      descriptor_set_layout_cache() = default;
+      explicit descriptor_set_layout_cache(const descriptor_set_layout_cache_create_info& info);
+
+      /**
+       * @brief Find the layout matching the signature of `bindings`, creating it on first use.
+       *
+       * @param binding_flags Either empty or the flags of each binding, in the same order.
+       */
+      auto get(std::span<const vk::DescriptorSetLayoutBinding> bindings,
+               std::span<const vk::DescriptorBindingFlags> binding_flags = {},
+               vk::DescriptorSetLayoutCreateFlags flags = {}) -> const descriptor_set_layout&;
+
+      [[nodiscard]] auto size() const noexcept -> mannele::u64;
+
+   private:
+      struct binding_signature
+      {
+         mannele::u32 binding{};
+         mannele::u32 type{};
+         mannele::u32 count{};
+         mannele::u32 stages{};
+         mannele::u32 flags{};
+
+         auto operator<=>(const binding_signature&) const = default;
+      };
+
+      struct layout_signature
+      {
+         std::vector<binding_signature> bindings;
+         mannele::u32 flags{};
+
+         auto operator<=>(const layout_signature&) const = default;
+      };
+
+   private:
+      const cacao::device* mp_device{nullptr};
+
+      std::map<layout_signature, descriptor_set_layout> m_layouts;
+
+      mannele::log_ptr m_logger;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_DESCRIPTOR_SET_LAYOUT_CACHE_HPP_
@@ -24,6 +24,8 @@
 // C++ Standard Library
 
 #include <algorithm>
+#include <bit>
+#include <cassert>
 #include <map>
 #include <vector>
 
@@ -115,9 +117,61 @@ namespace cacao
    auto get_queue_create_infos(vk::PhysicalDevice physical, vk::SurfaceKHR surface)
       -> const std::vector<detail::queue_info>;
 
+   /**
+    * Whether `features` hold every descriptor indexing feature a bindless table relies on.
+    */
+   auto has_bindless_features(const vk::PhysicalDeviceVulkan12Features& features) -> bool
+   {
+      return features.shaderSampledImageArrayNonUniformIndexing == VK_TRUE &&
+         features.shaderStorageBufferArrayNonUniformIndexing == VK_TRUE &&
+         features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE &&
+         features.descriptorBindingStorageBufferUpdateAfterBind == VK_TRUE &&
+         features.descriptorBindingPartiallyBound == VK_TRUE &&
+         features.runtimeDescriptorArray == VK_TRUE;
+   }
+
+   /**
+    * The Vulkan 1.2 features both requested by `info` and supported by `physical`.
+    */
+   auto find_vulkan_12_features(const device_create_info& info, vk::PhysicalDevice physical)
+      -> vk::PhysicalDeviceVulkan12Features
+   {
+      const auto version = std::min(info.ctx.vulkan_version(), physical.getProperties().apiVersion);
+      if (version < VK_MAKE_VERSION(1, 2, 0))
+      {
+         return {};
+      }
+
+      const auto supported =
+         physical.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>()
+            .get<vk::PhysicalDeviceVulkan12Features>();
+
+      vk::PhysicalDeviceVulkan12Features features{
+         .hostQueryReset = info.use_host_query_reset ? supported.hostQueryReset : VK_FALSE,
+         .timelineSemaphore =
+            info.use_timeline_semaphores ? supported.timelineSemaphore : VK_FALSE};
+
+      if (info.use_descriptor_indexing && has_bindless_features(supported))
+      {
+         features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+         features.shaderStorageBufferArrayNonUniformIndexing = VK_TRUE;
+         features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+         features.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+         features.descriptorBindingPartiallyBound = VK_TRUE;
+         features.runtimeDescriptorArray = VK_TRUE;
+      }
+
+      return features;
+   }
+
    device::device(device_create_info&& info) :
-      m_physical{find_physical_device(info)}, m_logical{create_logical_device(info)},
-      m_vk_version{info.ctx.vulkan_version()}, m_queues{create_queues(info)}
+      m_physical{find_physical_device(info)},
+      m_vulkan_12_features{find_vulkan_12_features(info, m_physical)},
+      m_logical{create_logical_device(info)}, m_vk_version{info.ctx.vulkan_version()},
+      m_has_timeline_semaphores{m_vulkan_12_features.timelineSemaphore == VK_TRUE},
+      m_has_host_query_reset{m_vulkan_12_features.hostQueryReset == VK_TRUE},
+      m_has_descriptor_indexing{has_bindless_features(m_vulkan_12_features)},
+      m_queues{create_queues(info)}
    {
       VULKAN_HPP_DEFAULT_DISPATCHER.init(m_logical.get());
 
@@ -126,17 +180,49 @@ namespace cacao
       mannele::log_ptr logger = info.logger;
       logger.info("GPU: {}", physical_properties.deviceName);
 
+      if (info.use_timeline_semaphores && !m_has_timeline_semaphores)
+      {
+         logger.warning("Timeline semaphores requested but not supported by the device");
+      }
+      if (info.use_host_query_reset && !m_has_host_query_reset)
+      {
+         logger.warning("Host query reset requested but not supported by the device");
+      }
+      if (info.use_descriptor_indexing && !m_has_descriptor_indexing)
+      {
+         logger.warning("Descriptor indexing requested but not supported by the device");
+      }
+
       for (const auto& queue : m_queues)
       {
          logger.debug("Device queue from family {} supporting {} created.", queue.family_index,
                       to_string(queue.type));
       }
+
+      // Roles without a supporting queue, such as present without a surface, are left empty
+      for (const auto role : {queue_flag_bits::graphics, queue_flag_bits::present,
+                              queue_flag_bits::compute, queue_flag_bits::transfer})
+      {
+         if (const auto found = search_best_suited_queue(role))
+         {
+            m_role_queues.at(std::countr_zero(static_cast<u32>(role))) = found.borrow();
+         }
+      }
    }
 
    auto device::logical() const -> vk::Device { return m_logical.get(); }
    auto device::physical() const -> vk::PhysicalDevice { return m_physical; }
 
    auto device::vk_version() const -> std::uint32_t { return m_vk_version; }
+   auto device::has_timeline_semaphores() const noexcept -> bool
+   {
+      return m_has_timeline_semaphores;
+   }
+   auto device::has_host_query_reset() const noexcept -> bool { return m_has_host_query_reset; }
+   auto device::has_descriptor_indexing() const noexcept -> bool
+   {
+      return m_has_descriptor_indexing;
+   }
 
    auto device::find_physical_device(const device_create_info& info) const -> vk::PhysicalDevice
    {
@@ -201,8 +287,26 @@ namespace cacao
          logger.debug("Device extension: {0}", name);
       }
 
+      const bool has_vulkan_12_features = m_vulkan_12_features.timelineSemaphore == VK_TRUE ||
+         m_vulkan_12_features.hostQueryReset == VK_TRUE ||
+         has_bindless_features(m_vulkan_12_features);
+
+      if (m_vulkan_12_features.timelineSemaphore == VK_TRUE)
+      {
+         logger.debug("Device feature: timelineSemaphore");
+      }
+      if (m_vulkan_12_features.hostQueryReset == VK_TRUE)
+      {
+         logger.debug("Device feature: hostQueryReset");
+      }
+      if (has_bindless_features(m_vulkan_12_features))
+      {
+         logger.debug("Device feature: descriptorIndexing");
+      }
+
       return m_physical.createDeviceUnique(
-         {.queueCreateInfoCount = static_cast<std::uint32_t>(std::size(vk_queue_create_infos)),
+         {.pNext = has_vulkan_12_features ? &m_vulkan_12_features : nullptr,
+          .queueCreateInfoCount = static_cast<std::uint32_t>(std::size(vk_queue_create_infos)),
           .pQueueCreateInfos = std::data(vk_queue_create_infos),
           .enabledExtensionCount = static_cast<std::uint32_t>(std::size(extensions)),
           .ppEnabledExtensionNames = std::data(extensions),
@@ -295,15 +399,34 @@ namespace cacao
    auto find_any_queue(std::span<const queue> queues, const queue_flags& desired) -> maybe<queue>;
 
    auto device::find_best_suited_queue(const queue_flags& desired) const -> queue
+   {
+      const auto bits = static_cast<u32>(desired);
+      if (std::has_single_bit(bits) && m_role_queues.at(std::countr_zero(bits)).value)
+      {
+         return m_role_queues.at(std::countr_zero(bits));
+      }
+
+      return search_best_suited_queue(desired).take();
+   }
+   auto device::role_queue(queue_flag_bits role) const noexcept -> const queue&
+   {
+      const auto bits = static_cast<u32>(role);
+
+      assert(std::has_single_bit(bits));                      // NOLINT
+      assert(m_role_queues.at(std::countr_zero(bits)).value); // NOLINT
+
+      return m_role_queues[std::countr_zero(bits)]; // NOLINT
+   }
+
+   auto device::search_best_suited_queue(const queue_flags& desired) const -> maybe<queue>
    {
       // clang-format off
       
       const queue_flags unwanted = queue_flag_bits::graphics;
 
-      return (find_dedicated_queue(m_queues, desired) 
+      return find_dedicated_queue(m_queues, desired) 
             | or_else([&] { return find_separated_queue(m_queues, desired, unwanted); }) 
-            | or_else([&] { return find_any_queue(m_queues, desired); })
-         ).take();
+            | or_else([&] { return find_any_queue(m_queues, desired); });
 
       // clang-format on
    }
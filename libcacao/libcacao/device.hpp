@@ -19,6 +19,7 @@
 
 // C++ Standard Library
 
+#include <array>
 #include <functional>
 #include <string>
 #include <vector>
@@ -71,6 +72,23 @@ namespace cacao
       bool use_transfer_queue = false;
       bool use_compute_queue = false;
 
+      /**
+       * Enable timeline semaphores when the device supports them through Vulkan 1.2. Check
+       * device::has_timeline_semaphores() for whether they were enabled.
+       */
+      bool use_timeline_semaphores = false;
+      /**
+       * Enable resetting query pools from the host when the device supports it through Vulkan
+       * 1.2. Check device::has_host_query_reset() for whether it was enabled.
+       */
+      bool use_host_query_reset = false;
+      /**
+       * Enable the descriptor indexing features needed by a bindless_table when the device
+       * supports all of them through Vulkan 1.2. Check device::has_descriptor_indexing() for
+       * whether they were enabled.
+       */
+      bool use_descriptor_indexing = false;
+
       mannele::log_ptr logger;
    };
 
@@ -91,8 +109,20 @@ namespace cacao
       [[nodiscard]] auto physical() const -> vk::PhysicalDevice;
 
       [[nodiscard]] auto vk_version() const -> std::uint32_t;
-
+      [[nodiscard]] auto has_timeline_semaphores() const noexcept -> bool;
+      [[nodiscard]] auto has_host_query_reset() const noexcept -> bool;
+      [[nodiscard]] auto has_descriptor_indexing() const noexcept -> bool;
+
+      /**
+       * @brief Find the queue best suited to `flags`. Lookups of a single role (graphics, present,
+       * compute or transfer) are answered from the queues resolved at creation.
+       */
       [[nodiscard]] auto find_best_suited_queue(const queue_flags& flags) const -> queue;
+      /**
+       * @brief The queue resolved at creation for a single role, without searching the queues.
+       * The device must have a queue supporting `role`.
+       */
+      [[nodiscard]] auto role_queue(queue_flag_bits role) const noexcept -> const queue&;
 
    private:
       [[nodiscard]] auto find_physical_device(const device_create_info& info) const
@@ -100,14 +130,25 @@ namespace cacao
       [[nodiscard]] auto create_logical_device(const device_create_info& info) const
          -> vk::UniqueDevice;
       [[nodiscard]] auto create_queues(const device_create_info& info) const -> std::vector<queue>;
+      [[nodiscard]] auto search_best_suited_queue(const queue_flags& flags) const
+         -> reglisse::maybe<queue>;
 
    private:
       vk::PhysicalDevice m_physical;
+      /**
+       * The Vulkan 1.2 features requested and supported, queried once and enabled on the logical
+       * device.
+       */
+      vk::PhysicalDeviceVulkan12Features m_vulkan_12_features;
       vk::UniqueDevice m_logical;
 
       std::uint32_t m_vk_version{};
+      bool m_has_timeline_semaphores{false};
+      bool m_has_host_query_reset{false};
+      bool m_has_descriptor_indexing{false};
 
       std::vector<queue> m_queues{};
+      std::array<queue, 4> m_role_queues{}; ///< Indexed by the bit of each role
    };
 } // namespace cacao
 
@@ -0,0 +1,258 @@
+/**
+ * @file libcacao/gpu_profiler.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/gpu_profiler.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <utility>
+
+using mannele::i64;
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   auto find_timestamp_valid_bits(const cacao::device& device) -> u32
+   {
+      const auto families = device.physical().getQueueFamilyProperties();
+
+      const auto graphics = device.find_best_suited_queue(queue_flag_bits::graphics);
+      const auto compute = device.find_best_suited_queue(queue_flag_bits::compute);
+
+      return std::min(families.at(graphics.family_index).timestampValidBits,
+                      families.at(compute.family_index).timestampValidBits);
+   }
+
+   gpu_scope::gpu_scope(vk::CommandBuffer buffer, vk::QueryPool pool, u32 end_query) :
+      m_buffer(buffer), m_pool(pool), m_end_query(end_query)
+   {}
+   gpu_scope::gpu_scope(gpu_scope&& other) noexcept :
+      m_buffer(std::exchange(other.m_buffer, nullptr)), m_pool(other.m_pool),
+      m_end_query(other.m_end_query)
+   {}
+   gpu_scope::~gpu_scope()
+   {
+      if (m_buffer)
+      {
+         m_buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_pool, m_end_query);
+      }
+   }
+
+   auto gpu_scope::operator=(gpu_scope&& rhs) noexcept -> gpu_scope&
+   {
+      if (this != &rhs)
+      {
+         if (m_buffer)
+         {
+            m_buffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, m_pool, m_end_query);
+         }
+
+         m_buffer = std::exchange(rhs.m_buffer, nullptr);
+         m_pool = rhs.m_pool;
+         m_end_query = rhs.m_end_query;
+      }
+
+      return *this;
+   }
+
+   gpu_profiler::gpu_profiler(const gpu_profiler_create_info& info) :
+      m_device(info.device.logical()), m_max_scopes(info.max_scopes_per_frame),
+      m_timestamp_period(info.device.physical().getProperties().limits.timestampPeriod),
+      m_logger(info.logger)
+   {
+      const auto limits = info.device.physical().getProperties().limits;
+      const u32 valid_bits = find_timestamp_valid_bits(info.device);
+
+      if (limits.timestampComputeAndGraphics == VK_FALSE || valid_bits == 0)
+      {
+         m_logger.warning("GPU profiler disabled, timestamps are not supported by the device");
+
+         return;
+      }
+
+      if (!info.device.has_host_query_reset())
+      {
+         m_logger.warning("GPU profiler disabled, the device was created without host query reset");
+
+         return;
+      }
+
+      m_timestamp_mask = valid_bits >= 64 ? ~u64{0} : (u64{1} << valid_bits) - 1;
+
+      m_frames.resize(info.frame_count);
+      for (auto& frame : m_frames)
+      {
+         frame.pool = m_device.createQueryPoolUnique(
+            {.queryType = vk::QueryType::eTimestamp, .queryCount = 2 * m_max_scopes});
+
+         // Queries must be reset before their first use
+         m_device.resetQueryPool(frame.pool.get(), 0, 2 * m_max_scopes);
+      }
+
+      m_is_enabled = true;
+
+      m_logger.debug("GPU profiler created with {} scopes per frame, {} ns per tick",
+                     m_max_scopes, m_timestamp_period);
+   }
+
+   void gpu_profiler::begin_frame(u64 frame_index)
+   {
+      if (!m_is_enabled)
+      {
+         return;
+      }
+
+      m_current_frame = frame_index;
+
+      auto& frame = m_frames.at(m_current_frame);
+      collect_results(frame);
+
+      if (!std::empty(frame.scope_names))
+      {
+         m_device.resetQueryPool(frame.pool.get(), 0,
+                                 2 * static_cast<u32>(std::size(frame.scope_names)));
+         frame.scope_names.clear();
+      }
+
+      frame.trace_anchor = mannele::trace_now();
+   }
+
+   auto gpu_profiler::scope(vk::CommandBuffer buffer, std::string_view name) -> gpu_scope
+   {
+      if (!m_is_enabled)
+      {
+         return {};
+      }
+
+      auto& frame = m_frames.at(m_current_frame);
+      if (std::size(frame.scope_names) == m_max_scopes)
+      {
+         m_logger.debug(R"(GPU profiler out of queries, scope "{}" skipped)", name);
+
+         return {};
+      }
+
+      const auto query = 2 * static_cast<u32>(std::size(frame.scope_names));
+      frame.scope_names.emplace_back(name);
+
+      buffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, frame.pool.get(), query);
+
+      return {buffer, frame.pool.get(), query + 1};
+   }
+
+   auto gpu_profiler::is_enabled() const noexcept -> bool { return m_is_enabled; }
+
+   auto gpu_profiler::statistics() const noexcept
+      -> const std::map<std::string, gpu_scope_statistics, std::less<>>&
+   {
+      return m_statistics;
+   }
+   void gpu_profiler::log_statistics() const
+   {
+      for (const auto& [name, stats] : m_statistics)
+      {
+         m_logger.info(R"(GPU scope "{}": {:.3f}ms average, {:.3f}ms min, {:.3f}ms max over {})",
+                       name, stats.average().count(), stats.min.count(), stats.max.count(),
+                       stats.sample_count);
+      }
+   }
+
+   void gpu_profiler::collect_results(frame_queries& frame)
+   {
+      if (std::empty(frame.scope_names))
+      {
+         return;
+      }
+
+      // Each query is followed by its availability, unavailable queries are left as zero
+      const auto query_count = 2 * static_cast<u32>(std::size(frame.scope_names));
+      std::vector<u64> results(2 * static_cast<u64>(query_count));
+
+      const auto res = m_device.getQueryPoolResults(
+         frame.pool.get(), 0, query_count, std::size(results) * sizeof(u64), std::data(results),
+         2 * sizeof(u64),
+         vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWithAvailability);
+
+      if (res != vk::Result::eSuccess && res != vk::Result::eNotReady)
+      {
+         m_logger.warning("Failed to read GPU profiler results: {}", vk::to_string(res));
+
+         return;
+      }
+
+      if (mannele::is_tracing())
+      {
+         record_trace_events(frame, results);
+      }
+
+      for (u32 i = 0; i < std::size(frame.scope_names); ++i)
+      {
+         const u64 begin = results[4 * i];
+         const u64 end = results[4 * i + 2];
+
+         if (results[4 * i + 1] == 0 || results[4 * i + 3] == 0)
+         {
+            continue;
+         }
+
+         const u64 ticks = (end - begin) & m_timestamp_mask;
+         const auto elapsed = gpu_scope_statistics::duration(
+            static_cast<double>(ticks) * m_timestamp_period / 1'000'000.0);
+
+         auto it = m_statistics.find(frame.scope_names[i]);
+         if (it == std::end(m_statistics))
+         {
+            it = m_statistics.emplace(frame.scope_names[i], gpu_scope_statistics{}).first;
+         }
+
+         auto& stats = it->second;
+         stats.last = elapsed;
+         stats.min = std::min(stats.min, elapsed);
+         stats.max = std::max(stats.max, elapsed);
+         stats.total += elapsed;
+         ++stats.sample_count;
+      }
+   }
+
+   void gpu_profiler::record_trace_events(const frame_queries& frame,
+                                          std::span<const u64> results)
+   {
+      const auto to_nanoseconds = [&](u64 ticks) {
+         const auto ns = static_cast<double>(ticks & m_timestamp_mask) * m_timestamp_period;
+         return static_cast<i64>(ns);
+      };
+
+      // No scope of the frame can start before the frame started recording, the smallest offset
+      // is the closest estimate of the difference between both clocks
+      for (u32 i = 0; i < std::size(frame.scope_names); ++i)
+      {
+         if (results[4 * i + 1] != 0)
+         {
+            const i64 offset =
+               to_nanoseconds(results[4 * i]) - static_cast<i64>(frame.trace_anchor);
+            m_trace_clock_offset = std::min(m_trace_clock_offset, offset);
+         }
+      }
+
+      for (u32 i = 0; i < std::size(frame.scope_names); ++i)
+      {
+         if (results[4 * i + 1] == 0 || results[4 * i + 3] == 0)
+         {
+            continue;
+         }
+
+         const i64 begin = to_nanoseconds(results[4 * i]) - m_trace_clock_offset;
+         const i64 end = to_nanoseconds(results[4 * i + 2]) - m_trace_clock_offset;
+
+         mannele::record_gpu_trace_event(frame.scope_names[i], static_cast<u64>(begin),
+                                         static_cast<u64>(end));
+      }
+   }
+} // namespace cacao
@@ -0,0 +1,161 @@
+/**
+ * @file libcacao/gpu_profiler.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_GPU_PROFILER_HPP_
+#define LIBCACAO_GPU_PROFILER_HPP_
+
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+#include <libmannele/tracing/trace.hpp>
+
+// C++ Standard Library
+
+#include <chrono>
+#include <limits>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT gpu_profiler_create_info
+   {
+      const cacao::device& device;
+
+      mannele::u32 frame_count{2}; ///< Number of frames in flight
+      mannele::u32 max_scopes_per_frame{64};
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief GPU time measured for every scope sharing a name.
+    */
+   struct gpu_scope_statistics
+   {
+      using duration = std::chrono::duration<double, std::milli>;
+
+      mannele::u64 sample_count{};
+
+      duration last{};
+      duration min{duration::max()};
+      duration max{};
+      duration total{};
+
+      [[nodiscard]] auto average() const noexcept -> duration
+      {
+         return sample_count == 0 ? duration{} : total / static_cast<double>(sample_count);
+      }
+   };
+
+   /**
+    * @brief Writes the end timestamp of a profiled scope when destroyed. The command buffer it was
+    * created with must still be recording at that point.
+    */
+   class LIBCACAO_SYMEXPORT gpu_scope
+   {
+   public:
+      gpu_scope() = default;
+      gpu_scope(vk::CommandBuffer buffer, vk::QueryPool pool, mannele::u32 end_query);
+      gpu_scope(const gpu_scope&) = delete;
+      gpu_scope(gpu_scope&& other) noexcept;
+      ~gpu_scope();
+
+      auto operator=(const gpu_scope&) -> gpu_scope& = delete;
+      auto operator=(gpu_scope&& rhs) noexcept -> gpu_scope&;
+
+   private:
+      vk::CommandBuffer m_buffer;
+      vk::QueryPool m_pool;
+      mannele::u32 m_end_query{};
+   };
+
+   /**
+    * @brief Measure the time the GPU spends in scopes of command buffers using timestamp queries.
+    *
+    * Each frame in flight has its own query pool. Results of a frame are read back when its pool is
+    * reused by begin_frame(), at which point the frame has completed, so reading them never stalls.
+    * Queries whose results aren't available are dropped instead of waited on. Pools are reset from
+    * the host, so scopes may be recorded on any queue supporting timestamps.
+    *
+    * The profiler is disabled when the device lacks timestamp support on its graphics and compute
+    * queues or was not created with host query reset, in which case scopes record nothing.
+    *
+    * While tracing is started, every scope is also recorded on the GPU track of the trace. GPU
+    * timestamps are translated to the trace clock using the earliest offset observed between the
+    * start of a scope and the start of the recording of its frame, so GPU events are placed as
+    * early as the CPU timeline allows rather than exactly aligned.
+    *
+    * Scopes must be recorded from a single thread at a time.
+    */
+   class LIBCACAO_SYMEXPORT gpu_profiler
+   {
+   public:
+      gpu_profiler() = default;
+      explicit gpu_profiler(const gpu_profiler_create_info& info);
+
+      /**
+       * @brief Collect the results of the previous use of the frame and reset its queries. Must
+       * only be called once the GPU is done with the previous use of that frame.
+       */
+      void begin_frame(mannele::u64 frame_index);
+
+      /**
+       * @brief Write a timestamp at the start of a scope in `buffer`, the end timestamp is written
+       * when the returned scope is destroyed. Scopes sharing a name are aggregated together.
+       */
+      [[nodiscard]] auto scope(vk::CommandBuffer buffer, std::string_view name) -> gpu_scope;
+
+      [[nodiscard]] auto is_enabled() const noexcept -> bool;
+
+      [[nodiscard]] auto statistics() const noexcept
+         -> const std::map<std::string, gpu_scope_statistics, std::less<>>&;
+      void log_statistics() const;
+
+   private:
+      struct frame_queries
+      {
+         vk::UniqueQueryPool pool;
+         std::vector<std::string> scope_names;
+
+         mannele::u64 trace_anchor{}; ///< Trace time at which the frame started recording
+      };
+
+      void collect_results(frame_queries& frame);
+      void record_trace_events(const frame_queries& frame, std::span<const mannele::u64> results);
+
+   private:
+      vk::Device m_device;
+
+      std::vector<frame_queries> m_frames;
+      mannele::u64 m_current_frame{0};
+
+      mannele::u32 m_max_scopes{};
+      double m_timestamp_period{}; ///< Nanoseconds per tick
+      mannele::u64 m_timestamp_mask{};
+
+      /**
+       * @brief Smallest difference seen between the GPU clock and the trace clock, in nanoseconds.
+       */
+      mannele::i64 m_trace_clock_offset{std::numeric_limits<mannele::i64>::max()};
+
+      bool m_is_enabled{false};
+
+      std::map<std::string, gpu_scope_statistics, std::less<>> m_statistics;
+
+      mannele::log_ptr m_logger;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_GPU_PROFILER_HPP_
@@ -0,0 +1,186 @@
+/**
+ * @file libcacao/pipeline_cache.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/pipeline_cache.hpp>
+
+// Third Party Libraries
+
+#include <magic_enum.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+using reglisse::err;
+using reglisse::ok;
+using reglisse::result;
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   struct pipeline_cache_error_category : std::error_category
+   {
+      /**
+       * The name of the vkn object the error appeared from.
+       */
+      [[nodiscard]] auto name() const noexcept -> const char* override
+      {
+         return "cacao_pipeline_cache";
+      }
+      /**
+       * Get the message associated with a specific error code.
+       */
+      [[nodiscard]] auto message(int err) const -> std::string override
+      {
+         return std::string(magic_enum::enum_name(static_cast<pipeline_cache_error>(err)));
+      }
+   };
+
+   inline static const pipeline_cache_error_category pipeline_cache_category{};
+
+   auto make_error_condition(pipeline_cache_error code) -> std::error_condition
+   {
+      return std::error_condition({static_cast<int>(code), pipeline_cache_category});
+   }
+
+   /**
+    * Layout of VkPipelineCacheHeaderVersionOne, the header every pipeline cache blob starts with.
+    */
+   struct pipeline_cache_header
+   {
+      u32 header_size{};
+      u32 header_version{};
+      u32 vendor_id{};
+      u32 device_id{};
+      std::array<std::uint8_t, VK_UUID_SIZE> uuid{};
+   };
+
+   auto is_pipeline_cache_compatible(std::span<const std::byte> data,
+                                     const vk::PhysicalDeviceProperties& properties) -> bool
+   {
+      pipeline_cache_header header{};
+      if (std::size(data) < sizeof(header))
+      {
+         return false;
+      }
+
+      std::memcpy(&header.header_size, std::data(data), sizeof(u32));
+      std::memcpy(&header.header_version, std::data(data) + 4, sizeof(u32));   // NOLINT
+      std::memcpy(&header.vendor_id, std::data(data) + 8, sizeof(u32));        // NOLINT
+      std::memcpy(&header.device_id, std::data(data) + 12, sizeof(u32));       // NOLINT
+      std::memcpy(std::data(header.uuid), std::data(data) + 16, VK_UUID_SIZE); // NOLINT
+
+      return header.header_size >= sizeof(header) && header.header_size <= std::size(data) &&
+         header.header_version == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header.vendor_id == properties.vendorID && header.device_id == properties.deviceID &&
+         std::ranges::equal(header.uuid, properties.pipelineCacheUUID);
+   }
+
+   pipeline_cache::pipeline_cache(const pipeline_cache_create_info& info) :
+      m_device(info.device.logical()), m_path(info.path), m_logger(info.logger)
+   {
+      const auto initial_data = load_cache_data(info.device.physical());
+
+      m_cache = m_device.createPipelineCacheUnique(
+         {.initialDataSize = std::size(initial_data), .pInitialData = std::data(initial_data)});
+
+      m_logger.debug("Pipeline cache created from {} bytes of data", std::size(initial_data));
+   }
+
+   auto pipeline_cache::save() const -> result<u64, pipeline_cache_error>
+   {
+      std::vector<std::uint8_t> data;
+
+      try
+      {
+         data = m_device.getPipelineCacheData(m_cache.get());
+      }
+      catch (const vk::SystemError&)
+      {
+         return err(pipeline_cache_error::failed_to_retrieve_cache_data);
+      }
+
+      std::error_code error{};
+      if (m_path.has_parent_path())
+      {
+         std::filesystem::create_directories(m_path.parent_path(), error);
+      }
+
+      auto temp_path = m_path;
+      temp_path += ".tmp";
+
+      {
+         auto output = std::ofstream(temp_path, std::ios::binary | std::ios::trunc);
+         output.write(reinterpret_cast<const char*>(std::data(data)), // NOLINT
+                      static_cast<std::streamsize>(std::size(data)));
+
+         if (!output)
+         {
+            return err(pipeline_cache_error::failed_to_write_cache_file);
+         }
+      }
+
+      std::filesystem::rename(temp_path, m_path, error);
+      if (error)
+      {
+         std::filesystem::remove(temp_path, error);
+
+         return err(pipeline_cache_error::failed_to_write_cache_file);
+      }
+
+      m_logger.debug("Pipeline cache of {} bytes saved to {}", std::size(data), m_path.string());
+
+      return ok(static_cast<u64>(std::size(data)));
+   }
+
+   auto pipeline_cache::value() const noexcept -> vk::PipelineCache { return m_cache.get(); }
+   auto pipeline_cache::path() const noexcept -> const std::filesystem::path& { return m_path; }
+
+   auto pipeline_cache::load_cache_data(vk::PhysicalDevice physical) const
+      -> std::vector<std::byte>
+   {
+      auto input = std::ifstream(m_path, std::ios::binary | std::ios::ate);
+      if (!input.is_open())
+      {
+         m_logger.debug("No pipeline cache found at {}", m_path.string());
+
+         return {};
+      }
+
+      std::vector<std::byte> data(static_cast<u64>(input.tellg()));
+
+      input.seekg(0, std::ios::beg);
+      input.read(reinterpret_cast<char*>(std::data(data)), // NOLINT
+                 static_cast<std::streamsize>(std::size(data)));
+
+      if (!input)
+      {
+         m_logger.warning("Failed to read pipeline cache at {}, starting empty", m_path.string());
+
+         return {};
+      }
+
+      if (!is_pipeline_cache_compatible(data, physical.getProperties()))
+      {
+         // A driver update or a different GPU invalidates the cache, drivers are not required
+         // to reject foreign data gracefully
+         m_logger.warning("Pipeline cache at {} does not match the device, discarding it",
+                          m_path.string());
+
+         return {};
+      }
+
+      return data;
+   }
+} // namespace cacao
@@ -0,0 +1,93 @@
+/**
+ * @file libcacao/pipeline_cache.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_PIPELINE_CACHE_HPP_
+#define LIBCACAO_PIPELINE_CACHE_HPP_
+
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+#include <libreglisse/result.hpp>
+
+// C++ Standard Library
+
+#include <filesystem>
+#include <span>
+#include <system_error> // NOLINT
+#include <vector>
+
+namespace cacao
+{
+   enum class pipeline_cache_error
+   {
+      failed_to_retrieve_cache_data,
+      failed_to_write_cache_file
+   };
+
+   auto LIBCACAO_SYMEXPORT make_error_condition(pipeline_cache_error code) -> std::error_condition;
+
+   struct LIBCACAO_SYMEXPORT pipeline_cache_create_info
+   {
+      const cacao::device& device;
+
+      /**
+       * File the cache is loaded from and saved to. The cache starts empty if the file does not
+       * exist or was created by a different device or driver.
+       */
+      std::filesystem::path path;
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief VkPipelineCache persisted on disk across runs, meant to be shared by every pipeline
+    * creation of a device.
+    */
+   class LIBCACAO_SYMEXPORT pipeline_cache
+   {
+   public:
+      pipeline_cache() = default;
+      explicit pipeline_cache(const pipeline_cache_create_info& info);
+
+      /**
+       * Write the content of the cache to disk. The file is replaced atomically so an interrupted
+       * save never leaves a truncated cache behind.
+       *
+       * @return The amount of bytes written.
+       */
+      [[nodiscard]] auto save() const -> reglisse::result<mannele::u64, pipeline_cache_error>;
+
+      [[nodiscard]] auto value() const noexcept -> vk::PipelineCache;
+      [[nodiscard]] auto path() const noexcept -> const std::filesystem::path&;
+
+   private:
+      [[nodiscard]] auto load_cache_data(vk::PhysicalDevice physical) const
+         -> std::vector<std::byte>;
+
+   private:
+      vk::Device m_device;
+
+      std::filesystem::path m_path;
+      vk::UniquePipelineCache m_cache;
+
+      mannele::log_ptr m_logger;
+   };
+
+   /**
+    * Check that pipeline cache data starts with a valid header matching the vendor ID, device ID
+    * and pipeline cache UUID of a physical device.
+    */
+   auto LIBCACAO_SYMEXPORT is_pipeline_cache_compatible(
+      std::span<const std::byte> data, const vk::PhysicalDeviceProperties& properties) -> bool;
+} // namespace cacao
+
+#endif // LIBCACAO_PIPELINE_CACHE_HPP_
@@ -0,0 +1,65 @@
+/**
+ * @file libcacao/primitives/compaction.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/primitives/compaction.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   gpu_compaction::gpu_compaction(const gpu_compaction_create_info& info) :
+      m_max_element_count(info.max_element_count),
+      m_scan({.device = info.device,
+              .allocator = info.allocator,
+              .binary = info.scan_binary,
+              .max_element_count = info.max_element_count,
+              .logger = info.logger}),
+      m_kernel({.device = info.device,
+                .binary = info.compact_binary,
+                .storage_buffer_count = 5,
+                .push_constant_size = sizeof(u32),
+                .logger = info.logger}),
+      m_offsets({.device = info.device,
+                 .allocator = info.allocator,
+                 .buffer_size = std::max(info.max_element_count, u64{1}) * sizeof(u32),
+                 .usage = vk::BufferUsageFlagBits::eStorageBuffer,
+                 .desired_mem_flags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+                 .logger = info.logger})
+   {}
+
+   void gpu_compaction::record(vk::CommandBuffer cmd, descriptor_allocator& descriptors,
+                               vk::Buffer values, vk::Buffer flags, vk::Buffer output,
+                               vk::Buffer output_count, u64 count) const
+   {
+      // NOLINTNEXTLINE
+      assert(count <= m_max_element_count);
+
+      if (count > 0)
+      {
+         m_scan.record(cmd, descriptors, flags, m_offsets.value(), count);
+         record_compute_barrier(cmd);
+      }
+
+      const std::array buffers{values, flags, m_offsets.value(), output, output_count};
+      const std::array push_constants{static_cast<u32>(count)};
+
+      m_kernel.bind(cmd, descriptors, buffers);
+      // At least one group, so the count is written when nothing is kept
+      m_kernel.dispatch(cmd, 0, push_constants,
+                        std::max(group_count(count, workgroup_size), 1U));
+   }
+
+   auto gpu_compaction::max_element_count() const noexcept -> u64 { return m_max_element_count; }
+} // namespace cacao
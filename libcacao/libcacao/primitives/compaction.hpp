@@ -0,0 +1,70 @@
+/**
+ * @file libcacao/primitives/compaction.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_PRIMITIVES_COMPACTION_HPP_
+#define LIBCACAO_PRIMITIVES_COMPACTION_HPP_
+
+#include <libcacao/buffer.hpp>
+#include <libcacao/export.hpp>
+#include <libcacao/primitives/compute_kernel.hpp>
+#include <libcacao/primitives/scan.hpp>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT gpu_compaction_create_info
+   {
+      const cacao::device& device;
+      cacao::allocator& allocator;
+
+      std::span<const mannele::u32> scan_binary;    ///< SPIR-V of shaders/scan.comp
+      std::span<const mannele::u32> compact_binary; ///< SPIR-V of shaders/compact.comp
+
+      mannele::u64 max_element_count{}; ///< Sizes the scratch memory
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief Stream compaction of 32 bit values on the GPU, keeping the values whose predicate flag
+    * is set while preserving their order.
+    *
+    * The flags are the result of the predicate, evaluated by whichever kernel produced them: 1 to
+    * keep the value at the same index, 0 to drop it. They are scanned with gpu_scan to find the
+    * output index of every kept value, which is then scattered in a single pass.
+    */
+   class LIBCACAO_SYMEXPORT gpu_compaction
+   {
+   public:
+      static constexpr mannele::u32 workgroup_size = 256;
+
+   public:
+      gpu_compaction() = default;
+      explicit gpu_compaction(const gpu_compaction_create_info& info);
+
+      /**
+       * @brief Record the compaction of the first `count` elements of `values` into `output`, and
+       * the number of values kept into the first u32 of `output_count`. A compute barrier must be
+       * recorded before reading them.
+       */
+      void record(vk::CommandBuffer cmd, descriptor_allocator& descriptors, vk::Buffer values,
+                  vk::Buffer flags, vk::Buffer output, vk::Buffer output_count,
+                  mannele::u64 count) const;
+
+      [[nodiscard]] auto max_element_count() const noexcept -> mannele::u64;
+
+   private:
+      mannele::u64 m_max_element_count{};
+
+      gpu_scan m_scan;
+      compute_kernel m_kernel;
+
+      buffer m_offsets;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_PRIMITIVES_COMPACTION_HPP_
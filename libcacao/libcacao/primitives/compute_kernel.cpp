@@ -0,0 +1,140 @@
+/**
+ * @file libcacao/primitives/compute_kernel.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/primitives/compute_kernel.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <cassert>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   auto create_storage_layout(const compute_kernel_create_info& info) -> descriptor_set_layout
+   {
+      std::vector<vk::DescriptorSetLayoutBinding> bindings;
+      bindings.reserve(info.storage_buffer_count);
+
+      for (u32 i = 0; i < info.storage_buffer_count; ++i)
+      {
+         bindings.push_back({.binding = i,
+                             .descriptorType = vk::DescriptorType::eStorageBuffer,
+                             .descriptorCount = 1,
+                             .stageFlags = vk::ShaderStageFlagBits::eCompute});
+      }
+
+      return descriptor_set_layout(
+         {.device = info.device, .bindings = std::move(bindings), .logger = info.logger});
+   }
+
+   compute_kernel::compute_kernel(const compute_kernel_create_info& info) :
+      m_device(info.device.logical()), m_set_layout(create_storage_layout(info)),
+      m_logger(info.logger)
+   {
+      m_module = m_device.createShaderModuleUnique(
+         {.codeSize = std::size(info.binary) * sizeof(u32), .pCode = std::data(info.binary)});
+
+      const auto set_layout = m_set_layout.value();
+      const vk::PushConstantRange push_range{.stageFlags = vk::ShaderStageFlagBits::eCompute,
+                                             .offset = 0,
+                                             .size = info.push_constant_size};
+
+      m_pipeline_layout = m_device.createPipelineLayoutUnique(
+         {.setLayoutCount = 1,
+          .pSetLayouts = &set_layout,
+          .pushConstantRangeCount = info.push_constant_size == 0 ? 0U : 1U,
+          .pPushConstantRanges = &push_range});
+
+      const vk::SpecializationMapEntry pass_entry{
+         .constantID = 0, .offset = 0, .size = sizeof(u32)};
+
+      m_pipelines.reserve(info.pass_count);
+      for (u32 pass = 0; pass < info.pass_count; ++pass)
+      {
+         const vk::SpecializationInfo specialization{.mapEntryCount = 1,
+                                                     .pMapEntries = &pass_entry,
+                                                     .dataSize = sizeof(u32),
+                                                     .pData = &pass};
+
+         m_pipelines.push_back(
+            m_device
+               .createComputePipelineUnique(
+                  nullptr,
+                  {.stage = {.stage = vk::ShaderStageFlagBits::eCompute,
+                             .module = m_module.get(),
+                             .pName = "main",
+                             .pSpecializationInfo = &specialization},
+                   .layout = m_pipeline_layout.get()})
+               .value);
+      }
+
+      m_logger.debug("Compute kernel created with {} passes and {} storage buffers",
+                     info.pass_count, info.storage_buffer_count);
+   }
+
+   void compute_kernel::bind(vk::CommandBuffer cmd, descriptor_allocator& descriptors,
+                             std::span<const vk::Buffer> buffers) const
+   {
+      // NOLINTNEXTLINE
+      assert(std::size(buffers) == std::size(m_set_layout.bindings()));
+
+      const auto set = descriptors.allocate(m_set_layout);
+
+      std::vector<vk::DescriptorBufferInfo> buffer_infos;
+      std::vector<vk::WriteDescriptorSet> writes;
+      buffer_infos.reserve(std::size(buffers));
+      writes.reserve(std::size(buffers));
+
+      for (u32 i = 0; const auto buffer : buffers)
+      {
+         buffer_infos.push_back({.buffer = buffer, .offset = 0, .range = VK_WHOLE_SIZE});
+         writes.push_back({.dstSet = set,
+                           .dstBinding = i++,
+                           .dstArrayElement = 0,
+                           .descriptorCount = 1,
+                           .descriptorType = vk::DescriptorType::eStorageBuffer,
+                           .pBufferInfo = &buffer_infos.back()});
+      }
+
+      m_device.updateDescriptorSets(writes, {});
+
+      cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_pipeline_layout.get(), 0, set, {});
+   }
+
+   void compute_kernel::dispatch(vk::CommandBuffer cmd, u32 pass,
+                                 std::span<const u32> push_constants, u32 group_count) const
+   {
+      cmd.bindPipeline(vk::PipelineBindPoint::eCompute, m_pipelines[pass].get());
+
+      if (!std::empty(push_constants))
+      {
+         cmd.pushConstants(m_pipeline_layout.get(), vk::ShaderStageFlagBits::eCompute, 0,
+                           static_cast<u32>(std::size(push_constants) * sizeof(u32)),
+                           std::data(push_constants));
+      }
+
+      const u32 group_count_x = std::min(group_count, max_group_count_x);
+      const u32 group_count_y =
+         group_count_x == 0 ? 0 : cacao::group_count(group_count, group_count_x);
+
+      cmd.dispatch(group_count_x, group_count_y, 1);
+   }
+
+   void record_compute_barrier(vk::CommandBuffer cmd)
+   {
+      const vk::MemoryBarrier barrier{.srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+                                      .dstAccessMask = vk::AccessFlagBits::eShaderRead |
+                                         vk::AccessFlagBits::eShaderWrite};
+
+      cmd.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                          vk::PipelineStageFlagBits::eComputeShader, {}, barrier, {}, {});
+   }
+} // namespace cacao
@@ -0,0 +1,108 @@
+/**
+ * @file libcacao/primitives/compute_kernel.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_PRIMITIVES_COMPUTE_KERNEL_HPP_
+#define LIBCACAO_PRIMITIVES_COMPUTE_KERNEL_HPP_
+
+#include <libcacao/descriptor_allocator.hpp>
+#include <libcacao/descriptor_set_layout.hpp>
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+// C++ Standard Library
+
+#include <span>
+#include <vector>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT compute_kernel_create_info
+   {
+      const cacao::device& device;
+
+      /**
+       * SPIR-V code of the compute shader. Only needs to stay alive for the duration of the
+       * constructor.
+       */
+      std::span<const mannele::u32> binary;
+
+      /**
+       * Number of pipelines created from the shader, each one with the specialization constant 0
+       * set to its pass index. Lets a multi pass algorithm live in a single shader.
+       */
+      mannele::u32 pass_count{1};
+
+      mannele::u32 storage_buffer_count{}; ///< Bound at bindings [0, storage_buffer_count)
+      mannele::u32 push_constant_size{};
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief A compute shader whose descriptor set only holds storage buffers, the building block of
+    * the GPU parallel primitives.
+    */
+   class LIBCACAO_SYMEXPORT compute_kernel
+   {
+   public:
+      /**
+       * Minimum of maxComputeWorkGroupCount[0] guaranteed by the Vulkan specification
+       */
+      static constexpr mannele::u32 max_group_count_x = 65535;
+
+   public:
+      compute_kernel() = default;
+      explicit compute_kernel(const compute_kernel_create_info& info);
+
+      /**
+       * @brief Bind `buffers` for the following dispatches of any pass. The descriptor set is taken
+       * from `descriptors` and must stay alive until the command buffer completes.
+       */
+      void bind(vk::CommandBuffer cmd, descriptor_allocator& descriptors,
+                std::span<const vk::Buffer> buffers) const;
+
+      /**
+       * @brief Record a dispatch of `group_count` workgroups of the given pass, on the buffers of
+       * the last bind(). Counts above `max_group_count_x` are folded into rows of workgroups, the
+       * shaders use `gl_WorkGroupID.y * gl_NumWorkGroups.x + gl_WorkGroupID.x` as their group
+       * index and skip the groups past their element count.
+       */
+      void dispatch(vk::CommandBuffer cmd, mannele::u32 pass,
+                    std::span<const mannele::u32> push_constants,
+                    mannele::u32 group_count) const;
+
+   private:
+      vk::Device m_device;
+
+      vk::UniqueShaderModule m_module;
+      descriptor_set_layout m_set_layout;
+      vk::UniquePipelineLayout m_pipeline_layout;
+      std::vector<vk::UniquePipeline> m_pipelines;
+
+      mannele::log_ptr m_logger;
+   };
+
+   /**
+    * @brief Make the shader writes of every previous compute dispatch visible to the next ones.
+    */
+   void LIBCACAO_SYMEXPORT record_compute_barrier(vk::CommandBuffer cmd);
+
+   /**
+    * @brief Number of groups of `group_size` elements needed to cover `count` elements.
+    */
+   constexpr auto group_count(mannele::u64 count, mannele::u64 group_size) noexcept -> mannele::u32
+   {
+      return static_cast<mannele::u32>((count + group_size - 1) / group_size);
+   }
+} // namespace cacao
+
+#endif // LIBCACAO_PRIMITIVES_COMPUTE_KERNEL_HPP_
@@ -0,0 +1,106 @@
+/**
+ * @file libcacao/primitives/radix_sort.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/primitives/radix_sort.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   enum struct radix_sort_pass : u32
+   {
+      count_digits,
+      scatter,
+      count
+   };
+
+   auto create_scratch_buffer(const gpu_radix_sort_create_info& info, u64 element_count) -> buffer
+   {
+      return buffer({.device = info.device,
+                     .allocator = info.allocator,
+                     .buffer_size = std::max(element_count, u64{1}) * sizeof(u32),
+                     .usage = vk::BufferUsageFlagBits::eStorageBuffer,
+                     .desired_mem_flags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+                     .logger = info.logger});
+   }
+
+   gpu_radix_sort::gpu_radix_sort(const gpu_radix_sort_create_info& info) :
+      m_max_element_count(info.max_element_count),
+      m_scan({.device = info.device,
+              .allocator = info.allocator,
+              .binary = info.scan_binary,
+              .max_element_count =
+                 u64{radix} * group_count(info.max_element_count, block_size),
+              .logger = info.logger}),
+      m_kernel({.device = info.device,
+                .binary = info.sort_binary,
+                .pass_count = static_cast<u32>(radix_sort_pass::count),
+                .storage_buffer_count = 5,
+                .push_constant_size = 3 * sizeof(u32),
+                .logger = info.logger}),
+      m_temp_keys(create_scratch_buffer(info, info.max_element_count)),
+      m_temp_values(create_scratch_buffer(info, info.max_element_count)),
+      m_histogram(create_scratch_buffer(
+         info, u64{radix} * group_count(info.max_element_count, block_size)))
+   {}
+
+   void gpu_radix_sort::record(vk::CommandBuffer cmd, descriptor_allocator& descriptors,
+                               vk::Buffer keys, vk::Buffer values, u64 count) const
+   {
+      // NOLINTNEXTLINE
+      assert(count <= m_max_element_count);
+
+      if (count == 0)
+      {
+         return;
+      }
+
+      const u32 blocks = group_count(count, block_size);
+
+      const std::array primary{keys, values};
+      const std::array secondary{m_temp_keys.value(), m_temp_values.value()};
+
+      for (u32 shift = 0; shift < 32; shift += radix_bits)
+      {
+         const bool is_even_pass = (shift / radix_bits) % 2 == 0;
+         const auto& src = is_even_pass ? primary : secondary;
+         const auto& dst = is_even_pass ? secondary : primary;
+
+         const std::array buffers{src[0], src[1], dst[0], dst[1], m_histogram.value()};
+         const std::array push_constants{static_cast<u32>(count), blocks, shift};
+
+         m_kernel.bind(cmd, descriptors, buffers);
+         m_kernel.dispatch(cmd, static_cast<u32>(radix_sort_pass::count_digits), push_constants,
+                           blocks);
+         record_compute_barrier(cmd);
+
+         m_scan.record(cmd, descriptors, m_histogram.value(), m_histogram.value(),
+                       u64{radix} * blocks);
+         record_compute_barrier(cmd);
+
+         // The scan bound its own descriptor set in place of ours
+         m_kernel.bind(cmd, descriptors, buffers);
+         m_kernel.dispatch(cmd, static_cast<u32>(radix_sort_pass::scatter), push_constants,
+                           blocks);
+
+         if (shift + radix_bits < 32)
+         {
+            record_compute_barrier(cmd);
+         }
+      }
+   }
+
+   auto gpu_radix_sort::max_element_count() const noexcept -> u64 { return m_max_element_count; }
+} // namespace cacao
@@ -0,0 +1,76 @@
+/**
+ * @file libcacao/primitives/radix_sort.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_PRIMITIVES_RADIX_SORT_HPP_
+#define LIBCACAO_PRIMITIVES_RADIX_SORT_HPP_
+
+#include <libcacao/buffer.hpp>
+#include <libcacao/export.hpp>
+#include <libcacao/primitives/compute_kernel.hpp>
+#include <libcacao/primitives/scan.hpp>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT gpu_radix_sort_create_info
+   {
+      const cacao::device& device;
+      cacao::allocator& allocator;
+
+      std::span<const mannele::u32> scan_binary; ///< SPIR-V of shaders/scan.comp
+      std::span<const mannele::u32> sort_binary; ///< SPIR-V of shaders/radix_sort.comp
+
+      mannele::u64 max_element_count{}; ///< Sizes the scratch memory
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief Stable sort of 32 bit unsigned keys carrying a 32 bit value each, on the GPU.
+    *
+    * A least significant digit radix sort of 8 bit digits, four passes in total. Every pass counts
+    * the digits of each block of `block_size` keys into a digit major histogram, scans it with
+    * gpu_scan to get the global position of every (digit, block) pair, then sorts each block
+    * locally by the digit and scatters it. Sorting locally first makes the scatter write runs of
+    * consecutive addresses.
+    *
+    * Passes ping-pong between the caller's buffers and internal ones, the sorted result ends up
+    * back in the caller's buffers.
+    */
+   class LIBCACAO_SYMEXPORT gpu_radix_sort
+   {
+   public:
+      static constexpr mannele::u32 block_size = 1024;
+      static constexpr mannele::u32 radix_bits = 8;
+      static constexpr mannele::u32 radix = 1U << radix_bits;
+
+   public:
+      gpu_radix_sort() = default;
+      explicit gpu_radix_sort(const gpu_radix_sort_create_info& info);
+
+      /**
+       * @brief Record the sort of the first `count` keys and values. A compute barrier must be
+       * recorded before reading them.
+       */
+      void record(vk::CommandBuffer cmd, descriptor_allocator& descriptors, vk::Buffer keys,
+                  vk::Buffer values, mannele::u64 count) const;
+
+      [[nodiscard]] auto max_element_count() const noexcept -> mannele::u64;
+
+   private:
+      mannele::u64 m_max_element_count{};
+
+      gpu_scan m_scan;
+      compute_kernel m_kernel;
+
+      buffer m_temp_keys;
+      buffer m_temp_values;
+      buffer m_histogram;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_PRIMITIVES_RADIX_SORT_HPP_
@@ -0,0 +1,75 @@
+/**
+ * @file libcacao/primitives/scan.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/primitives/scan.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   enum struct scan_pass : u32
+   {
+      reduce,
+      scan_block_sums,
+      downsweep,
+      count
+   };
+
+   gpu_scan::gpu_scan(const gpu_scan_create_info& info) :
+      m_max_element_count(info.max_element_count),
+      m_kernel({.device = info.device,
+                .binary = info.binary,
+                .pass_count = static_cast<u32>(scan_pass::count),
+                .storage_buffer_count = 3,
+                .push_constant_size = 2 * sizeof(u32),
+                .logger = info.logger}),
+      m_block_sums(
+         {.device = info.device,
+          .allocator = info.allocator,
+          .buffer_size = std::max(group_count(info.max_element_count, block_size), 1U) *
+             sizeof(u32),
+          .usage = vk::BufferUsageFlagBits::eStorageBuffer,
+          .desired_mem_flags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+          .logger = info.logger})
+   {}
+
+   void gpu_scan::record(vk::CommandBuffer cmd, descriptor_allocator& descriptors,
+                         vk::Buffer input, vk::Buffer output, u64 count) const
+   {
+      // NOLINTNEXTLINE
+      assert(count <= m_max_element_count);
+
+      if (count == 0)
+      {
+         return;
+      }
+
+      const u32 blocks = group_count(count, block_size);
+      const std::array buffers{input, output, m_block_sums.value()};
+      const std::array push_constants{static_cast<u32>(count), blocks};
+
+      m_kernel.bind(cmd, descriptors, buffers);
+
+      m_kernel.dispatch(cmd, static_cast<u32>(scan_pass::reduce), push_constants, blocks);
+      record_compute_barrier(cmd);
+
+      m_kernel.dispatch(cmd, static_cast<u32>(scan_pass::scan_block_sums), push_constants, 1);
+      record_compute_barrier(cmd);
+
+      m_kernel.dispatch(cmd, static_cast<u32>(scan_pass::downsweep), push_constants, blocks);
+   }
+
+   auto gpu_scan::max_element_count() const noexcept -> u64 { return m_max_element_count; }
+} // namespace cacao
@@ -0,0 +1,65 @@
+/**
+ * @file libcacao/primitives/scan.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_PRIMITIVES_SCAN_HPP_
+#define LIBCACAO_PRIMITIVES_SCAN_HPP_
+
+#include <libcacao/buffer.hpp>
+#include <libcacao/export.hpp>
+#include <libcacao/primitives/compute_kernel.hpp>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT gpu_scan_create_info
+   {
+      const cacao::device& device;
+      cacao::allocator& allocator;
+
+      std::span<const mannele::u32> binary; ///< SPIR-V of shaders/scan.comp
+
+      mannele::u64 max_element_count{}; ///< Sizes the scratch memory
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief Exclusive prefix sum of 32 bit unsigned integers on the GPU.
+    *
+    * Uses a reduce-then-scan in three dispatches: every block of `block_size` elements is reduced
+    * to its sum, the block sums are scanned by a single workgroup, then every block is scanned
+    * locally starting from its scanned sum. Unlike a decoupled look-back scan it doesn't rely on
+    * forward progress between workgroups, so it also runs on software implementations such as
+    * lavapipe.
+    */
+   class LIBCACAO_SYMEXPORT gpu_scan
+   {
+   public:
+      static constexpr mannele::u32 block_size = 1024;
+
+   public:
+      gpu_scan() = default;
+      explicit gpu_scan(const gpu_scan_create_info& info);
+
+      /**
+       * @brief Record the exclusive scan of the first `count` elements of `input` into `output`.
+       * Both may be the same buffer. A compute barrier must be recorded before reading `output`.
+       */
+      void record(vk::CommandBuffer cmd, descriptor_allocator& descriptors, vk::Buffer input,
+                  vk::Buffer output, mannele::u64 count) const;
+
+      [[nodiscard]] auto max_element_count() const noexcept -> mannele::u64;
+
+   private:
+      mannele::u64 m_max_element_count{};
+
+      compute_kernel m_kernel;
+      buffer m_block_sums;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_PRIMITIVES_SCAN_HPP_
@@ -92,21 +92,22 @@ namespace cacao
    shader::shader(const shader_create_info& info) :
       m_name(info.name), m_type(info.type), m_logger(info.logger)
    {
-      const auto glsl = spirv_cross::Compiler(info.binary);
+      const auto glsl = spirv_cross::Compiler(std::data(info.binary), std::size(info.binary));
       const auto& resources = glsl.get_shader_resources();
 
       m_inputs = extract_shader_input_ids(glsl, resources);
       m_uniforms = extract_uniform_buffer_ids(glsl, resources);
 
-      const auto create_info = vk::ShaderModuleCreateInfo{.codeSize = std::size(info.binary),
-                                                          .pCode = std::data(info.binary)};
+      const auto create_info =
+         vk::ShaderModuleCreateInfo{.codeSize = std::size(info.binary) * sizeof(mannele::u32),
+                                    .pCode = std::data(info.binary)};
 
       m_module = info.device.logical().createShaderModuleUnique(create_info);
    }
    shader::shader(shader_create_info&& info) :
       m_name(std::move(info.name)), m_type(info.type), m_logger(info.logger)
    {
-      const auto glsl = spirv_cross::Compiler(info.binary);
+      const auto glsl = spirv_cross::Compiler(std::data(info.binary), std::size(info.binary));
       const auto& resources = glsl.get_shader_resources();
 
       m_inputs = extract_shader_input_ids(glsl, resources);
@@ -18,6 +18,7 @@
 
 // C++ Standard Libraries
 
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error> // NOLINT
@@ -56,7 +57,11 @@ namespace cacao
 
       std::string name;
       shader_type type;
-      std::vector<std::uint32_t> binary;
+
+      /**
+       * SPIR-V code of the shader. Only needs to stay alive for the duration of the constructor.
+       */
+      std::span<const std::uint32_t> binary;
 
       mannele::log_ptr logger;
    };
@@ -0,0 +1,164 @@
+/**
+ * @file libcacao/submission_batch.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/submission_batch.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/tracing/trace.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   void submission_batch::add(const queue& target, const submission_info& info)
+   {
+      auto it = std::ranges::find(m_queues, target.value, &queue_submissions::queue);
+      if (it == std::end(m_queues))
+      {
+         m_queues.push_back({.queue = target.value});
+         it = std::prev(std::end(m_queues));
+      }
+
+      auto& pending = *it;
+
+      const auto index = static_cast<u32>(std::distance(std::begin(m_queues), it));
+      if (std::ranges::find(m_flush_order, index) == std::end(m_flush_order))
+      {
+         m_flush_order.push_back(index);
+      }
+
+      pending_submission submission{
+         .first_command_buffer = static_cast<u32>(std::size(pending.command_buffers)),
+         .command_buffer_count = static_cast<u32>(std::size(info.command_buffers)),
+         .first_wait = static_cast<u32>(std::size(pending.wait_semaphores)),
+         .wait_count = static_cast<u32>(std::size(info.waits)),
+         .first_signal = static_cast<u32>(std::size(pending.signal_semaphores)),
+         .signal_count = static_cast<u32>(std::size(info.signals)),
+         .fence = info.fence};
+
+      pending.command_buffers.insert(std::end(pending.command_buffers),
+                                     std::begin(info.command_buffers),
+                                     std::end(info.command_buffers));
+
+      for (const auto& wait : info.waits)
+      {
+         pending.wait_semaphores.push_back(wait.semaphore);
+         pending.wait_stages.push_back(wait.stages);
+         pending.wait_values.push_back(wait.value.is_some() ? wait.value.borrow() : 0);
+
+         submission.has_timeline_values |= wait.value.is_some();
+      }
+
+      for (const auto& signal : info.signals)
+      {
+         pending.signal_semaphores.push_back(signal.semaphore);
+         pending.signal_values.push_back(signal.value.is_some() ? signal.value.borrow() : 0);
+
+         submission.has_timeline_values |= signal.value.is_some();
+      }
+
+      pending.submissions.push_back(submission);
+   }
+
+   void submission_batch::flush()
+   {
+      MANNELE_TRACE_ZONE_CAT("submission_batch::flush", "cacao");
+
+      // A failed flush drops its submissions, they won't be handed to the driver either way
+      ++m_flush_count;
+
+      try
+      {
+         for (const u32 index : m_flush_order)
+         {
+            flush_queue(m_queues[index]);
+         }
+      }
+      catch (...)
+      {
+         for (auto& pending : m_queues)
+         {
+            pending.clear();
+         }
+         m_flush_order.clear();
+
+         throw;
+      }
+
+      m_flush_order.clear();
+   }
+
+   auto submission_batch::is_empty() const noexcept -> bool { return std::empty(m_flush_order); }
+   auto submission_batch::flush_count() const noexcept -> u64 { return m_flush_count; }
+
+   void submission_batch::flush_queue(queue_submissions& pending)
+   {
+      m_submit_infos.clear();
+      m_timeline_infos.clear();
+
+      // Submit infos point into the timeline infos, which must not reallocate
+      m_timeline_infos.reserve(std::size(pending.submissions));
+
+      for (const auto& submission : pending.submissions)
+      {
+         vk::SubmitInfo submit_info{
+            .waitSemaphoreCount = submission.wait_count,
+            .pWaitSemaphores = std::data(pending.wait_semaphores) + submission.first_wait,
+            .pWaitDstStageMask = std::data(pending.wait_stages) + submission.first_wait,
+            .commandBufferCount = submission.command_buffer_count,
+            .pCommandBuffers =
+               std::data(pending.command_buffers) + submission.first_command_buffer,
+            .signalSemaphoreCount = submission.signal_count,
+            .pSignalSemaphores = std::data(pending.signal_semaphores) + submission.first_signal};
+
+         if (submission.has_timeline_values)
+         {
+            m_timeline_infos.push_back(vk::TimelineSemaphoreSubmitInfo{
+               .waitSemaphoreValueCount = submission.wait_count,
+               .pWaitSemaphoreValues = std::data(pending.wait_values) + submission.first_wait,
+               .signalSemaphoreValueCount = submission.signal_count,
+               .pSignalSemaphoreValues =
+                  std::data(pending.signal_values) + submission.first_signal});
+
+            submit_info.pNext = &m_timeline_infos.back();
+         }
+
+         m_submit_infos.push_back(submit_info);
+
+         if (submission.fence)
+         {
+            pending.queue.submit(m_submit_infos, submission.fence);
+            m_submit_infos.clear();
+         }
+      }
+
+      if (!std::empty(m_submit_infos))
+      {
+         pending.queue.submit(m_submit_infos, nullptr);
+      }
+
+      pending.clear();
+   }
+
+   void submission_batch::queue_submissions::clear() noexcept
+   {
+      command_buffers.clear();
+      wait_semaphores.clear();
+      wait_stages.clear();
+      wait_values.clear();
+      signal_semaphores.clear();
+      signal_values.clear();
+      submissions.clear();
+   }
+} // namespace cacao
@@ -0,0 +1,132 @@
+/**
+ * @file libcacao/submission_batch.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_SUBMISSION_BATCH_HPP_
+#define LIBCACAO_SUBMISSION_BATCH_HPP_
+
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libreglisse/maybe.hpp>
+
+// C++ Standard Library
+
+#include <span>
+#include <vector>
+
+namespace cacao
+{
+   struct semaphore_wait
+   {
+      vk::Semaphore semaphore;
+      vk::PipelineStageFlags stages;
+
+      /**
+       * Set for timeline semaphores only, where zero is a valid value to wait on.
+       */
+      reglisse::maybe<mannele::u64> value{reglisse::none};
+   };
+
+   struct semaphore_signal
+   {
+      vk::Semaphore semaphore;
+
+      reglisse::maybe<mannele::u64> value{reglisse::none}; ///< Only set for timeline semaphores
+   };
+
+   struct submission_info
+   {
+      std::span<const vk::CommandBuffer> command_buffers{};
+      std::span<const semaphore_wait> waits{};
+      std::span<const semaphore_signal> signals{};
+
+      /**
+       * Signaled once the submission and every submission added before it to the same queue since
+       * the last flush have completed.
+       */
+      vk::Fence fence{nullptr};
+   };
+
+   /**
+    * @brief Collect the submissions made to each queue and hand them to the driver with as few
+    * vkQueueSubmit calls as possible when flushed.
+    *
+    * Submissions to the same queue are flushed in the order they were added with a single call,
+    * unless a fence splits them. Queues are flushed in the order they were first added to, so a
+    * binary semaphore signaled on one queue may be waited on by a queue added after it. Everything
+    * added is copied, the spans given to add() may be released right away.
+    *
+    * Storage is kept between flushes so a batch reused every frame doesn't allocate.
+    */
+   class LIBCACAO_SYMEXPORT submission_batch
+   {
+   public:
+      void add(const queue& target, const submission_info& info);
+
+      /**
+       * @brief Submit everything added since the last flush.
+       *
+       * @throw vk::SystemError when a submission fails, the batch is left empty.
+       */
+      void flush();
+
+      [[nodiscard]] auto is_empty() const noexcept -> bool;
+      /**
+       * @brief Number of times the batch was flushed, tells whether something added earlier was
+       * handed to the driver.
+       */
+      [[nodiscard]] auto flush_count() const noexcept -> mannele::u64;
+
+   private:
+      struct pending_submission
+      {
+         mannele::u32 first_command_buffer{};
+         mannele::u32 command_buffer_count{};
+         mannele::u32 first_wait{};
+         mannele::u32 wait_count{};
+         mannele::u32 first_signal{};
+         mannele::u32 signal_count{};
+
+         bool has_timeline_values{false};
+
+         vk::Fence fence;
+      };
+
+      struct queue_submissions
+      {
+         vk::Queue queue;
+
+         std::vector<vk::CommandBuffer> command_buffers;
+
+         std::vector<vk::Semaphore> wait_semaphores;
+         std::vector<vk::PipelineStageFlags> wait_stages;
+         std::vector<mannele::u64> wait_values;
+
+         std::vector<vk::Semaphore> signal_semaphores;
+         std::vector<mannele::u64> signal_values;
+
+         std::vector<pending_submission> submissions;
+
+         void clear() noexcept;
+      };
+
+      void flush_queue(queue_submissions& pending);
+
+   private:
+      std::vector<queue_submissions> m_queues;
+      std::vector<mannele::u32> m_flush_order; ///< Index of each queue in order of first use
+      mannele::u64 m_flush_count{0};
+
+      std::vector<vk::SubmitInfo> m_submit_infos;
+      std::vector<vk::TimelineSemaphoreSubmitInfo> m_timeline_infos;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_SUBMISSION_BATCH_HPP_
@@ -11,6 +11,7 @@
 // Third Party Libraries
 
 #include <libmannele/dimension.hpp>
+#include <libmannele/tracing/trace.hpp>
 
 #include <libreglisse/operations/transform_err.hpp>
 #include <libreglisse/try.hpp>
@@ -90,6 +91,8 @@ namespace cacao
 
    swapchain::swapchain(const swapchain_create_info& info) : m_logger(info.logger)
    {
+      MANNELE_TRACE_ZONE_CAT("swapchain::create", "cacao");
+
       const auto device = info.device.logical();
       const auto surface_support_res = query_surface_support(info.device, info.surface);
 
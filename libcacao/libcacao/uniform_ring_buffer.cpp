@@ -0,0 +1,73 @@
+/**
+ * @file libcacao/uniform_ring_buffer.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/uniform_ring_buffer.hpp>
+#include <libcacao/util/align.hpp>
+
+using reglisse::maybe;
+using reglisse::none;
+using reglisse::some;
+
+using mannele::u32;
+using mannele::u64;
+
+namespace cacao
+{
+   uniform_ring_buffer::uniform_ring_buffer(const uniform_ring_buffer_create_info& info) :
+      m_alignment(info.device.physical().getProperties().limits.minUniformBufferOffsetAlignment),
+      m_frame_count(info.frame_count),
+      m_bytes_per_frame(align_up(info.bytes_per_frame, m_alignment)),
+      m_buffer({.device = info.device,
+                .allocator = info.allocator,
+                .buffer_size = m_bytes_per_frame * m_frame_count,
+                .usage = vk::BufferUsageFlagBits::eUniformBuffer,
+                .desired_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible |
+                   vk::MemoryPropertyFlagBits::eHostCoherent,
+                .fallback_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible,
+                .is_frequently_updated = true,
+                .logger = info.logger}),
+      m_logger(info.logger)
+   {
+      m_logger.debug("Uniform ring buffer created with {} frames of {} bytes", m_frame_count,
+                     m_bytes_per_frame);
+   }
+
+   void uniform_ring_buffer::begin_frame(u64 frame_index) noexcept
+   {
+      m_frame_begin = (frame_index % m_frame_count) * m_bytes_per_frame;
+      m_frame_cursor = m_frame_begin;
+   }
+
+   auto uniform_ring_buffer::allocate(u64 size) noexcept -> maybe<uniform_allocation>
+   {
+      const u64 offset = align_up(m_frame_cursor, m_alignment);
+
+      if (offset + size > m_frame_begin + m_bytes_per_frame)
+      {
+         m_logger.warning("Uniform ring buffer frame region exhausted ({} bytes requested)", size);
+
+         return none;
+      }
+
+      m_frame_cursor = offset + size;
+
+      return some(uniform_allocation{.offset = static_cast<u32>(offset),
+                                     .data = m_buffer.mapped().subspan(offset, size)});
+   }
+
+   void uniform_ring_buffer::flush_frame() const
+   {
+      if (m_frame_cursor != m_frame_begin)
+      {
+         m_buffer.flush(m_frame_begin, m_frame_cursor - m_frame_begin);
+      }
+   }
+
+   auto uniform_ring_buffer::value() const noexcept -> vk::Buffer { return m_buffer.value(); }
+   auto uniform_ring_buffer::bytes_per_frame() const noexcept -> u64 { return m_bytes_per_frame; }
+} // namespace cacao
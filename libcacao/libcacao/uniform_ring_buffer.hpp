@@ -0,0 +1,115 @@
+/**
+ * @file libcacao/uniform_ring_buffer.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_UNIFORM_RING_BUFFER_HPP_
+#define LIBCACAO_UNIFORM_RING_BUFFER_HPP_
+
+#include <libcacao/buffer.hpp>
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+#include <libreglisse/maybe.hpp>
+
+// C++ Standard Library
+
+#include <cstring>
+#include <span>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT uniform_ring_buffer_create_info
+   {
+      const cacao::device& device;
+      cacao::allocator& allocator;
+
+      mannele::u64 frame_count{};
+      mannele::u64 bytes_per_frame{};
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief A sub-allocation made from the current frame's region of a uniform_ring_buffer.
+    */
+   struct uniform_allocation
+   {
+      mannele::u32 offset{};     ///< The dynamic offset to use when binding the descriptor set
+      std::span<std::byte> data; ///< Host visible memory backing the allocation
+   };
+
+   /**
+    * @brief Persistently mapped uniform buffer split in one region per frame in flight. Each region
+    * is linearly sub-allocated and reset at the start of its frame, so per-frame uniform data can
+    * be bound through a single eUniformBufferDynamic descriptor using dynamic offsets.
+    */
+   class LIBCACAO_SYMEXPORT uniform_ring_buffer
+   {
+   public:
+      uniform_ring_buffer() = default;
+      explicit uniform_ring_buffer(const uniform_ring_buffer_create_info& info);
+
+      /**
+       * @brief Reset the region associated with a frame in flight. Must only be called once the GPU
+       * is done with the previous use of that frame.
+       */
+      void begin_frame(mannele::u64 frame_index) noexcept;
+
+      /**
+       * @brief Sub-allocate `size` bytes from the current frame's region.
+       *
+       * @return None if the region does not have enough space left.
+       */
+      [[nodiscard]] auto allocate(mannele::u64 size) noexcept
+         -> reglisse::maybe<uniform_allocation>;
+
+      /**
+       * @brief Copy `value` into the current frame's region.
+       *
+       * @return The dynamic offset of the copied value.
+       */
+      template <typename Any>
+      [[nodiscard]] auto push(const Any& value) -> reglisse::maybe<mannele::u32>
+      {
+         if (auto allocation = allocate(sizeof(Any)))
+         {
+            std::memcpy(allocation.borrow().data.data(), &value, sizeof(Any));
+
+            return reglisse::some(allocation.borrow().offset);
+         }
+
+         return reglisse::none;
+      }
+
+      /**
+       * @brief Make the data written in the current frame's region visible to the device. Must be
+       * called before submitting work that reads from the current frame.
+       */
+      void flush_frame() const;
+
+      [[nodiscard]] auto value() const noexcept -> vk::Buffer;
+      [[nodiscard]] auto bytes_per_frame() const noexcept -> mannele::u64;
+
+   private:
+      mannele::u64 m_alignment{};
+      mannele::u64 m_frame_count{};
+      mannele::u64 m_bytes_per_frame{};
+
+      mannele::u64 m_frame_begin{};
+      mannele::u64 m_frame_cursor{};
+
+      cacao::buffer m_buffer;
+
+      mannele::log_ptr m_logger;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_UNIFORM_RING_BUFFER_HPP_
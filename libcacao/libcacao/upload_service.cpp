@@ -0,0 +1,350 @@
+/**
+ * @file libcacao/upload_service.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/upload_service.hpp>
+#include <libcacao/util/align.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/tracing/trace.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+using reglisse::some;
+
+using mannele::u64;
+
+namespace cacao
+{
+   auto find_staging_alignment(const cacao::device& device) -> u64
+   {
+      const auto limits = device.physical().getProperties().limits;
+
+      return std::max(
+         {u64{16}, limits.optimalBufferCopyOffsetAlignment, limits.nonCoherentAtomSize});
+   }
+
+   upload_service::upload_service(const upload_service_create_info& info) :
+      mp_device(&info.device), m_device(info.device.logical()),
+      m_transfer_queue(info.device.find_best_suited_queue(queue_flag_bits::transfer)),
+      m_graphics_family(info.device.find_best_suited_queue(queue_flag_bits::graphics).family_index),
+      m_staging_alignment(find_staging_alignment(info.device)),
+      m_pool({.device = info.device,
+              .queue_family_index = some(m_transfer_queue.family_index),
+              .logger = info.logger}),
+      m_staging({.device = info.device,
+                 .allocator = info.allocator,
+                 .buffer_size = align_up(info.staging_buffer_size, m_staging_alignment),
+                 .usage = vk::BufferUsageFlagBits::eTransferSrc,
+                 .desired_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible |
+                    vk::MemoryPropertyFlagBits::eHostCoherent,
+                 .fallback_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible,
+                 .logger = info.logger}),
+      m_logger(info.logger)
+   {
+      m_logger.debug("Upload service created on queue family {} with a {} byte staging ring",
+                     m_transfer_queue.family_index, m_staging.size());
+   }
+   upload_service::~upload_service()
+   {
+      while (!std::empty(m_in_flight))
+      {
+         wait_oldest_batch();
+      }
+   }
+
+   auto upload_service::upload(const cacao::buffer& dst, std::span<const std::byte> data,
+                               u64 dst_offset, vk::AccessFlags dst_access,
+                               vk::PipelineStageFlags dst_stages) -> upload_token
+   {
+      if (std::empty(data))
+      {
+         return {m_is_recording ? m_current.id : m_next_batch_id - 1};
+      }
+
+      const u64 capacity = m_staging.size();
+
+      for (u64 written = 0; written < std::size(data);)
+      {
+         const u64 chunk = std::min<u64>(std::size(data) - written, capacity);
+
+         // Making room in the ring may submit the current batch, so only start recording after
+         const u64 offset = allocate_staging(chunk);
+         ensure_recording();
+
+         std::ranges::copy(data.subspan(written, chunk),
+                           std::begin(m_staging.mapped().subspan(offset, chunk)));
+         m_staging.flush(offset, chunk);
+
+         m_current.cmd->copyBuffer(m_staging.value(), dst.value(),
+                                   {vk::BufferCopy{.srcOffset = offset,
+                                                   .dstOffset = dst_offset + written,
+                                                   .size = chunk}});
+
+         written += chunk;
+      }
+
+      ensure_recording();
+
+      if (m_transfer_queue.family_index != m_graphics_family)
+      {
+         // Acquire half of a queue family ownership transfer, source access is ignored
+         m_current.acquires.push_back(
+            vk::BufferMemoryBarrier{.dstAccessMask = dst_access,
+                                    .srcQueueFamilyIndex = m_transfer_queue.family_index,
+                                    .dstQueueFamilyIndex = m_graphics_family,
+                                    .buffer = dst.value(),
+                                    .offset = dst_offset,
+                                    .size = std::size(data)});
+      }
+      else
+      {
+         m_current.acquires.push_back(
+            vk::BufferMemoryBarrier{.srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+                                    .dstAccessMask = dst_access,
+                                    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                    .buffer = dst.value(),
+                                    .offset = dst_offset,
+                                    .size = std::size(data)});
+      }
+      m_current.acquire_stages |= dst_stages;
+
+      return {m_current.id};
+   }
+
+   auto upload_service::submit() -> upload_token
+   {
+      if (!m_is_recording)
+      {
+         return {m_next_batch_id - 1};
+      }
+
+      MANNELE_TRACE_ZONE_CAT("upload_service::submit", "cacao");
+
+      const auto fence = finish_recording();
+
+      m_transfer_queue.value.submit(
+         {vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &m_current.cmd.get()}},
+         fence);
+
+      return retire_recording();
+   }
+   auto upload_service::submit(submission_batch& batch) -> upload_token
+   {
+      if (!m_is_recording)
+      {
+         return {m_next_batch_id - 1};
+      }
+
+      const auto fence = finish_recording();
+      const std::array command_buffers{m_current.cmd.get()};
+
+      batch.add(m_transfer_queue, {.command_buffers = command_buffers, .fence = fence});
+
+      m_current.p_owner = &batch;
+      m_current.owner_flush_count = batch.flush_count();
+
+      return retire_recording();
+   }
+
+   auto upload_service::finish_recording() -> vk::Fence
+   {
+      if (m_transfer_queue.family_index != m_graphics_family)
+      {
+         // The release half of the ownership transfers, the graphics queue records the acquires
+         std::vector<vk::BufferMemoryBarrier> releases = m_current.acquires;
+         for (auto& barrier : releases)
+         {
+            barrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+            barrier.dstAccessMask = {};
+         }
+
+         m_current.cmd->pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                                        vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, releases,
+                                        {});
+      }
+
+      m_current.cmd->end();
+      m_current.staging_end = m_staging_head;
+
+      return m_current.fence.get();
+   }
+   auto upload_service::retire_recording() -> upload_token
+   {
+      m_logger.debug("Upload batch {} submitted with {} uploads", m_current.id,
+                     std::size(m_current.acquires));
+
+      const upload_token token{m_current.id};
+
+      m_in_flight.push_back(std::move(m_current));
+      m_current = {};
+      m_is_recording = false;
+
+      return token;
+   }
+
+   auto upload_service::is_complete(upload_token token) -> bool
+   {
+      collect_completed_batches();
+
+      return token.value <= m_last_completed_id;
+   }
+
+   void upload_service::wait(upload_token token)
+   {
+      if (m_is_recording && token.value >= m_current.id)
+      {
+         submit();
+      }
+
+      while (token.value > m_last_completed_id && !std::empty(m_in_flight))
+      {
+         wait_oldest_batch();
+      }
+   }
+
+   void upload_service::record_acquire_barriers(vk::CommandBuffer cmd)
+   {
+      collect_completed_batches();
+
+      if (std::empty(m_pending_acquires))
+      {
+         return;
+      }
+
+      cmd.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, m_pending_acquire_stages, {}, {},
+                          m_pending_acquires, {});
+
+      m_pending_acquires.clear();
+      m_pending_acquire_stages = {};
+   }
+
+   auto upload_service::allocate_staging(u64 size) -> u64
+   {
+      const u64 capacity = m_staging.size();
+      const u64 aligned_size = align_up(size, m_staging_alignment);
+
+      while (true)
+      {
+         if (m_staging_head == m_staging_tail)
+         {
+            // The ring is empty, restart from the beginning to avoid needless wrap-around padding
+            m_staging_head = align_up(m_staging_head, capacity);
+            m_staging_tail = m_staging_head;
+         }
+
+         const u64 position = m_staging_head % capacity;
+         const u64 padding = position + aligned_size > capacity ? capacity - position : 0;
+
+         if (capacity - (m_staging_head - m_staging_tail) >= padding + aligned_size)
+         {
+            m_staging_head += padding;
+
+            const u64 offset = m_staging_head % capacity;
+            m_staging_head += aligned_size;
+
+            return offset;
+         }
+
+         if (std::empty(m_in_flight))
+         {
+            // Only the batch being recorded holds staging memory
+            submit();
+         }
+
+         m_logger.debug("Staging ring full, waiting on upload batch {}", m_in_flight.front().id);
+
+         wait_oldest_batch();
+      }
+   }
+
+   void upload_service::ensure_recording()
+   {
+      if (m_is_recording)
+      {
+         return;
+      }
+
+      m_current.id = m_next_batch_id++;
+      m_current.cmd = std::move(
+         create_standalone_command_buffers(*mp_device, m_pool, command_buffer_level::primary, 1)
+            .front());
+
+      if (std::empty(m_free_fences))
+      {
+         m_current.fence = m_device.createFenceUnique({});
+      }
+      else
+      {
+         m_current.fence = std::move(m_free_fences.back());
+         m_free_fences.pop_back();
+      }
+
+      m_current.cmd->begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+
+      m_is_recording = true;
+   }
+
+   void upload_service::collect_completed_batches()
+   {
+      while (!std::empty(m_in_flight) &&
+             m_device.getFenceStatus(m_in_flight.front().fence.get()) == vk::Result::eSuccess)
+      {
+         retire_oldest_batch();
+      }
+   }
+
+   void upload_service::ensure_submitted(upload_batch& batch)
+   {
+      if (batch.p_owner && batch.p_owner->flush_count() == batch.owner_flush_count)
+      {
+         m_logger.debug("Flushing the submissions holding upload batch {} before waiting on it",
+                        batch.id);
+
+         batch.p_owner->flush();
+      }
+
+      batch.p_owner = nullptr;
+   }
+
+   void upload_service::wait_oldest_batch()
+   {
+      MANNELE_TRACE_ZONE_CAT("upload_service::wait", "cacao");
+
+      ensure_submitted(m_in_flight.front());
+
+      // NOLINTNEXTLINE
+      const auto result = m_device.waitForFences({m_in_flight.front().fence.get()}, true,
+                                                 std::numeric_limits<u64>::max());
+      static_cast<void>(result);
+
+      retire_oldest_batch();
+   }
+
+   void upload_service::retire_oldest_batch()
+   {
+      auto& batch = m_in_flight.front();
+
+      m_staging_tail = batch.staging_end;
+      m_last_completed_id = batch.id;
+
+      m_pending_acquires.insert(std::end(m_pending_acquires), std::begin(batch.acquires),
+                                std::end(batch.acquires));
+      m_pending_acquire_stages |= batch.acquire_stages;
+
+      m_device.resetFences({batch.fence.get()});
+      m_free_fences.push_back(std::move(batch.fence));
+
+      m_in_flight.pop_front();
+   }
+} // namespace cacao
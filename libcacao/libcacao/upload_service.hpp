@@ -0,0 +1,195 @@
+/**
+ * @file libcacao/upload_service.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_UPLOAD_SERVICE_HPP_
+#define LIBCACAO_UPLOAD_SERVICE_HPP_
+
+#include <libcacao/allocator.hpp>
+#include <libcacao/buffer.hpp>
+#include <libcacao/command_pool.hpp>
+#include <libcacao/device.hpp>
+#include <libcacao/export.hpp>
+#include <libcacao/submission_batch.hpp>
+
+// Third Party Libraries
+
+#include <libmannele/logging/log_ptr.hpp>
+
+// C++ Standard Library
+
+#include <deque>
+#include <span>
+#include <vector>
+
+namespace cacao
+{
+   struct LIBCACAO_SYMEXPORT upload_service_create_info
+   {
+      const cacao::device& device;
+      cacao::allocator& allocator;
+
+      /**
+       * Size of the persistently mapped staging ring. Uploads larger than the ring are split in
+       * multiple copies.
+       */
+      mannele::u64 staging_buffer_size = 32ULL * 1024ULL * 1024ULL;
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief Completion token of an upload. Tokens are ordered: once a token is complete, every
+    * token with a smaller value is as well.
+    */
+   struct upload_token
+   {
+      mannele::u64 value{};
+   };
+
+   /**
+    * @brief Stream data to device local buffers through the transfer queue.
+    *
+    * Uploads are copied in a persistently mapped staging ring and the copy commands are batched
+    * until submit() is called, which issues a single submission on the transfer queue guarded by a
+    * fence. Staging memory is reclaimed as batches complete, so uploads only ever wait on the GPU
+    * when the ring is full.
+    *
+    * When the transfer and graphics queues belong to different families, buffers are released by
+    * the transfer queue and must be acquired on the graphics queue by recording the barriers
+    * returned through record_acquire_barriers() before they are used.
+    */
+   class LIBCACAO_SYMEXPORT upload_service
+   {
+   public:
+      explicit upload_service(const upload_service_create_info& info);
+      upload_service(const upload_service&) = delete;
+      upload_service(upload_service&&) = delete;
+      ~upload_service();
+
+      auto operator=(const upload_service&) -> upload_service& = delete;
+      auto operator=(upload_service&&) -> upload_service& = delete;
+
+      /**
+       * Queue a copy of `data` into `dst` at `dst_offset`. `dst` must have been created with
+       * eTransferDst usage and must stay alive until the returned token completes.
+       *
+       * @param dst_access How the data will be accessed on the graphics queue.
+       * @param dst_stages Stages the data will be accessed from on the graphics queue.
+       */
+      auto upload(const cacao::buffer& dst, std::span<const std::byte> data,
+                  mannele::u64 dst_offset = 0,
+                  vk::AccessFlags dst_access = vk::AccessFlagBits::eMemoryRead,
+                  vk::PipelineStageFlags dst_stages = vk::PipelineStageFlagBits::eAllCommands)
+         -> upload_token;
+
+      template <typename Any>
+      auto upload(const cacao::buffer& dst, std::span<const Any> data, mannele::u64 dst_offset = 0,
+                  vk::AccessFlags dst_access = vk::AccessFlagBits::eMemoryRead,
+                  vk::PipelineStageFlags dst_stages = vk::PipelineStageFlagBits::eAllCommands)
+         -> upload_token
+      {
+         return upload(dst, std::as_bytes(data), dst_offset, dst_access, dst_stages);
+      }
+
+      /**
+       * Submit the batch currently being recorded to the transfer queue.
+       *
+       * @return The token of the submitted batch.
+       */
+      auto submit() -> upload_token;
+      /**
+       * Add the batch currently being recorded to the transfer queue submissions of `batch`
+       * instead of submitting it right away. If the upload has to be waited on before `batch` is
+       * flushed, by wait() or because the staging ring is full, `batch` is flushed first. `batch`
+       * must outlive the service.
+       *
+       * @return The token of the batch.
+       */
+      auto submit(submission_batch& batch) -> upload_token;
+
+      /**
+       * Check whether the batch associated with `token` has finished executing. Reclaims the
+       * staging memory of every completed batch.
+       */
+      [[nodiscard]] auto is_complete(upload_token token) -> bool;
+
+      /**
+       * Block until the batch associated with `token` has finished executing, submitting it first
+       * if it is still being recorded or flushing the submission_batch it was handed to.
+       */
+      void wait(upload_token token);
+
+      /**
+       * Record the queue family ownership acquire barriers of every completed upload in a graphics
+       * command buffer. Each barrier is only recorded once. Must be called outside of a render
+       * pass.
+       */
+      void record_acquire_barriers(vk::CommandBuffer cmd);
+
+   private:
+      struct upload_batch
+      {
+         mannele::u64 id{};
+         mannele::u64 staging_end{};
+
+         vk::UniqueCommandBuffer cmd;
+         vk::UniqueFence fence;
+
+         std::vector<vk::BufferMemoryBarrier> acquires;
+         vk::PipelineStageFlags acquire_stages{};
+
+         /**
+          * The submission_batch the batch was handed to, null once it is known to be submitted.
+          * The fence of a batch that was never submitted would never signal.
+          */
+         submission_batch* p_owner{nullptr};
+         mannele::u64 owner_flush_count{}; ///< Flush count of the owner when the batch was added
+      };
+
+      [[nodiscard]] auto allocate_staging(mannele::u64 size) -> mannele::u64;
+
+      void ensure_recording();
+      auto finish_recording() -> vk::Fence;
+      auto retire_recording() -> upload_token;
+      void collect_completed_batches();
+      void ensure_submitted(upload_batch& batch);
+      void wait_oldest_batch();
+      void retire_oldest_batch();
+
+   private:
+      const cacao::device* mp_device{nullptr};
+      vk::Device m_device;
+
+      cacao::queue m_transfer_queue;
+      mannele::u32 m_graphics_family{};
+
+      mannele::u64 m_staging_alignment{};
+
+      cacao::command_pool m_pool;
+      cacao::buffer m_staging;
+
+      mannele::u64 m_staging_head{}; ///< Total amount of bytes handed out from the ring
+      mannele::u64 m_staging_tail{}; ///< Total amount of bytes reclaimed from the ring
+
+      mannele::u64 m_next_batch_id{1};
+      mannele::u64 m_last_completed_id{0};
+
+      upload_batch m_current;
+      bool m_is_recording{false};
+
+      std::deque<upload_batch> m_in_flight;
+      std::vector<vk::UniqueFence> m_free_fences;
+
+      std::vector<vk::BufferMemoryBarrier> m_pending_acquires;
+      vk::PipelineStageFlags m_pending_acquire_stages{};
+
+      mannele::log_ptr m_logger;
+   };
+} // namespace cacao
+
+#endif // LIBCACAO_UPLOAD_SERVICE_HPP_
@@ -0,0 +1,37 @@
+/**
+ * @file libcacao/util/align.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBCACAO_UTIL_ALIGN_HPP_
+#define LIBCACAO_UTIL_ALIGN_HPP_
+
+// Third Party Libraries
+
+#include <libmannele/core.hpp>
+
+namespace cacao
+{
+   /**
+    * Round `value` up to the next multiple of `alignment`. An alignment of 0 leaves the value
+    * unchanged.
+    */
+   constexpr auto align_up(mannele::u64 value, mannele::u64 alignment) noexcept -> mannele::u64
+   {
+      return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+   }
+
+   /**
+    * Round `value` down to the previous multiple of `alignment`. An alignment of 0 leaves the
+    * value unchanged.
+    */
+   constexpr auto align_down(mannele::u64 value, mannele::u64 alignment) noexcept -> mannele::u64
+   {
+      return alignment == 0 ? value : value / alignment * alignment;
+   }
+} // namespace cacao
+
+#endif // LIBCACAO_UTIL_ALIGN_HPP_
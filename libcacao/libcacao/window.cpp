@@ -73,6 +73,15 @@ namespace cacao
 
    auto window::title() const -> std::string_view { return m_title; }
    auto window::dimension() const -> const mannele::dimension_u32& { return m_dimension; }
+   auto window::framebuffer_dimension() const -> mannele::dimension_u32
+   {
+      int width = 0;
+      int height = 0;
+      glfwGetFramebufferSize(p_window_handle.get(), &width, &height);
+
+      return {.width = static_cast<mannele::u32>(width),
+              .height = static_cast<mannele::u32>(height)};
+   }
    auto window::is_resizable() const -> bool { return m_is_resizable; }
    auto window::is_open() const -> bool { return !glfwWindowShouldClose(p_window_handle.get()); }
 } // namespace cacao
@@ -56,6 +56,11 @@ namespace cacao
 
       [[nodiscard]] auto title() const -> std::string_view;
       [[nodiscard]] auto dimension() const -> const mannele::dimension_u32&;
+      /**
+       * Query the current size of the window's framebuffer in pixels, which follows resizes unlike
+       * dimension().
+       */
+      [[nodiscard]] auto framebuffer_dimension() const -> mannele::dimension_u32;
       [[nodiscard]] auto is_resizable() const -> bool;
       [[nodiscard]] auto is_open() const -> bool;
 
@@ -0,0 +1,163 @@
+/**
+ * @file tests/basics/allocator_test.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/allocator.hpp>
+#include <libcacao/context.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using mannele::u32;
+using mannele::u64;
+
+class allocator_test : public testing::Test
+{
+protected:
+   static constexpr u64 block_size = 1024ULL * 1024ULL;
+   static constexpr u64 transient_block_size = 64ULL * 1024ULL;
+   static constexpr u64 frame_count = 2;
+
+   void SetUp() override
+   {
+      try
+      {
+         m_context = std::make_unique<cacao::context>(cacao::context_create_info{});
+         m_device =
+            std::make_unique<cacao::device>(cacao::device_create_info{.ctx = *m_context});
+      }
+      catch (const std::exception& e)
+      {
+         GTEST_SKIP() << "no Vulkan device available: " << e.what();
+      }
+
+      m_allocator = std::make_unique<cacao::allocator>(
+         cacao::allocator_create_info{.device = *m_device,
+                                      .block_size = block_size,
+                                      .transient_frame_count = frame_count,
+                                      .transient_block_size = transient_block_size});
+   }
+
+   auto allocate(u64 size, u64 alignment = 1, bool is_transient = false)
+      -> cacao::memory_allocation
+   {
+      return m_allocator->allocate(
+         {.requirements = {.size = size, .alignment = alignment, .memoryTypeBits = ~0U},
+          .desired_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible,
+          .is_transient = is_transient});
+   }
+
+   std::unique_ptr<cacao::context> m_context;
+   std::unique_ptr<cacao::device> m_device;
+   std::unique_ptr<cacao::allocator> m_allocator;
+};
+
+TEST_F(allocator_test, buddy_allocations_are_aligned_and_disjoint)
+{
+   std::vector<cacao::memory_allocation> allocations;
+   allocations.push_back(allocate(300));  // NOLINT
+   allocations.push_back(allocate(1000)); // NOLINT
+   allocations.push_back(allocate(256));  // NOLINT
+   allocations.push_back(allocate(2000)); // NOLINT
+
+   // Buddy nodes are powers of two of at least 256 bytes, aligned to their size
+   const std::vector<u64> node_sizes = {512, 1024, 256, 2048};
+
+   for (u64 i = 0; i < std::size(allocations); ++i)
+   {
+      EXPECT_EQ(allocations[i].memory(), allocations[0].memory());
+      EXPECT_EQ(allocations[i].offset() % node_sizes[i], 0U);
+
+      for (u64 j = 0; j < i; ++j)
+      {
+         const bool is_disjoint =
+            allocations[i].offset() + node_sizes[i] <= allocations[j].offset() ||
+            allocations[j].offset() + node_sizes[j] <= allocations[i].offset();
+
+         EXPECT_TRUE(is_disjoint) << "allocations " << j << " and " << i << " overlap";
+      }
+   }
+
+   EXPECT_EQ(m_allocator->statistics().bytes_allocated, 512U + 1024U + 256U + 2048U);
+}
+
+TEST_F(allocator_test, freed_buddies_coalesce)
+{
+   std::vector<cacao::memory_allocation> allocations;
+   for (u32 i = 0; i < 8; ++i) // NOLINT
+   {
+      allocations.push_back(allocate(256)); // NOLINT
+   }
+
+   const auto memory = allocations[0].memory();
+   const auto reserved = m_allocator->statistics().bytes_reserved;
+   EXPECT_LT(m_allocator->statistics().largest_free_range, reserved);
+
+   // Free every other node first, no two buddies are free at the same time
+   for (u64 i = 0; i < std::size(allocations); i += 2)
+   {
+      allocations[i] = {};
+   }
+
+   EXPECT_LT(m_allocator->statistics().largest_free_range, reserved);
+
+   for (u64 i = 1; i < std::size(allocations); i += 2)
+   {
+      allocations[i] = {};
+   }
+
+   const auto stats = m_allocator->statistics();
+   EXPECT_EQ(stats.block_count, 1U);
+   EXPECT_EQ(stats.allocation_count, 0U);
+   EXPECT_EQ(stats.bytes_allocated, 0U);
+   EXPECT_EQ(stats.largest_free_range, reserved);
+
+   // The largest buddy allocation fits in the block again
+   const auto half = allocate(reserved / 2);
+   EXPECT_EQ(half.memory(), memory);
+   EXPECT_EQ(half.offset(), 0U);
+}
+
+TEST_F(allocator_test, linear_allocations_are_sequential)
+{
+   m_allocator->begin_frame(0);
+
+   const auto first = allocate(100, 64, true);  // NOLINT
+   const auto second = allocate(100, 64, true); // NOLINT
+
+   EXPECT_EQ(first.memory(), second.memory());
+   EXPECT_EQ(first.offset(), 0U);
+   EXPECT_GE(second.offset(), first.offset() + 100);
+   EXPECT_EQ(second.offset() % 64, 0U);
+
+   const auto stats = m_allocator->statistics();
+   EXPECT_EQ(stats.transient_block_count, 1U);
+   EXPECT_EQ(stats.allocation_count, 2U);
+}
+
+TEST_F(allocator_test, begin_frame_resets_the_linear_pool_of_the_frame)
+{
+   m_allocator->begin_frame(0);
+   const auto frame_0 = allocate(1000, 256, true);      // NOLINT
+   const auto frame_0_next = allocate(1000, 256, true); // NOLINT
+   EXPECT_NE(frame_0_next.offset(), 0U);
+
+   // Each frame in flight has its own pool, the previous frame's memory is still in use
+   m_allocator->begin_frame(1);
+   const auto frame_1 = allocate(1000, 256, true); // NOLINT
+   EXPECT_NE(frame_1.memory(), frame_0.memory());
+   EXPECT_EQ(frame_1.offset(), 0U);
+
+   m_allocator->begin_frame(frame_count);
+   const auto frame_2 = allocate(1000, 256, true); // NOLINT
+   EXPECT_EQ(frame_2.memory(), frame_0.memory());
+   EXPECT_EQ(frame_2.offset(), 0U);
+
+   EXPECT_EQ(m_allocator->statistics().transient_block_count, frame_count);
+}
@@ -6,7 +6,11 @@
  * @copyright Copyright (C) 2021 wmbat.
  */
 
-auto main () -> int
+#include <gtest/gtest.h>
+
+auto main(int argc, char** argv) -> int
 {
-   return 0;
+   testing::InitGoogleTest(&argc, argv);
+
+   return RUN_ALL_TESTS();
 }
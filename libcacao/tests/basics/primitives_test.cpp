@@ -0,0 +1,315 @@
+/**
+ * @file tests/basics/primitives_test.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/command_pool.hpp>
+#include <libcacao/context.hpp>
+#include <libcacao/primitives/compaction.hpp>
+#include <libcacao/primitives/radix_sort.hpp>
+#include <libcacao/primitives/scan.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace fs = std::filesystem;
+
+/**
+ * Directory holding the compiled primitives/shaders/ of libcacao. The LIBCACAO_SHADER_DIR
+ * environment variable overrides the build output directory set by the buildfile.
+ */
+auto shader_directory() -> std::optional<fs::path>
+{
+   // NOLINTNEXTLINE
+   if (const char* dir = std::getenv("LIBCACAO_SHADER_DIR"))
+   {
+      return fs::path(dir);
+   }
+
+#if defined(LIBCACAO_TEST_SHADER_DIR)
+   return fs::path(LIBCACAO_TEST_SHADER_DIR);
+#else
+   return std::nullopt;
+#endif
+}
+
+auto load_spirv(const fs::path& path) -> std::vector<u32>
+{
+   std::ifstream file(path, std::ios::binary | std::ios::ate);
+   if (!file)
+   {
+      return {};
+   }
+
+   std::vector<u32> binary(static_cast<u64>(file.tellg()) / sizeof(u32));
+   file.seekg(0);
+   // NOLINTNEXTLINE
+   file.read(reinterpret_cast<char*>(std::data(binary)),
+             static_cast<std::streamsize>(std::size(binary) * sizeof(u32)));
+
+   return binary;
+}
+
+class primitives_test : public testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      const auto dir = shader_directory();
+      if (!dir)
+      {
+         GTEST_SKIP() << "LIBCACAO_SHADER_DIR is not set";
+      }
+
+      m_scan_binary = load_spirv(*dir / "scan.comp.spv");
+      m_sort_binary = load_spirv(*dir / "radix_sort.comp.spv");
+      m_compact_binary = load_spirv(*dir / "compact.comp.spv");
+
+      // The shaders are built along with the library, missing ones are a broken build
+      if (std::empty(m_scan_binary) || std::empty(m_sort_binary) || std::empty(m_compact_binary))
+      {
+         GTEST_FAIL() << "compiled primitive shaders not found in " << *dir;
+      }
+
+      try
+      {
+         m_context = std::make_unique<cacao::context>(cacao::context_create_info{});
+         m_device = std::make_unique<cacao::device>(
+            cacao::device_create_info{.ctx = *m_context, .use_compute_queue = true});
+      }
+      catch (const std::exception& e)
+      {
+         GTEST_SKIP() << "no Vulkan device available: " << e.what();
+      }
+
+      m_queue = m_device->find_best_suited_queue(cacao::queue_flag_bits::compute);
+
+      m_allocator = std::make_unique<cacao::allocator>(
+         cacao::allocator_create_info{.device = *m_device});
+      m_descriptors = std::make_unique<cacao::descriptor_allocator>(
+         cacao::descriptor_allocator_create_info{.device = *m_device});
+      m_pool = std::make_unique<cacao::command_pool>(
+         cacao::command_pool_create_info{.device = *m_device,
+                                         .queue_family_index = m_queue.family_index,
+                                         .primary_buffer_count = 1});
+   }
+
+   auto make_buffer(u64 count) -> cacao::buffer
+   {
+      return cacao::buffer(
+         {.device = *m_device,
+          .allocator = *m_allocator,
+          .buffer_size = std::max<u64>(count, 1) * sizeof(u32),
+          .usage = vk::BufferUsageFlagBits::eStorageBuffer,
+          .desired_mem_flags =
+             vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent});
+   }
+
+   auto make_buffer(std::span<const u32> values) -> cacao::buffer
+   {
+      auto buffer = make_buffer(std::size(values));
+      std::ranges::copy(values, std::begin(buffer.mapped_as<u32>()));
+      buffer.flush();
+
+      return buffer;
+   }
+
+   static auto read(const cacao::buffer& buffer, u64 count) -> std::vector<u32>
+   {
+      buffer.invalidate();
+
+      const auto values = buffer.mapped_as<u32>().first(count);
+      return {std::begin(values), std::end(values)};
+   }
+
+   /**
+    * Record the commands of `fun` in a one time command buffer and wait for their completion.
+    */
+   template <typename Fun>
+   void execute(Fun&& fun)
+   {
+      const auto cmd = m_pool->primary_buffers()[0];
+
+      cmd.begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+      std::forward<Fun>(fun)(cmd);
+
+      const vk::MemoryBarrier to_host{.srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+                                      .dstAccessMask = vk::AccessFlagBits::eHostRead};
+      cmd.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                          vk::PipelineStageFlagBits::eHost, {}, to_host, {}, {});
+
+      cmd.end();
+
+      m_queue.value.submit(vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &cmd});
+      m_queue.value.waitIdle();
+
+      m_device->logical().resetCommandPool(m_pool->value());
+      m_descriptors->reset();
+   }
+
+   static auto random_values(u64 count, u32 max) -> std::vector<u32>
+   {
+      std::mt19937 engine(static_cast<u32>(count)); // NOLINT
+      std::uniform_int_distribution<u32> distribution(0, max);
+
+      std::vector<u32> values(count);
+      std::ranges::generate(values, [&] { return distribution(engine); });
+
+      return values;
+   }
+
+protected:
+   std::vector<u32> m_scan_binary;
+   std::vector<u32> m_sort_binary;
+   std::vector<u32> m_compact_binary;
+
+   std::unique_ptr<cacao::context> m_context;
+   std::unique_ptr<cacao::device> m_device;
+   cacao::queue m_queue;
+
+   std::unique_ptr<cacao::allocator> m_allocator;
+   std::unique_ptr<cacao::descriptor_allocator> m_descriptors;
+   std::unique_ptr<cacao::command_pool> m_pool;
+};
+
+// Sizes around the block boundaries, and past a single workgroup of block sums
+static constexpr std::array element_counts{1UL,    2UL,     1023UL,   1024UL,
+                                           1025UL, 4096UL,  100'000UL, 2'000'000UL};
+
+TEST_F(primitives_test, scan_matches_reference)
+{
+   const cacao::gpu_scan scan({.device = *m_device,
+                               .allocator = *m_allocator,
+                               .binary = m_scan_binary,
+                               .max_element_count = element_counts.back()});
+
+   for (const u64 count : element_counts)
+   {
+      const auto values = random_values(count, 16);
+
+      std::vector<u32> expected(count);
+      std::exclusive_scan(std::begin(values), std::end(values), std::begin(expected), 0U);
+
+      const auto input = make_buffer(values);
+      const auto output = make_buffer(count);
+
+      execute([&](vk::CommandBuffer cmd) {
+         scan.record(cmd, *m_descriptors, input.value(), output.value(), count);
+      });
+
+      EXPECT_EQ(read(output, count), expected) << "count = " << count;
+   }
+}
+
+TEST_F(primitives_test, scan_in_place)
+{
+   const u64 count = 5000;
+   const cacao::gpu_scan scan({.device = *m_device,
+                               .allocator = *m_allocator,
+                               .binary = m_scan_binary,
+                               .max_element_count = count});
+
+   const auto values = random_values(count, 3);
+
+   std::vector<u32> expected(count);
+   std::exclusive_scan(std::begin(values), std::end(values), std::begin(expected), 0U);
+
+   const auto buffer = make_buffer(values);
+
+   execute([&](vk::CommandBuffer cmd) {
+      scan.record(cmd, *m_descriptors, buffer.value(), buffer.value(), count);
+   });
+
+   EXPECT_EQ(read(buffer, count), expected);
+}
+
+TEST_F(primitives_test, radix_sort_matches_reference)
+{
+   const cacao::gpu_radix_sort sort({.device = *m_device,
+                                     .allocator = *m_allocator,
+                                     .scan_binary = m_scan_binary,
+                                     .sort_binary = m_sort_binary,
+                                     .max_element_count = element_counts.back()});
+
+   for (const u64 count : element_counts)
+   {
+      const auto keys = random_values(count, std::numeric_limits<u32>::max());
+
+      std::vector<u32> values(count);
+      std::iota(std::begin(values), std::end(values), 0U);
+
+      // The sort is stable, equal keys keep the order of their values
+      std::vector<std::pair<u32, u32>> expected(count);
+      std::ranges::transform(keys, values, std::begin(expected),
+                             [](u32 key, u32 value) { return std::pair{key, value}; });
+      std::ranges::stable_sort(expected, {}, &std::pair<u32, u32>::first);
+
+      const auto key_buffer = make_buffer(keys);
+      const auto value_buffer = make_buffer(values);
+
+      execute([&](vk::CommandBuffer cmd) {
+         sort.record(cmd, *m_descriptors, key_buffer.value(), value_buffer.value(), count);
+      });
+
+      const auto sorted_keys = read(key_buffer, count);
+      const auto sorted_values = read(value_buffer, count);
+
+      for (u64 i = 0; i < count; ++i)
+      {
+         ASSERT_EQ(sorted_keys[i], expected[i].first) << "count = " << count << ", i = " << i;
+         ASSERT_EQ(sorted_values[i], expected[i].second) << "count = " << count << ", i = " << i;
+      }
+   }
+}
+
+TEST_F(primitives_test, compaction_matches_reference)
+{
+   const cacao::gpu_compaction compaction({.device = *m_device,
+                                           .allocator = *m_allocator,
+                                           .scan_binary = m_scan_binary,
+                                           .compact_binary = m_compact_binary,
+                                           .max_element_count = element_counts.back()});
+
+   for (const u64 count : std::array{0UL, 1UL, 1025UL, 100'000UL})
+   {
+      const auto values = random_values(count, std::numeric_limits<u32>::max());
+      const auto flags = random_values(count, 1);
+
+      std::vector<u32> expected;
+      for (u64 i = 0; i < count; ++i)
+      {
+         if (flags[i] != 0)
+         {
+            expected.push_back(values[i]);
+         }
+      }
+
+      const auto value_buffer = make_buffer(values);
+      const auto flag_buffer = make_buffer(flags);
+      const auto output = make_buffer(count);
+      const auto output_count = make_buffer(1);
+
+      execute([&](vk::CommandBuffer cmd) {
+         compaction.record(cmd, *m_descriptors, value_buffer.value(), flag_buffer.value(),
+                           output.value(), output_count.value(), count);
+      });
+
+      ASSERT_EQ(read(output_count, 1)[0], std::size(expected)) << "count = " << count;
+      EXPECT_EQ(read(output, std::size(expected)), expected) << "count = " << count;
+   }
+}
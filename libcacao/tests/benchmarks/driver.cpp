@@ -0,0 +1,161 @@
+/**
+ * @file tests/benchmarks/driver.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 14th of September 2021
+ * @brief Throughput of the GPU scan, radix sort and compaction from 2^10 to 2^24 elements.
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libcacao/command_pool.hpp>
+#include <libcacao/context.hpp>
+#include <libcacao/primitives/compaction.hpp>
+#include <libcacao/primitives/radix_sort.hpp>
+#include <libcacao/primitives/scan.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+
+using mannele::u32;
+using mannele::u64;
+
+namespace fs = std::filesystem;
+
+static constexpr u64 min_exponent = 10;
+static constexpr u64 max_exponent = 24;
+static constexpr u64 iteration_count = 10;
+
+auto load_spirv(const fs::path& path) -> std::vector<u32>
+{
+   std::ifstream file(path, std::ios::binary | std::ios::ate);
+   if (!file)
+   {
+      std::cerr << "failed to open " << path << '\n';
+      std::exit(EXIT_FAILURE); // NOLINT
+   }
+
+   std::vector<u32> binary(static_cast<u64>(file.tellg()) / sizeof(u32));
+   file.seekg(0);
+   // NOLINTNEXTLINE
+   file.read(reinterpret_cast<char*>(std::data(binary)),
+             static_cast<std::streamsize>(std::size(binary) * sizeof(u32)));
+
+   return binary;
+}
+
+auto main(int argc, char** argv) -> int
+{
+   if (argc != 2)
+   {
+      std::cerr << "usage: driver <compiled primitives shader directory>\n";
+      return EXIT_FAILURE;
+   }
+
+   const auto shader_dir = fs::path(argv[1]); // NOLINT
+   const auto scan_binary = load_spirv(shader_dir / "scan.comp.spv");
+   const auto sort_binary = load_spirv(shader_dir / "radix_sort.comp.spv");
+   const auto compact_binary = load_spirv(shader_dir / "compact.comp.spv");
+
+   const cacao::context context({});
+   const cacao::device device({.ctx = context, .use_compute_queue = true});
+   const auto queue = device.find_best_suited_queue(cacao::queue_flag_bits::compute);
+
+   cacao::allocator allocator({.device = device});
+   cacao::descriptor_allocator descriptors({.device = device});
+   const cacao::command_pool pool({.device = device,
+                                   .queue_family_index = queue.family_index,
+                                   .primary_buffer_count = 1});
+
+   const u64 max_count = 1ULL << max_exponent;
+
+   const cacao::gpu_scan scan({.device = device,
+                               .allocator = allocator,
+                               .binary = scan_binary,
+                               .max_element_count = max_count});
+   const cacao::gpu_radix_sort sort({.device = device,
+                                     .allocator = allocator,
+                                     .scan_binary = scan_binary,
+                                     .sort_binary = sort_binary,
+                                     .max_element_count = max_count});
+   const cacao::gpu_compaction compaction({.device = device,
+                                           .allocator = allocator,
+                                           .scan_binary = scan_binary,
+                                           .compact_binary = compact_binary,
+                                           .max_element_count = max_count});
+
+   const auto make_buffer = [&](u64 count) {
+      return cacao::buffer(
+         {.device = device,
+          .allocator = allocator,
+          .buffer_size = count * sizeof(u32),
+          .usage = vk::BufferUsageFlagBits::eStorageBuffer,
+          .desired_mem_flags =
+             vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent});
+   };
+
+   // Keys and flags are random, the scan adds up the flags
+   const auto keys = make_buffer(max_count);
+   const auto values = make_buffer(max_count);
+   const auto flags = make_buffer(max_count);
+   const auto output = make_buffer(max_count);
+   const auto output_count = make_buffer(1);
+
+   std::mt19937 engine(0); // NOLINT
+   std::ranges::generate(flags.mapped_as<u32>(), [&] { return engine() & 1U; });
+
+   const auto reset_keys = [&] {
+      std::ranges::generate(keys.mapped_as<u32>(), std::ref(engine));
+      std::ranges::generate(values.mapped_as<u32>(), std::ref(engine));
+   };
+
+   const auto measure = [&](const char* name, u64 count, auto&& before, auto&& record) {
+      const auto cmd = pool.primary_buffers()[0];
+
+      std::chrono::nanoseconds total{};
+      for (u64 i = 0; i < iteration_count; ++i)
+      {
+         before();
+
+         cmd.begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+         record(cmd);
+         cmd.end();
+
+         const auto start = std::chrono::steady_clock::now();
+         queue.value.submit(vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &cmd});
+         queue.value.waitIdle();
+         total += std::chrono::steady_clock::now() - start;
+
+         device.logical().resetCommandPool(pool.value());
+         descriptors.reset();
+      }
+
+      const double seconds = std::chrono::duration<double>(total).count() / iteration_count;
+      std::cout << name << " " << count << " elements: " << seconds * 1e3 << " ms, "
+                << static_cast<double>(count) / seconds * 1e-6 << " Melements/s\n";
+   };
+
+   const auto nothing = [] {};
+
+   for (u64 exponent = min_exponent; exponent <= max_exponent; ++exponent)
+   {
+      const u64 count = 1ULL << exponent;
+
+      measure("scan", count, nothing, [&](vk::CommandBuffer cmd) {
+         scan.record(cmd, descriptors, flags.value(), output.value(), count);
+      });
+      measure("radix_sort", count, reset_keys, [&](vk::CommandBuffer cmd) {
+         sort.record(cmd, descriptors, keys.value(), values.value(), count);
+      });
+      measure("compaction", count, nothing, [&](vk::CommandBuffer cmd) {
+         compaction.record(cmd, descriptors, values.value(), flags.value(), output.value(),
+                           output_count.value(), count);
+      });
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,427 @@
+/**
+ * @file libmannele/tracing/trace.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 22nd of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#include <libmannele/tracing/trace.hpp>
+
+#include <magic_enum.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct trace_error_category : std::error_category
+{
+   [[nodiscard]] auto name() const noexcept -> const char* override { return "trace"; }
+   [[nodiscard]] auto message(int err) const -> std::string override
+   {
+      return std::string(magic_enum::enum_name(static_cast<mannele::trace_error>(err)));
+   }
+};
+
+inline static const trace_error_category trace_error_cat{};
+
+namespace mannele
+{
+   namespace
+   {
+      using clock = std::chrono::steady_clock;
+
+      constexpr u32 cpu_process_id = 0;
+      constexpr u32 gpu_process_id = 1;
+
+      /**
+       * Events of a single thread. Only the owning thread pushes and only the holder of the state
+       * mutex drains, so the indices are the only synchronisation needed.
+       */
+      class event_ring
+      {
+      public:
+         event_ring(u32 capacity, u32 thread_id) :
+            m_events(std::bit_ceil(std::max(capacity, 2U))), m_mask(std::size(m_events) - 1),
+            m_thread_id(thread_id)
+         {}
+
+         auto push(const trace_event& event) noexcept -> bool
+         {
+            const u64 head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) == std::size(m_events))
+            {
+               m_dropped.fetch_add(1, std::memory_order_relaxed);
+
+               return false;
+            }
+
+            m_events[head & m_mask] = event;
+            m_head.store(head + 1, std::memory_order_release);
+
+            return true;
+         }
+
+         template <typename Fun>
+         void drain(Fun&& fun)
+         {
+            const u64 tail = m_tail.load(std::memory_order_relaxed);
+            const u64 head = m_head.load(std::memory_order_acquire);
+
+            for (u64 i = tail; i != head; ++i)
+            {
+               fun(m_events[i & m_mask]);
+            }
+
+            m_tail.store(head, std::memory_order_release);
+         }
+
+         [[nodiscard]] auto thread_id() const noexcept -> u32 { return m_thread_id; }
+         [[nodiscard]] auto dropped() const noexcept -> u64
+         {
+            return m_dropped.load(std::memory_order_relaxed);
+         }
+
+      private:
+         std::vector<trace_event> m_events;
+         u64 m_mask;
+         u32 m_thread_id;
+
+         alignas(64) std::atomic<u64> m_head{0};
+         alignas(64) std::atomic<u64> m_tail{0};
+         std::atomic<u64> m_dropped{0};
+      };
+
+      struct recorded_event
+      {
+         trace_event event;
+         u32 thread_id;
+      };
+
+      struct gpu_event
+      {
+         std::string name;
+         u64 begin;
+         u64 end;
+      };
+
+      struct trace_state
+      {
+         std::mutex mutex;
+
+         tracing_config config;
+
+         std::vector<std::shared_ptr<event_ring>> rings;
+         std::vector<recorded_event> events;
+         std::vector<gpu_event> gpu_events;
+         std::map<u32, std::string> thread_names;
+
+         u32 next_thread_id{1};
+         u64 dropped_event_count{0}; ///< Not counted by the rings currently registered
+
+         std::condition_variable_any flush_signal;
+         std::jthread flusher;
+
+         /**
+          * Whether one more CPU or GPU event may be recorded, must be called with the mutex held.
+          */
+         [[nodiscard]] auto has_room() const noexcept -> bool
+         {
+            return std::size(events) + std::size(gpu_events) < config.max_recorded_events;
+         }
+      };
+
+      std::atomic<bool> is_tracing_enabled{false};
+
+      thread_local std::shared_ptr<event_ring> thread_ring;
+
+      auto get_state() -> trace_state&
+      {
+         static trace_state state;
+         return state;
+      }
+
+      auto trace_epoch() -> clock::time_point
+      {
+         static const auto epoch = clock::now();
+         return epoch;
+      }
+
+      auto current_ring() -> event_ring&
+      {
+         if (!thread_ring)
+         {
+            auto& state = get_state();
+
+            std::scoped_lock lock(state.mutex);
+            thread_ring = std::make_shared<event_ring>(state.config.events_per_thread,
+                                                       state.next_thread_id++);
+            state.rings.push_back(thread_ring);
+         }
+
+         return *thread_ring;
+      }
+
+      /**
+       * Move the content of every ring to the recorded events, must be called with the state
+       * mutex held.
+       */
+      void drain_rings(trace_state& state)
+      {
+         for (const auto& ring : state.rings)
+         {
+            ring->drain([&](const trace_event& event) {
+               if (state.has_room())
+               {
+                  state.events.push_back({.event = event, .thread_id = ring->thread_id()});
+               }
+               else
+               {
+                  ++state.dropped_event_count;
+               }
+            });
+         }
+
+         // Rings only referenced by the state belong to threads that exited and are now empty
+         std::erase_if(state.rings, [&](const std::shared_ptr<event_ring>& ring) {
+            if (ring.use_count() != 1)
+            {
+               return false;
+            }
+
+            state.dropped_event_count += ring->dropped();
+            return true;
+         });
+      }
+
+      void flush_loop(const std::stop_token& token)
+      {
+         auto& state = get_state();
+
+         std::unique_lock lock(state.mutex);
+         while (!token.stop_requested())
+         {
+            state.flush_signal.wait_for(lock, token, state.config.flush_interval, [] {
+               return false;
+            });
+
+            drain_rings(state);
+         }
+      }
+
+      void write_json_string(std::ostream& output, std::string_view str)
+      {
+         output << '"';
+         for (const char c : str)
+         {
+            if (c == '"' || c == '\\')
+            {
+               output << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+               output << ' ';
+            }
+            else
+            {
+               output << c;
+            }
+         }
+         output << '"';
+      }
+
+      void write_complete_event(std::ostream& output, std::string_view name,
+                                std::string_view category, u64 begin, u64 end, u32 process_id,
+                                u32 thread_id)
+      {
+         const auto to_microseconds = [](u64 ns) {
+            return static_cast<double>(ns) / 1000.0;
+         };
+
+         output << R"({"name":)";
+         write_json_string(output, name);
+         output << R"(,"cat":)";
+         write_json_string(output, category);
+         output << R"(,"ph":"X","ts":)" << to_microseconds(begin)
+                << R"(,"dur":)" << to_microseconds(end >= begin ? end - begin : 0)
+                << R"(,"pid":)" << process_id << R"(,"tid":)" << thread_id << '}';
+      }
+
+      void write_metadata_event(std::ostream& output, std::string_view type, std::string_view name,
+                                u32 process_id, u32 thread_id)
+      {
+         output << R"({"name":)";
+         write_json_string(output, type);
+         output << R"(,"ph":"M","pid":)" << process_id << R"(,"tid":)" << thread_id
+                << R"(,"args":{"name":)";
+         write_json_string(output, name);
+         output << "}}";
+      }
+   } // namespace
+
+   auto make_error_condition(trace_error e) -> std::error_condition
+   {
+      return std::error_condition({static_cast<int>(e), trace_error_cat});
+   }
+
+   void start_tracing(const tracing_config& config)
+   {
+      auto& state = get_state();
+
+      {
+         std::scoped_lock lock(state.mutex);
+         if (state.flusher.joinable())
+         {
+            return;
+         }
+
+         state.config = config;
+         state.flusher = std::jthread(flush_loop);
+      }
+
+      trace_epoch();
+      is_tracing_enabled.store(true, std::memory_order_release);
+   }
+
+   void stop_tracing()
+   {
+      is_tracing_enabled.store(false, std::memory_order_release);
+
+      auto& state = get_state();
+
+      std::jthread flusher;
+      {
+         std::scoped_lock lock(state.mutex);
+         flusher = std::move(state.flusher);
+      }
+
+      if (flusher.joinable())
+      {
+         flusher.request_stop();
+         flusher.join();
+      }
+
+      std::scoped_lock lock(state.mutex);
+      drain_rings(state);
+   }
+
+   auto is_tracing() noexcept -> bool { return is_tracing_enabled.load(std::memory_order_relaxed); }
+
+   auto trace_now() noexcept -> u64
+   {
+      return static_cast<u64>(
+         std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - trace_epoch())
+            .count());
+   }
+
+   void record_trace_event(const trace_event& event) noexcept
+   {
+      try
+      {
+         current_ring().push(event);
+      }
+      catch (...)
+      {
+         // The ring of the thread could not be allocated, the event is lost
+      }
+   }
+
+   void record_gpu_trace_event(std::string_view name, u64 begin, u64 end)
+   {
+      if (!is_tracing())
+      {
+         return;
+      }
+
+      auto& state = get_state();
+
+      std::scoped_lock lock(state.mutex);
+      if (state.has_room())
+      {
+         state.gpu_events.push_back({.name = std::string(name), .begin = begin, .end = end});
+      }
+      else
+      {
+         ++state.dropped_event_count;
+      }
+   }
+
+   void set_trace_thread_name(std::string_view name)
+   {
+      const u32 thread_id = current_ring().thread_id();
+
+      auto& state = get_state();
+
+      std::scoped_lock lock(state.mutex);
+      state.thread_names.insert_or_assign(thread_id, std::string(name));
+   }
+
+   auto write_chrome_trace(const std::filesystem::path& path) -> tl::expected<u64, runtime_error>
+   {
+      auto& state = get_state();
+
+      std::scoped_lock lock(state.mutex);
+      drain_rings(state);
+
+      auto output = std::ofstream(path);
+      if (!output.is_open())
+      {
+         return tl::unexpected(
+            runtime_error(make_error_condition(trace_error::e_failed_to_open_file)));
+      }
+
+      u64 dropped_event_count = state.dropped_event_count;
+      for (const auto& ring : state.rings)
+      {
+         dropped_event_count += ring->dropped();
+      }
+
+      output << std::fixed << std::setprecision(3);
+      output << R"({"displayTimeUnit":"ms","otherData":{"dropped_events":)" << dropped_event_count
+             << R"(},"traceEvents":[)";
+
+      bool is_first = true;
+      const auto separate = [&] {
+         output << (is_first ? "\n" : ",\n");
+         is_first = false;
+      };
+
+      separate();
+      write_metadata_event(output, "process_name", "CPU", cpu_process_id, 0);
+      separate();
+      write_metadata_event(output, "process_name", "GPU", gpu_process_id, 0);
+
+      for (const auto& [thread_id, name] : state.thread_names)
+      {
+         separate();
+         write_metadata_event(output, "thread_name", name, cpu_process_id, thread_id);
+      }
+
+      for (const auto& [event, thread_id] : state.events)
+      {
+         separate();
+         write_complete_event(output, event.name, event.category, event.begin, event.end,
+                              cpu_process_id, thread_id);
+      }
+
+      for (const auto& event : state.gpu_events)
+      {
+         separate();
+         write_complete_event(output, event.name, "gpu", event.begin, event.end, gpu_process_id,
+                              0);
+      }
+
+      output << "\n]}\n";
+
+      return std::size(state.events) + std::size(state.gpu_events);
+   }
+} // namespace mannele
@@ -0,0 +1,152 @@
+/**
+ * @file libmannele/tracing/trace.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date Monday, 22nd of September 2021
+ * @brief
+ * @copyright Copyright (C) 2021 wmbat.
+ */
+
+#ifndef LIBMANNELE_TRACING_TRACE_HPP_
+#define LIBMANNELE_TRACING_TRACE_HPP_
+
+#include <libmannele/core/types.hpp>
+#include <libmannele/error/runtime_error.hpp>
+
+#include <tl/expected.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+namespace mannele
+{
+   enum class trace_error
+   {
+      e_failed_to_open_file
+   };
+
+   auto make_error_condition(trace_error e) -> std::error_condition;
+
+   struct tracing_config
+   {
+      std::chrono::milliseconds flush_interval{10}; ///< Time between two drains of the buffers
+
+      /**
+       * @brief Capacity of the ring buffer of each thread, rounded up to a power of two. Events
+       * recorded while the buffer is full are dropped and counted.
+       */
+      u32 events_per_thread{16384};
+
+      /**
+       * @brief Number of CPU and GPU events kept in memory until written, further events are
+       * dropped and counted.
+       */
+      u64 max_recorded_events{4'000'000};
+   };
+
+   /**
+    * @brief A completed zone. Names and categories must outlive the tracing session, string
+    * literals are expected.
+    */
+   struct trace_event
+   {
+      const char* name{nullptr};
+      const char* category{nullptr};
+
+      u64 begin{}; ///< Nanoseconds since the trace epoch
+      u64 end{};   ///< Nanoseconds since the trace epoch
+   };
+
+   /**
+    * @brief Start recording events. Each thread records into its own lock-free ring buffer which
+    * is drained by a background thread every `flush_interval`.
+    */
+   void start_tracing(const tracing_config& config = {});
+   /**
+    * @brief Stop recording events and drain whatever is left in the buffers. Recorded events are
+    * kept until written.
+    */
+   void stop_tracing();
+   auto is_tracing() noexcept -> bool;
+
+   /**
+    * @brief Monotonic time in nanoseconds since the trace epoch, which is fixed for the lifetime
+    * of the process.
+    */
+   auto trace_now() noexcept -> u64;
+
+   /**
+    * @brief Record an event in the buffer of the calling thread. Never blocks nor allocates once
+    * the thread has recorded its first event.
+    */
+   void record_trace_event(const trace_event& event) noexcept;
+   /**
+    * @brief Record an event on the GPU track. `begin` and `end` must already be translated to the
+    * trace epoch.
+    */
+   void record_gpu_trace_event(std::string_view name, u64 begin, u64 end);
+
+   /**
+    * @brief Name the track of the calling thread in exported traces.
+    */
+   void set_trace_thread_name(std::string_view name);
+
+   /**
+    * @brief Write every event recorded so far to `path` using the Chrome trace event format, which
+    * can be opened by chrome://tracing or Perfetto.
+    *
+    * @return The number of events written.
+    */
+   auto write_chrome_trace(const std::filesystem::path& path) -> tl::expected<u64, runtime_error>;
+
+   /**
+    * @brief Record the lifetime of the object as a zone of the calling thread. Does nothing when
+    * tracing is not started.
+    */
+   class trace_zone
+   {
+   public:
+      explicit trace_zone(const char* name, const char* category = "default") noexcept :
+         m_event{.name = name, .category = category}, m_is_active(is_tracing())
+      {
+         if (m_is_active)
+         {
+            m_event.begin = trace_now();
+         }
+      }
+      trace_zone(const trace_zone&) = delete;
+      trace_zone(trace_zone&&) = delete;
+      ~trace_zone()
+      {
+         if (m_is_active)
+         {
+            m_event.end = trace_now();
+            record_trace_event(m_event);
+         }
+      }
+
+      auto operator=(const trace_zone&) -> trace_zone& = delete;
+      auto operator=(trace_zone&&) -> trace_zone& = delete;
+
+   private:
+      trace_event m_event;
+      bool m_is_active;
+   };
+} // namespace mannele
+
+#define MANNELE_TRACE_CONCAT_IMPL(a, b) a##b
+#define MANNELE_TRACE_CONCAT(a, b) MANNELE_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Trace the enclosing scope under `name`, which must be a string literal.
+ */
+#define MANNELE_TRACE_ZONE(name)                                                                   \
+   const ::mannele::trace_zone MANNELE_TRACE_CONCAT(mannele_trace_zone_, __LINE__)(name)
+/**
+ * @brief Trace the enclosing scope under `name` in `category`, both must be string literals.
+ */
+#define MANNELE_TRACE_ZONE_CAT(name, category)                                                     \
+   const ::mannele::trace_zone MANNELE_TRACE_CONCAT(mannele_trace_zone_, __LINE__)(name, category)
+
+#endif // LIBMANNELE_TRACING_TRACE_HPP_
@@ -0,0 +1,181 @@
+/**
+ * @file libowl/detail/event_loop.cpp
+ * @author wmbat-dev@protonmail.com
+ * @date
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat.
+ */
+
+#include <libowl/detail/event_loop.hpp>
+
+#include <libmannele/tracing/trace.hpp>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <limits>
+#include <system_error>
+
+namespace owl::inline v0
+{
+   namespace detail
+   {
+      event_loop::event_loop() : m_wake_fd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+      {
+         if (m_wake_fd < 0)
+         {
+            throw std::system_error(errno, std::system_category(), "eventfd");
+         }
+      }
+      event_loop::~event_loop() { close(m_wake_fd); }
+
+      void event_loop::watch(i32 fd) noexcept { m_watched_fd = fd; }
+
+      void event_loop::post(callback task)
+      {
+         {
+            const std::scoped_lock lock(m_task_mutex);
+            m_posted_tasks.push_back(std::move(task));
+         }
+
+         wake();
+      }
+
+      void event_loop::wake() const noexcept
+      {
+         const u64 value = 1;
+
+         // Only fails when the counter would overflow, the loop is woken up either way
+         [[maybe_unused]] const auto written = write(m_wake_fd, &value, sizeof(value));
+      }
+
+      auto event_loop::add_timer(clock::duration delay, callback task, clock::duration period)
+         -> timer_id
+      {
+         const timer_id id = m_next_timer_id++;
+         m_timers.push_back({.id = id,
+                             .deadline = clock::now() + delay,
+                             .period = period,
+                             .task = std::move(task)});
+
+         return id;
+      }
+      void event_loop::cancel_timer(timer_id id)
+      {
+         std::erase_if(m_timers, [&](timer const& t) {
+            return t.id == id;
+         });
+      }
+
+      void event_loop::wait(bool should_block)
+      {
+         MANNELE_TRACE_ZONE_CAT("owl::event_loop::wait", "owl");
+
+         std::array fds{pollfd{.fd = m_wake_fd, .events = POLLIN, .revents = 0},
+                        pollfd{.fd = m_watched_fd, .events = POLLIN, .revents = 0}};
+
+         // A negative fd is ignored by poll
+         const i32 result = poll(std::data(fds), std::size(fds), poll_timeout(should_block));
+         if (result < 0 && errno != EINTR)
+         {
+            throw std::system_error(errno, std::system_category(), "poll");
+         }
+
+         if (result > 0 && (fds[0].revents & POLLIN))
+         {
+            drain_wake_fd();
+         }
+
+         run_expired_timers();
+         run_posted_tasks();
+      }
+
+      auto event_loop::poll_timeout(bool should_block) const -> i32
+      {
+         if (!should_block)
+         {
+            return 0;
+         }
+
+         if (std::empty(m_timers))
+         {
+            return -1;
+         }
+
+         const auto closest = std::ranges::min(m_timers, {}, &timer::deadline).deadline;
+         const auto remaining = closest - clock::now();
+         if (remaining <= clock::duration::zero())
+         {
+            return 0;
+         }
+
+         // Round up, waking before the deadline would only spin until it is reached
+         const auto milliseconds = std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+
+         return static_cast<i32>(std::min<i64>(milliseconds, std::numeric_limits<i32>::max()));
+      }
+
+      void event_loop::drain_wake_fd() const noexcept
+      {
+         u64 value = 0;
+         [[maybe_unused]] const auto read_count = read(m_wake_fd, &value, sizeof(value));
+      }
+
+      void event_loop::run_expired_timers()
+      {
+         const auto now = clock::now();
+
+         // Tasks may add or cancel timers, so collect the expired ids first
+         std::vector<timer_id> expired;
+         for (timer const& t : m_timers)
+         {
+            if (t.deadline <= now)
+            {
+               expired.push_back(t.id);
+            }
+         }
+
+         for (const timer_id id : expired)
+         {
+            const auto it = std::ranges::find(m_timers, id, &timer::id);
+            if (it == std::end(m_timers))
+            {
+               continue;
+            }
+
+            callback task = it->task;
+            if (it->period > clock::duration::zero())
+            {
+               // Skip the periods that were missed instead of running the task for each of them
+               const auto missed = (now - it->deadline) / it->period;
+               it->deadline += (missed + 1) * it->period;
+            }
+            else
+            {
+               m_timers.erase(it);
+            }
+
+            task();
+         }
+      }
+
+      void event_loop::run_posted_tasks()
+      {
+         {
+            const std::scoped_lock lock(m_task_mutex);
+            std::swap(m_posted_tasks, m_running_tasks);
+         }
+
+         for (auto& task : m_running_tasks)
+         {
+            task();
+         }
+
+         m_running_tasks.clear();
+      }
+   } // namespace detail
+} // namespace owl::inline v0
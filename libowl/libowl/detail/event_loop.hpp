@@ -0,0 +1,105 @@
+/**
+ * @file libowl/detail/event_loop.hpp
+ * @author wmbat-dev@protonmail.com
+ * @date
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat.
+ */
+
+#ifndef LIBOWL_DETAIL_EVENT_LOOP_HPP_
+#define LIBOWL_DETAIL_EVENT_LOOP_HPP_
+
+#include <libowl/types.hpp>
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace owl::inline v0
+{
+   namespace detail
+   {
+      /**
+       * @brief Blocks the GUI thread until there is something to do, instead of spinning.
+       *
+       * The loop sleeps in `poll` on the display server connection and on an eventfd used to wake
+       * it up from other threads. The poll timeout is set to the deadline of the closest timer.
+       */
+      class event_loop
+      {
+      public:
+         using clock = std::chrono::steady_clock;
+         using callback = std::function<void()>;
+         using timer_id = u64;
+
+      public:
+         event_loop();
+         event_loop(event_loop const&) = delete;
+         event_loop(event_loop&&) = delete;
+         ~event_loop();
+
+         auto operator=(event_loop const&) -> event_loop& = delete;
+         auto operator=(event_loop&&) -> event_loop& = delete;
+
+         /**
+          * @brief Set the file descriptor whose readability ends a wait, the display server
+          * connection.
+          */
+         void watch(i32 fd) noexcept;
+
+         /**
+          * @brief Run `task` on the GUI thread during the next wait. Safe to call from any thread.
+          */
+         void post(callback task);
+
+         /**
+          * @brief End the current or next wait early. Safe to call from any thread.
+          */
+         void wake() const noexcept;
+
+         /**
+          * @brief Run `task` on the GUI thread once `delay` elapsed, then every `period` if it is
+          * not zero.
+          */
+         auto add_timer(clock::duration delay, callback task,
+                        clock::duration period = clock::duration::zero()) -> timer_id;
+         void cancel_timer(timer_id id);
+
+         /**
+          * @brief Wait until the watched file descriptor is readable, the loop is woken up or a
+          * timer expires, then run the expired timers and the posted tasks. Only checks for ready
+          * work without sleeping when `should_block` is false.
+          */
+         void wait(bool should_block);
+
+      private:
+         struct timer
+         {
+            timer_id id;
+            clock::time_point deadline;
+            clock::duration period;
+            callback task;
+         };
+
+         [[nodiscard]] auto poll_timeout(bool should_block) const -> i32;
+
+         void drain_wake_fd() const noexcept;
+         void run_expired_timers();
+         void run_posted_tasks();
+
+      private:
+         i32 m_wake_fd = -1;
+         i32 m_watched_fd = -1;
+
+         timer_id m_next_timer_id = 0;
+         std::vector<timer> m_timers;
+
+         std::mutex m_task_mutex;
+         std::vector<callback> m_posted_tasks;
+         std::vector<callback> m_running_tasks;
+      };
+   } // namespace detail
+} // namespace owl::inline v0
+
+#endif // LIBOWL_DETAIL_EVENT_LOOP_HPP_
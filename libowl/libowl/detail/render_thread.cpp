@@ -0,0 +1,98 @@
+/**
+ * @file libowl/detail/render_thread.cpp
+ * @author wmbat-dev@protonmail.com
+ * @date
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat.
+ */
+
+#include <libowl/detail/render_thread.hpp>
+
+#include <libowl/window.hpp>
+
+#include <libmannele/tracing/trace.hpp>
+
+#include <chrono>
+
+namespace owl::inline v0
+{
+   namespace detail
+   {
+      render_thread::render_thread(window& wnd) :
+         m_window(wnd), m_thread([this](std::stop_token const& token) {
+            run(token);
+         })
+      {}
+      render_thread::~render_thread() { stop(); }
+
+      void render_thread::push(event_variant&& event)
+      {
+         // Input is never dropped. The queue is only full when the render thread is hundreds of
+         // events behind, the GUI thread then waits for it to catch up
+         while (!m_events.try_push(std::move(event)))
+         {
+            notify();
+            std::this_thread::yield();
+         }
+
+         notify();
+      }
+
+      void render_thread::notify() noexcept
+      {
+         m_signal.fetch_add(1, std::memory_order_release);
+         m_signal.notify_one();
+      }
+
+      void render_thread::stop()
+      {
+         if (m_thread.joinable())
+         {
+            m_thread.request_stop();
+            notify();
+            m_thread.join();
+         }
+      }
+
+      auto render_thread::is_current_thread() const noexcept -> bool
+      {
+         return m_thread.get_id() == std::this_thread::get_id();
+      }
+
+      void render_thread::run(std::stop_token const& token)
+      {
+         auto curr_time = std::chrono::steady_clock::now();
+
+         while (!token.stop_requested())
+         {
+            MANNELE_TRACE_ZONE_CAT("owl::render_thread::frame", "owl");
+
+            // Read before draining, a signal sent while rendering then skips the next wait
+            const u64 signal = m_signal.load(std::memory_order_acquire);
+
+            while (auto event = m_events.try_pop())
+            {
+               m_window.apply_event(event.value());
+            }
+
+            const bool is_dirty = m_window.take_redraw_request();
+            const bool is_animating = m_window.is_animating();
+
+            if (is_dirty || is_animating)
+            {
+               auto const new_time = std::chrono::steady_clock::now();
+               m_window.render(new_time - curr_time);
+               curr_time = new_time;
+            }
+
+            if (!is_animating)
+            {
+               m_signal.wait(signal, std::memory_order_acquire);
+
+               // The time spent idle is not part of the next animation step
+               curr_time = std::chrono::steady_clock::now();
+            }
+         }
+      }
+   } // namespace detail
+} // namespace owl::inline v0
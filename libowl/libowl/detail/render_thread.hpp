@@ -0,0 +1,78 @@
+/**
+ * @file libowl/detail/render_thread.hpp
+ * @author wmbat-dev@protonmail.com
+ * @date
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat.
+ */
+
+#ifndef LIBOWL_DETAIL_RENDER_THREAD_HPP_
+#define LIBOWL_DETAIL_RENDER_THREAD_HPP_
+
+#include <libowl/detail/spsc_queue.hpp>
+#include <libowl/gui/event/event.hpp>
+
+#include <atomic>
+#include <thread>
+
+namespace owl::inline v0
+{
+   class window;
+
+   namespace detail
+   {
+      /**
+       * @brief Thread producing the frames of a single window
+       *
+       * The GUI thread forwards the events of the window through a lock-free queue. The render
+       * thread applies them to the window then renders it when it is dirty or animating, and
+       * sleeps otherwise. A slow window therefore never delays the input of the other windows.
+       */
+      class render_thread
+      {
+      public:
+         static constexpr u64 queue_capacity = 256;
+
+      public:
+         explicit render_thread(window& wnd);
+         render_thread(render_thread const&) = delete;
+         render_thread(render_thread&&) = delete;
+         ~render_thread();
+
+         auto operator=(render_thread const&) -> render_thread& = delete;
+         auto operator=(render_thread&&) -> render_thread& = delete;
+
+         /**
+          * @brief Forward an event of the window to the render thread. GUI thread only.
+          */
+         void push(event_variant&& event);
+
+         /**
+          * @brief Wake the render thread up if it sleeps. Safe to call from any thread.
+          */
+         void notify() noexcept;
+
+         /**
+          * @brief Stop and join the render thread, the window must stay alive until this returns
+          */
+         void stop();
+
+         [[nodiscard]] auto is_current_thread() const noexcept -> bool;
+
+      private:
+         void run(std::stop_token const& token);
+
+      private:
+         window& m_window;
+
+         spsc_queue<event_variant, queue_capacity> m_events;
+
+         // Incremented on every push and notify, the render thread waits for it to change
+         std::atomic<u64> m_signal{0};
+
+         std::jthread m_thread;
+      };
+   } // namespace detail
+} // namespace owl::inline v0
+
+#endif // LIBOWL_DETAIL_RENDER_THREAD_HPP_
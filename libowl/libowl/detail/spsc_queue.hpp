@@ -0,0 +1,94 @@
+/**
+ * @file libowl/detail/spsc_queue.hpp
+ * @author wmbat-dev@protonmail.com
+ * @date
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat.
+ */
+
+#ifndef LIBOWL_DETAIL_SPSC_QUEUE_HPP_
+#define LIBOWL_DETAIL_SPSC_QUEUE_HPP_
+
+#include <libowl/types.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <optional>
+
+namespace owl::inline v0
+{
+   namespace detail
+   {
+      /**
+       * @brief Bounded lock-free queue between exactly one producer thread and one consumer thread
+       *
+       * The producer only writes the tail and the consumer only writes the head, each index lives
+       * on its own cache line so that they don't bounce between the two threads.
+       */
+      template <typename Any, u64 Capacity>
+         requires(std::has_single_bit(Capacity))
+      class spsc_queue
+      {
+         static constexpr u64 cache_line_size = 64;
+
+      public:
+         /**
+          * @brief Add a value at the back of the queue. Producer thread only.
+          *
+          * @return false if the queue is full, `value` is left untouched.
+          */
+         auto try_push(Any&& value) -> bool
+         {
+            const u64 tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_cached_head == Capacity)
+            {
+               m_cached_head = m_head.load(std::memory_order_acquire);
+               if (tail - m_cached_head == Capacity)
+               {
+                  return false;
+               }
+            }
+
+            m_values[tail & (Capacity - 1)] = std::move(value);
+            m_tail.store(tail + 1, std::memory_order_release);
+
+            return true;
+         }
+
+         /**
+          * @brief Remove the value at the front of the queue. Consumer thread only.
+          *
+          * @return Empty if the queue is empty
+          */
+         auto try_pop() -> std::optional<Any>
+         {
+            const u64 head = m_head.load(std::memory_order_relaxed);
+            if (head == m_cached_tail)
+            {
+               m_cached_tail = m_tail.load(std::memory_order_acquire);
+               if (head == m_cached_tail)
+               {
+                  return std::nullopt;
+               }
+            }
+
+            std::optional<Any> value = std::move(m_values[head & (Capacity - 1)]);
+            m_head.store(head + 1, std::memory_order_release);
+
+            return value;
+         }
+
+      private:
+         std::array<Any, Capacity> m_values{};
+
+         alignas(cache_line_size) std::atomic<u64> m_head{0};
+         u64 m_cached_tail{0}; ///< Consumer side copy of the tail, avoids reading it every pop
+
+         alignas(cache_line_size) std::atomic<u64> m_tail{0};
+         u64 m_cached_head{0}; ///< Producer side copy of the head, avoids reading it every push
+      };
+   } // namespace detail
+} // namespace owl::inline v0
+
+#endif // LIBOWL_DETAIL_SPSC_QUEUE_HPP_
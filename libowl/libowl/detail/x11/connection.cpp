@@ -1,5 +1,6 @@
 #include <libowl/detail/x11/connection.hpp>
 
+#include <xcb/randr.h>
 #include <xcb/xcb.h>
 
 namespace owl::inline v0
@@ -49,6 +50,9 @@ namespace owl::inline v0
          {
             logger.debug("connected to X server");
 
+            // Sent now, the reply is read once the other startup requests are on their way
+            xcb_prefetch_extension_data(p_connection, &xcb_randr_id);
+
             const xcb_setup_t* p_setup = xcb_get_setup(p_connection);
             const auto kbd_mapping = get_keyboard_mapping(p_connection, p_setup);
 
@@ -58,9 +62,14 @@ namespace owl::inline v0
             const auto protocol_reply = get_protocols_atom_reply(p_connection);
             const auto delete_reply = get_delete_atom_reply(p_connection);
 
+            const auto* p_randr = xcb_get_extension_data(p_connection, &xcb_randr_id);
+            const u8 randr_first_event =
+               p_randr != nullptr && p_randr->present ? p_randr->first_event : 0;
+
             return connection{
                .x_server = unique_x_connection(p_connection, xcb_disconnect),
                .protocol_prop = {.atom = protocol_reply->atom, .delete_atom = delete_reply->atom},
+               .randr_first_event = randr_first_event,
                .min_keycode = p_setup->min_keycode,
                .max_keycode = p_setup->max_keycode,
                .keysyms_per_keycode = kbd_mapping->keysyms_per_keycode,
@@ -71,5 +80,12 @@ namespace owl::inline v0
             return tl::unexpected(static_cast<server_connection_error_code>(error_code));
          }
       }
+
+      auto file_descriptor(connection const& conn) -> i32
+      {
+         return xcb_get_file_descriptor(conn.x_server.get());
+      }
+
+      void flush(connection const& conn) { xcb_flush(conn.x_server.get()); }
    } // namespace x11
 } // namespace owl::inline v0
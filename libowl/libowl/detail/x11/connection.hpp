@@ -43,6 +43,8 @@ namespace owl::inline v0
 
          protocol_property protocol_prop;
 
+         u8 randr_first_event; ///< Response type of the first RandR event, 0 without RandR
+
          u8 min_keycode;
          u8 max_keycode;
          u8 keysyms_per_keycode;
@@ -58,6 +60,16 @@ namespace owl::inline v0
        */
       auto connect_to_server(spdlog::logger& logger)
          -> tl::expected<connection, server_connection_error_code>;
+
+      /**
+       * @brief Get the file descriptor of the socket to the X server, readable when events arrive
+       */
+      auto file_descriptor(connection const& conn) -> i32;
+
+      /**
+       * @brief Send the buffered requests to the X server
+       */
+      void flush(connection const& conn);
    } // namespace x11
 } // namespace owl::inline v0
 
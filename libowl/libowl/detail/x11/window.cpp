@@ -26,9 +26,10 @@ namespace owl::inline v0
          const std::array<u32, 2> window_values = {
             screen_iter.data->black_pixel,
             XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE | XCB_EVENT_MASK_BUTTON_PRESS
-               | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_ENTER_WINDOW
-               | XCB_EVENT_MASK_LEAVE_WINDOW | XCB_EVENT_MASK_STRUCTURE_NOTIFY
-               | XCB_EVENT_MASK_FOCUS_CHANGE | XCB_EVENT_MASK_EXPOSURE};
+               | XCB_EVENT_MASK_BUTTON_RELEASE | XCB_EVENT_MASK_POINTER_MOTION
+               | XCB_EVENT_MASK_ENTER_WINDOW | XCB_EVENT_MASK_LEAVE_WINDOW
+               | XCB_EVENT_MASK_STRUCTURE_NOTIFY | XCB_EVENT_MASK_FOCUS_CHANGE
+               | XCB_EVENT_MASK_EXPOSURE};
 
          xcb_create_window(mp_connection, XCB_COPY_FROM_PARENT, m_window_handle,
                            screen_iter.data->root, super::monitor().dimensions.x,
@@ -62,7 +63,12 @@ namespace owl::inline v0
                                                                 .setWindow(m_window_handle)),
                           super::monitor().dimensions, super::logger()));
       }
-      window::~window() { xcb_destroy_window(mp_connection, m_window_handle); }
+      window::~window()
+      {
+         super::stop_render_thread();
+
+         xcb_destroy_window(mp_connection, m_window_handle);
+      }
 
       void window::render(std::chrono::nanoseconds delta_time)
       {
@@ -2,6 +2,8 @@
 #include <libowl/gfx/device.hpp>
 #include <libowl/runtime_error.hpp>
 
+#include <algorithm>
+
 namespace owl::inline v0
 {
    namespace gfx
@@ -24,6 +26,20 @@ namespace owl::inline v0
       {
          return *mp_physical;
       }
+
+      [[nodiscard]] auto device::can_present_to(vk::SurfaceKHR surface) const -> bool
+      {
+         vk::PhysicalDevice const physical_device = *mp_physical;
+
+         return std::ranges::any_of(m_logical.queues(), [&](ash::queue const& queue) {
+            return physical_device.getSurfaceSupportKHR(queue.family_index, surface) == VK_TRUE;
+         });
+      }
+
+      [[nodiscard]] auto device::lock_queues() const -> std::unique_lock<std::mutex>
+      {
+         return std::unique_lock(m_queue_mutex);
+      }
    } // namespace gfx
 } // namespace owl::inline v0
 
@@ -12,10 +12,16 @@
 #include <libash/device.hpp>
 #include <libash/physical_device.hpp>
 
+#include <memory>
+#include <mutex>
+
 namespace owl::inline v0
 {
    namespace gfx
    {
+      /**
+       * @brief Logical device shared by every window rendering on the same physical device
+       */
       class device
       {
       public:
@@ -26,12 +32,25 @@ namespace owl::inline v0
          [[nodiscard]] auto logical() const noexcept -> ash::device const&;
          [[nodiscard]] auto physical() const noexcept -> ash::physical_device const&;
 
-         friend auto operator==(device const& lhs, device const& rhs) noexcept -> bool = default;
+         /**
+          * @brief Check if one of the device's queues can present to `surface`
+          */
+         [[nodiscard]] auto can_present_to(vk::SurfaceKHR surface) const -> bool;
+
+         /**
+          * @brief Lock the device's queues. Windows sharing the device may render on different
+          * threads, queue submissions and presentations must hold the lock.
+          */
+         [[nodiscard]] auto lock_queues() const -> std::unique_lock<std::mutex>;
 
       private:
          ash::physical_device const* mp_physical;
          ash::device m_logical;
+
+         mutable std::mutex m_queue_mutex;
       };
+
+      using shared_device = std::shared_ptr<device>;
    } // namespace gfx
 } // namespace owl::inline v0
 
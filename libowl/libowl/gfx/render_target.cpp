@@ -11,6 +11,8 @@
 #include <libowl/runtime_error.hpp>
 #include <libowl/types.hpp>
 
+#include <libmannele/tracing/trace.hpp>
+
 #include <magic_enum.hpp>
 
 #include <ranges>
@@ -90,7 +92,7 @@ namespace owl::inline v0
       return m_surface.get();
    }
 
-   void render_target::set_device(gfx::device&& device)
+   void render_target::set_device(gfx::shared_device device)
    {
       if (m_device != device)
       {
@@ -98,7 +100,8 @@ namespace owl::inline v0
          {
             m_status = target_status::device_lost;
 
-            // destroy stuff
+            // The swapchain belongs to the previous device, which may be released below
+            m_swapchain.reset();
          }
 
          m_device = std::move(device);
@@ -113,8 +116,10 @@ namespace owl::inline v0
 
    auto render_target::create_swapchain() -> vk::UniqueSwapchainKHR
    {
+      MANNELE_TRACE_ZONE_CAT("owl::render_target::create_swapchain", "owl");
+
       // NOLINTNEXTLINE
-      assert(m_device.has_value());
+      assert(m_device != nullptr);
 
       vk::PhysicalDevice physical_device = m_device->physical();
       vk::Device device = m_device->logical();
@@ -46,7 +46,11 @@ namespace owl::inline v0
 
       [[nodiscard]] auto surface() const noexcept -> vk::SurfaceKHR;
 
-      void set_device(gfx::device&& device);
+      /**
+       * @brief Render to the target with `device`, shared with the other windows on the same
+       * physical device. Only the swapchain is created for the target.
+       */
+      void set_device(gfx::shared_device device);
       void update_dimensions(monitor_dimensions const& dimensions);
 
    private:
@@ -57,7 +61,8 @@ namespace owl::inline v0
 
       monitor_dimensions m_dimensions{};
 
-      std::optional<gfx::device> m_device;
+      // Before the surface and swapchain, which must be destroyed while the device is alive
+      gfx::shared_device m_device;
 
       vk::UniqueSurfaceKHR m_surface;
       vk::UniqueSwapchainKHR m_swapchain;
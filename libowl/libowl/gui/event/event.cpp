@@ -14,6 +14,7 @@
 #   include <libowl/detail/x11/keycode.hpp>
 #   include <libowl/detail/x11/keysym.hpp>
 
+#   include <xcb/randr.h>
 #   include <xcb/xcb.h>
 #endif // defined(LIBOWL_USE_X11)
 
@@ -59,7 +60,10 @@ namespace owl::inline v0
          auto const keysym = x11::keysym_t(conn, keycode, modifiers);
          [[maybe_unused]] auto const ucs_value = x11::to_code_point(keysym);
 
-         return {.type = type, .mods = modifiers, .time = std::chrono::milliseconds(event.time)};
+         return {.type = type,
+                 .mods = modifiers,
+                 .time = std::chrono::milliseconds(event.time),
+                 .window_id = event.event};
       }
 
       auto handle_configure_notify_event(xcb_configure_notify_event_t const& event)
@@ -70,20 +74,49 @@ namespace owl::inline v0
             .window_id = event.window};
       }
 
+      auto handle_randr_notify_event(xcb_randr_notify_event_t const& event) -> event_variant
+      {
+         if (event.subCode == XCB_RANDR_NOTIFY_CRTC_CHANGE)
+         {
+            auto const& change = event.u.cc;
+
+            return crtc_changed_event{
+               .crtc = change.crtc,
+               .is_enabled = change.mode != XCB_NONE,
+               .dimensions = {
+                  .x = change.x, .y = change.y, .width = change.width, .height = change.height}};
+         }
+
+         if (event.subCode == XCB_RANDR_NOTIFY_OUTPUT_CHANGE)
+         {
+            auto const& change = event.u.oc;
+
+            return output_changed_event{
+               .output = change.output,
+               .crtc = change.crtc,
+               .is_connected = change.connection == XCB_RANDR_CONNECTION_CONNECTED};
+         }
+
+         return command::ignore;
+      }
+
       template <typename T>
       auto to_event_type(unique_event const& event) -> T const&
       {
          return *reinterpret_cast<T const*>(event.get()); // NOLINT
       }
 
-   } // namespace
-
-   auto poll_for_event(x11::connection const& conn) -> std::optional<event_variant>
-   {
-      if (auto const event = unique_event(xcb_poll_for_event(conn.x_server.get()), free))
+      auto to_event_variant(x11::connection const& conn, unique_event const& event)
+         -> event_variant
       {
          auto const event_type = event->response_type & ~0x80;
 
+         // RandR events are numbered after the core ones, from where the server placed them
+         if (conn.randr_first_event != 0 && event_type == conn.randr_first_event + XCB_RANDR_NOTIFY)
+         {
+            return handle_randr_notify_event(to_event_type<xcb_randr_notify_event_t>(event));
+         }
+
          if (event_type == XCB_KEY_PRESS)
          {
             auto const& key_press_event = to_event_type<xcb_key_press_event_t>(event);
@@ -100,7 +133,12 @@ namespace owl::inline v0
          }
          else if (event_type == XCB_MOTION_NOTIFY)
          {
-            return event_variant(command::ignore);
+            auto const& motion = to_event_type<xcb_motion_notify_event_t>(event);
+
+            return event_variant(
+               mouse_movement_event{.position = {.x = motion.event_x, .y = motion.event_y},
+                                    .time = std::chrono::milliseconds(motion.time),
+                                    .window_id = motion.event});
          }
          else if (event_type == XCB_ENTER_NOTIFY)
          {
@@ -126,7 +164,9 @@ namespace owl::inline v0
          }
          else if (event_type == XCB_EXPOSE)
          {
-            return event_variant(command::render_window);
+            auto const& expose = to_event_type<xcb_expose_event_t>(event);
+
+            return event_variant(expose_event{.window_id = expose.window});
          }
          else if (event_type == XCB_CONFIGURE_NOTIFY)
          {
@@ -156,10 +196,26 @@ namespace owl::inline v0
             return event_variant(command::ignore);
          }
       }
-      else
+   } // namespace
+
+   auto poll_for_event(x11::connection const& conn) -> std::optional<event_variant>
+   {
+      if (auto const event = unique_event(xcb_poll_for_event(conn.x_server.get()), free))
+      {
+         return to_event_variant(conn, event);
+      }
+
+      return std::nullopt;
+   }
+
+   auto poll_for_queued_event(x11::connection const& conn) -> std::optional<event_variant>
+   {
+      if (auto const event = unique_event(xcb_poll_for_queued_event(conn.x_server.get()), free))
       {
-         return std::nullopt;
+         return to_event_variant(conn, event);
       }
+
+      return std::nullopt;
    }
 #endif // defined(LIBOWL_USE_X11)
 } // namespace owl::inline v0
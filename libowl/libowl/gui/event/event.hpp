@@ -16,8 +16,10 @@
 #endif // defined (LIBOWL_USE_X11)
 
 #include <libowl/gui/event/command.hpp>
+#include <libowl/gui/event/expose_event.hpp>
 #include <libowl/gui/event/focus_event.hpp>
 #include <libowl/gui/event/keyboard_event.hpp>
+#include <libowl/gui/event/monitor_event.hpp>
 #include <libowl/gui/event/mouse_event.hpp>
 #include <libowl/gui/event/structure_changed_event.hpp>
 
@@ -29,8 +31,9 @@ namespace owl::inline v0
    /**
     * @brief type alias for a union over all supported event types
     */
-   using event_variant = std::variant<key_event, mouse_button_event, mouse_movement_event,
-                                      structure_changed_event, focus_event, command>;
+   using event_variant =
+      std::variant<key_event, mouse_button_event, mouse_movement_event, structure_changed_event,
+                   focus_event, expose_event, crtc_changed_event, output_changed_event, command>;
 
 #if defined(LIBOWL_USE_X11)
    /**
@@ -41,6 +44,19 @@ namespace owl::inline v0
     * @return the maybe will be empty if there is no event
     */
    auto poll_for_event(x11::connection const& conn) -> std::optional<event_variant>;
+
+   /**
+    * @brief Check if there are events already read from the X server but not handled yet, without
+    * reading from the connection
+    *
+    * Replies read by other requests may pull events into the queue of the connection, these don't
+    * make its file descriptor readable anymore.
+    *
+    * @param[in] conn The connection to the X server
+    *
+    * @return the maybe will be empty if there is no queued event
+    */
+   auto poll_for_queued_event(x11::connection const& conn) -> std::optional<event_variant>;
 #endif // defined (LIBOWL_USE_X11)
 } // namespace owl::inline v0
 
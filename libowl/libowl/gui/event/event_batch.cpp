@@ -0,0 +1,109 @@
+/**
+ * @file libowl/gui/event/event_batch.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#include <libowl/gui/event/event_batch.hpp>
+
+#include <libowl/detail/visit_helper.hpp>
+
+#include <algorithm>
+
+namespace owl::inline v0
+{
+   namespace
+   {
+      /**
+       * @brief Add `event` to the batch, dropping the earlier events it makes obsolete
+       */
+      void append_coalesced(std::vector<event_variant>& events, event_variant const& event)
+      {
+         if (std::holds_alternative<mouse_movement_event>(event))
+         {
+            // Only the last position of an uninterrupted movement matters
+            if (!std::empty(events) && std::holds_alternative<mouse_movement_event>(events.back()))
+            {
+               events.back() = event;
+
+               return;
+            }
+         }
+         else if (std::holds_alternative<structure_changed_event>(event)
+                  || std::holds_alternative<expose_event>(event))
+         {
+            // Keep the final geometry, and a single redraw, at the position of the last one
+            std::erase_if(events, [&](event_variant const& e) {
+               return e.index() == event.index();
+            });
+         }
+
+         events.push_back(event);
+      }
+   } // namespace
+
+   void event_batches::clear() noexcept
+   {
+      system_events.clear();
+
+      // Only the windows that were active recently keep their slot
+      std::erase_if(windows, [](window_event_batch const& batch) {
+         return std::empty(batch.events);
+      });
+
+      for (auto& batch : windows)
+      {
+         batch.events.clear();
+      }
+   }
+
+   auto target_window(event_variant const& event) -> std::optional<u32>
+   {
+      using detail::overloaded;
+
+      // clang-format off
+      return std::visit(
+         overloaded{
+            [](key_event const& e) -> std::optional<u32> { return e.window_id; },
+            [](mouse_movement_event const& e) -> std::optional<u32> { return e.window_id; },
+            [](structure_changed_event const& e) -> std::optional<u32> { return e.window_id; },
+            [](expose_event const& e) -> std::optional<u32> { return e.window_id; },
+            [](auto const&) -> std::optional<u32> { return std::nullopt; } },
+         event);
+      // clang-format on
+   }
+
+   void sort_into_batches(std::span<event_variant const> events, event_batches& batches)
+   {
+      batches.clear();
+
+      for (event_variant const& event : events)
+      {
+         auto const window_id = target_window(event);
+         if (!window_id)
+         {
+            batches.system_events.push_back(event);
+
+            continue;
+         }
+
+         // Windows keep their slot between iterations, reusing the memory of their events
+         auto it =
+            std::ranges::find(batches.windows, window_id.value(), &window_event_batch::window_id);
+         if (it == std::end(batches.windows))
+         {
+            batches.windows.push_back({.window_id = window_id.value(), .events = {}});
+            it = std::prev(std::end(batches.windows));
+         }
+
+         append_coalesced(it->events, event);
+      }
+
+      // Windows without events this iteration are moved to the back and skipped
+      std::ranges::stable_partition(batches.windows, [](window_event_batch const& batch) {
+         return !std::empty(batch.events);
+      });
+   }
+} // namespace owl::inline v0
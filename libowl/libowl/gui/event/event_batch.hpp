@@ -0,0 +1,66 @@
+/**
+ * @file libowl/gui/event/event_batch.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief Sorting of the events read in one iteration of the main loop
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#ifndef LIBOWL_GUI_EVENT_EVENT_BATCH_HPP_
+#define LIBOWL_GUI_EVENT_EVENT_BATCH_HPP_
+
+#include <libowl/gui/event/event.hpp>
+
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace owl::inline v0
+{
+   /**
+    * @brief The events targeting a single window, in the order they arrived
+    */
+   struct window_event_batch
+   {
+      u32 window_id;                     ///< The window targeted by the events
+      std::vector<event_variant> events; ///< The coalesced events of the window
+   };
+
+   /**
+    * @brief The events read in one iteration of the main loop, sorted by their target
+    */
+   struct event_batches
+   {
+      std::vector<event_variant> system_events; ///< Events handled by the system, in order
+
+      /**
+       * One batch per window. Batches without events are left at the back, their memory is reused
+       * if the window gets events in the next iteration.
+       */
+      std::vector<window_event_batch> windows;
+
+      /**
+       * @brief Empty the batches, keeping their memory for the next iteration
+       */
+      void clear() noexcept;
+   };
+
+   /**
+    * @brief Get the id of the window an event is for, if it is not for the system itself
+    */
+   auto target_window(event_variant const& event) -> std::optional<u32>;
+
+   /**
+    * @brief Sort `events` into one batch per window and coalesce them
+    *
+    * Within a window's batch, a mouse movement replaces a mouse movement right before it and only
+    * the last structure change and expose event are kept, so that drags and resizes only cost one
+    * event per iteration of the main loop.
+    *
+    * @param[in] events The events in the order they were read
+    * @param[out] batches The sorted events
+    */
+   void sort_into_batches(std::span<event_variant const> events, event_batches& batches);
+} // namespace owl::inline v0
+
+#endif // LIBOWL_GUI_EVENT_EVENT_BATCH_HPP_
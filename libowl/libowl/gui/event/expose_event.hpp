@@ -0,0 +1,26 @@
+/**
+ * @file libowl/gui/event/expose_event.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#ifndef LIBOWL_GUI_EVENT_EXPOSE_EVENT_HPP_
+#define LIBOWL_GUI_EVENT_EXPOSE_EVENT_HPP_
+
+#include <libowl/types.hpp>
+
+namespace owl::inline v0
+{
+   /**
+    * @brief Event to let the system know that the content of a window was lost and must be
+    * rendered again
+    */
+   struct expose_event
+   {
+      u32 window_id; ///< The window to render again
+   };
+} // namespace owl::inline v0
+
+#endif // LIBOWL_GUI_EVENT_EXPOSE_EVENT_HPP_
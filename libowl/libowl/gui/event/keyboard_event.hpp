@@ -10,6 +10,7 @@
 #define LIBOWL_GUI_KEYBOARD_EVENT_HPP_
 
 #include <libowl/gui/keyboard_modifiers.hpp>
+#include <libowl/types.hpp>
 
 // C++ Standard Library includes
 
@@ -34,6 +35,7 @@ namespace owl::inline v0
       key_event_type type;            ///< The type of key event
       key_modifier_flags mods;        ///< The key modifiers of the event
       std::chrono::milliseconds time; ///< The time in when the key was pressed
+      u32 window_id;                  ///< The window in focus when the key was pressed
    };
 } // namespace owl::inline v0
 
@@ -0,0 +1,38 @@
+/**
+ * @file libowl/gui/event/monitor_event.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief Holds the events sent when the monitor configuration changes
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#ifndef LIBOWL_GUI_EVENT_MONITOR_EVENT_HPP_
+#define LIBOWL_GUI_EVENT_MONITOR_EVENT_HPP_
+
+#include <libowl/gui/monitor.hpp>
+#include <libowl/types.hpp>
+
+namespace owl::inline v0
+{
+   /**
+    * @brief Event sent when the area of the screen a CRTC scans out changes
+    */
+   struct crtc_changed_event
+   {
+      u32 crtc;                      ///< The CRTC that changed
+      bool is_enabled;               ///< Whether the CRTC still displays anything
+      monitor_dimensions dimensions; ///< The new area of the CRTC in pixels
+   };
+
+   /**
+    * @brief Event sent when an output is plugged, unplugged or moved to another CRTC
+    */
+   struct output_changed_event
+   {
+      u32 output;        ///< The output that changed
+      u32 crtc;          ///< The CRTC driving the output, 0 if none
+      bool is_connected; ///< Whether a monitor is plugged into the output
+   };
+} // namespace owl::inline v0
+
+#endif // LIBOWL_GUI_EVENT_MONITOR_EVENT_HPP_
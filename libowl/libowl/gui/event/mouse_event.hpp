@@ -9,14 +9,28 @@
 #ifndef LIBOWL_GUI_MOUSE_EVENT_HPP_
 #define LIBOWL_GUI_MOUSE_EVENT_HPP_
 
+#include <libowl/types.hpp>
+
+#include <libmannele/position.hpp>
+
+// C++ Standard Library includes
+
+#include <chrono>
+
 namespace owl::inline v0
 {
    class mouse_button_event
    {
    };
 
-   class mouse_movement_event
+   /**
+    * @brief Event sent when the mouse pointer moves inside a window
+    */
+   struct mouse_movement_event
    {
+      mannele::position_i16 position; ///< The position of the pointer relative to the window
+      std::chrono::milliseconds time; ///< The time at which the pointer moved
+      u32 window_id;                  ///< The window the pointer moved in
    };
 } // namespace owl::inline v0
 
@@ -8,14 +8,13 @@
 
 #include <libowl/gui/monitor.hpp>
 
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/remove.hpp>
-#include <range/v3/view/transform.hpp>
+#include <libowl/gui/event/monitor_event.hpp>
 
 #include <xcb/randr.h>
 #include <xcb/xcb.h>
 
-namespace rv = ranges::views;
+#include <algorithm>
+#include <span>
 
 namespace owl::inline v0
 {
@@ -25,21 +24,38 @@ namespace owl::inline v0
    {
       template <typename Type>
       using xcb_handle = std::unique_ptr<Type, void (*)(void*)>;
-      using screen_resources_reply = xcb_handle<xcb_randr_get_screen_resources_reply_t>;
+      using screen_resources_reply = xcb_handle<xcb_randr_get_screen_resources_current_reply_t>;
       using crtc_info_reply = xcb_handle<xcb_randr_get_crtc_info_reply_t>;
       using output_info_reply = xcb_handle<xcb_randr_get_output_info_reply_t>;
 
-      struct output_info
+      /**
+       * @brief An output with a monitor plugged in that is shown by a CRTC
+       */
+      struct output_state
       {
-         std::string name;
-         crtc_info_reply crtc;
+         xcb_randr_output_t output;
+         xcb_randr_crtc_t crtc;
+         monitor value;
       };
 
-      auto request_resources(x11::unique_x_connection const& connection, xcb_window_t window)
+      auto find_root_window(xcb_connection_t* p_connection) -> xcb_window_t
+      {
+         xcb_setup_t const* const p_setup = xcb_get_setup(p_connection);
+
+         return xcb_setup_roots_iterator(p_setup).data->root;
+      }
+
+      /**
+       * @brief Get the screen resources as the server last saw them. Unlike
+       * xcb_randr_get_screen_resources, it doesn't make the server probe the outputs for changes,
+       * which can take a long time.
+       */
+      auto request_resources(xcb_connection_t* p_connection, xcb_window_t window)
          -> screen_resources_reply
       {
-         auto const cookie = xcb_randr_get_screen_resources(connection.get(), window);
-         auto* p_reply = xcb_randr_get_screen_resources_reply(connection.get(), cookie, nullptr);
+         auto const cookie = xcb_randr_get_screen_resources_current(p_connection, window);
+         auto* p_reply =
+            xcb_randr_get_screen_resources_current_reply(p_connection, cookie, nullptr);
 
          return {p_reply, free};
       }
@@ -47,19 +63,11 @@ namespace owl::inline v0
       auto list_resource_outputs(screen_resources_reply const& reply)
          -> std::span<xcb_randr_output_t const>
       {
-         i32 const count = xcb_randr_get_screen_resources_outputs_length(reply.get());
-         auto const* p_outputs = xcb_randr_get_screen_resources_outputs(reply.get());
+         i32 const count = xcb_randr_get_screen_resources_current_outputs_length(reply.get());
+         auto const* p_outputs = xcb_randr_get_screen_resources_current_outputs(reply.get());
 
          return {p_outputs, static_cast<u64>(count)};
       }
-      auto query_resources_output(xcb_connection_t* p_connection, xcb_randr_output_t output)
-         -> output_info_reply
-      {
-         auto const cookie = xcb_randr_get_output_info_unchecked(p_connection, output, 0);
-         auto* p_reply = xcb_randr_get_output_info_reply(p_connection, cookie, nullptr);
-
-         return {p_reply, free};
-      }
 
       auto find_resources_output_info_name(xcb_randr_get_output_info_reply_t* info)
          -> std::string_view
@@ -71,62 +79,188 @@ namespace owl::inline v0
          return std::string_view(reinterpret_cast<char const*>(p_name),
                                  static_cast<std::size_t>(count));
       }
-      auto query_resources_output_crtc(xcb_connection_t* p_connection,
-                                       xcb_randr_get_output_info_reply_t* info) -> crtc_info_reply
+
+      /**
+       * @brief Query the outputs that show a monitor. Every output request is sent before the
+       * first reply is read, then every CRTC request, for two round trips in total.
+       */
+      auto query_outputs(xcb_connection_t* p_connection,
+                         std::span<xcb_randr_output_t const> outputs,
+                         xcb_timestamp_t config_timestamp) -> std::vector<output_state>
+      {
+         std::vector<xcb_randr_get_output_info_cookie_t> output_cookies;
+         output_cookies.reserve(std::size(outputs));
+         for (xcb_randr_output_t const output : outputs)
+         {
+            output_cookies.push_back(
+               xcb_randr_get_output_info_unchecked(p_connection, output, config_timestamp));
+         }
+
+         std::vector<output_info_reply> infos;
+         infos.reserve(std::size(outputs));
+         for (auto const& cookie : output_cookies)
+         {
+            infos.emplace_back(xcb_randr_get_output_info_reply(p_connection, cookie, nullptr),
+                               free);
+         }
+
+         // Outputs without a CRTC don't show anything, their CRTC isn't requested
+         auto const has_crtc = [](output_info_reply const& info) {
+            return info != nullptr && info->crtc != XCB_NONE;
+         };
+
+         std::vector<xcb_randr_get_crtc_info_cookie_t> crtc_cookies(std::size(infos));
+         for (u64 i = 0; i < std::size(infos); ++i)
+         {
+            if (has_crtc(infos[i]))
+            {
+               crtc_cookies[i] = xcb_randr_get_crtc_info_unchecked(p_connection, infos[i]->crtc,
+                                                                   config_timestamp);
+            }
+         }
+
+         std::vector<output_state> states;
+         states.reserve(std::size(infos));
+         for (u64 i = 0; i < std::size(infos); ++i)
+         {
+            if (!has_crtc(infos[i]))
+            {
+               continue;
+            }
+
+            auto const crtc = crtc_info_reply(
+               xcb_randr_get_crtc_info_reply(p_connection, crtc_cookies[i], nullptr), free);
+            if (!crtc)
+            {
+               continue;
+            }
+
+            states.push_back(
+               {.output = outputs[i],
+                .crtc = infos[i]->crtc,
+                .value = {.name = std::string(find_resources_output_info_name(infos[i].get())),
+                          .dimensions = {.x = crtc->x,
+                                         .y = crtc->y,
+                                         .width = crtc->width,
+                                         .height = crtc->height}}});
+         }
+
+         return states;
+      }
+
+      auto query_all_outputs(xcb_connection_t* p_connection) -> std::vector<output_state>
       {
-         auto cookie = xcb_randr_get_crtc_info_unchecked(p_connection, info->crtc, 0);
-         auto* p_crtc = xcb_randr_get_crtc_info_reply(p_connection, cookie, nullptr);
+         if (auto const resources = request_resources(p_connection, find_root_window(p_connection)))
+         {
+            return query_outputs(p_connection, list_resource_outputs(resources),
+                                 resources->config_timestamp);
+         }
 
-         return {p_crtc, free};
+         return {};
       }
+   } // namespace
 
-      auto gather_output_info(xcb_connection_t* p_connection, output_info_reply&& info)
-         -> output_info
+   monitor_registry::monitor_registry(x11::connection const& conn) : mp_connection(&conn)
+   {
+      if (conn.randr_first_event == 0)
       {
-         return {.name = std::string(find_resources_output_info_name(info.get())),
-                 .crtc = query_resources_output_crtc(p_connection, info.get())};
+         return;
       }
 
-      auto has_monitor(output_info const& info) -> bool { return info.crtc == nullptr; }
+      xcb_connection_t* p_connection = conn.x_server.get();
+
+      // The server only sends the RandR 1.2 notifications to clients that announced supporting
+      // them. The reply is read after the monitors are listed, it costs no extra round trip
+      auto const version_cookie = xcb_randr_query_version(p_connection, XCB_RANDR_MAJOR_VERSION,
+                                                          XCB_RANDR_MINOR_VERSION);
+      xcb_randr_select_input(p_connection, find_root_window(p_connection),
+                             XCB_RANDR_NOTIFY_MASK_CRTC_CHANGE
+                                | XCB_RANDR_NOTIFY_MASK_OUTPUT_CHANGE);
 
-      auto to_monitor(output_info&& info) -> monitor
+      for (auto& state : query_all_outputs(p_connection))
       {
-         return {.name = std::move(info.name),
-                 .dimensions = {.x = info.crtc->x,
-                                .y = info.crtc->y,
-                                .width = info.crtc->width,
-                                .height = info.crtc->height}};
+         m_entries.push_back({.output = state.output,
+                              .crtc = state.crtc,
+                              .is_active = true,
+                              .value = std::make_unique<monitor>(std::move(state.value))});
       }
 
-   } // namespace
+      free(xcb_randr_query_version_reply(p_connection, version_cookie, nullptr)); // NOLINT
+   }
 
-   auto list_available_monitors(const x11::connection& conn) -> std::vector<monitor>
+   auto monitor_registry::active_monitors() const -> std::vector<monitor*>
    {
-      xcb_setup_t const* const p_setup = xcb_get_setup(conn.x_server.get());
-      xcb_screen_iterator_t screen_iter = xcb_setup_roots_iterator(p_setup);
-      xcb_window_t root_win = screen_iter.data->root;
+      std::vector<monitor*> monitors;
+      for (auto const& entry : m_entries)
+      {
+         if (entry.is_active)
+         {
+            monitors.push_back(entry.value.get());
+         }
+      }
 
-      if (auto const resources = request_resources(conn.x_server, root_win))
+      return monitors;
+   }
+
+   void monitor_registry::update(crtc_changed_event const& event)
+   {
+      for (auto& entry : m_entries)
       {
-         auto const l_query_resources_output = [&](xcb_randr_output_t output) {
-            return query_resources_output(conn.x_server.get(), output);
-         };
+         if (entry.crtc == event.crtc)
+         {
+            entry.is_active = event.is_enabled;
+            if (event.is_enabled)
+            {
+               entry.value->dimensions = event.dimensions;
+            }
+         }
+      }
+   }
 
-         auto const l_gather_output_info = [&](output_info_reply&& ptr) {
-            return gather_output_info(conn.x_server.get(), std::move(ptr));
-         };
+   void monitor_registry::update(output_changed_event const& event)
+   {
+      auto const it = std::ranges::find(m_entries, event.output, &entry::output);
+
+      if (not event.is_connected || event.crtc == XCB_NONE)
+      {
+         if (it != std::end(m_entries))
+         {
+            it->crtc = event.crtc;
+            it->is_active = false;
+         }
+
+         return;
+      }
+
+      // The geometry of a known CRTC is kept current by the CRTC notifications
+      if (it != std::end(m_entries) && it->crtc == event.crtc)
+      {
+         it->is_active = true;
+
+         return;
+      }
 
-         // clang-format off
-         return list_resource_outputs(resources) 
-            | rv::transform(l_query_resources_output)
-            | rv::transform(l_gather_output_info) 
-            | rv::remove_if(has_monitor)
-            | rv::transform(to_monitor) 
-            | ranges::to<std::vector>;
-         // clang-format on
+      auto states = query_outputs(mp_connection->x_server.get(), std::span(&event.output, 1),
+                                  XCB_CURRENT_TIME);
+      if (std::empty(states))
+      {
+         return;
       }
 
-      return {};
+      auto& state = states.front();
+      if (it != std::end(m_entries))
+      {
+         it->crtc = state.crtc;
+         it->is_active = true;
+         *it->value = std::move(state.value);
+      }
+      else
+      {
+         m_entries.push_back({.output = state.output,
+                              .crtc = state.crtc,
+                              .is_active = true,
+                              .value = std::make_unique<monitor>(std::move(state.value))});
+      }
    }
 
 #endif // defined (LIBOWL_USE_X11)
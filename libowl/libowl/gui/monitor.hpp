@@ -16,7 +16,9 @@
 
 #include <fmt/core.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace owl::inline v0
 {
@@ -43,14 +45,58 @@ namespace owl::inline v0
    };
 
 #if defined(LIBOWL_USE_X11)
+   struct crtc_changed_event;
+   struct output_changed_event;
+
    /**
-    * @brief Finds all monitors currently accessible by the X server.
-    *
-    * @param[in] conn The connection to the X server
+    * @brief Keeps the list of monitors up to date from RandR notifications, instead of querying
+    * the X server again
     *
-    * @return A list of monitors plugged into the computer
+    * Monitors are never freed while the registry lives, windows keep references to them. A monitor
+    * that is unplugged is only marked inactive, and reused if its output comes back.
     */
-   auto list_available_monitors(x11::connection const& conn) -> std::vector<monitor>;
+   class monitor_registry
+   {
+   public:
+      /**
+       * @brief List the monitors and subscribe to the RandR output and CRTC change notifications
+       *
+       * All the output requests are sent before waiting on any reply, then all the CRTC requests,
+       * so listing costs two round trips to the X server regardless of the number of outputs.
+       *
+       * @param[in] conn The connection to the X server, must outlive the registry
+       */
+      explicit monitor_registry(x11::connection const& conn);
+
+      /**
+       * @brief Get the monitors currently plugged into the computer
+       */
+      [[nodiscard]] auto active_monitors() const -> std::vector<monitor*>;
+
+      /**
+       * @brief Update the geometry of the monitors shown by a CRTC
+       */
+      void update(crtc_changed_event const& event);
+
+      /**
+       * @brief Update the monitor plugged into an output. The X server is only queried for an
+       * output that was never seen before or that moved to another CRTC.
+       */
+      void update(output_changed_event const& event);
+
+   private:
+      struct entry
+      {
+         u32 output;
+         u32 crtc;
+         bool is_active;
+         std::unique_ptr<monitor> value;
+      };
+
+      x11::connection const* mp_connection;
+
+      std::vector<entry> m_entries;
+   };
 #endif // defined (LIBOWL_USE_X11)
 } // namespace owl::inline v0
 
@@ -0,0 +1,189 @@
+/**
+ * @file libowl/layout/grid.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#include <libowl/layout/grid.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <cassert>
+#include <span>
+
+namespace owl::inline v0
+{
+   namespace layout
+   {
+      namespace
+      {
+         auto total_size(std::span<u32 const> sizes, u32 spacing) -> u32
+         {
+            if (std::empty(sizes))
+            {
+               return 0;
+            }
+
+            u64 total = static_cast<u64>(spacing) * (std::size(sizes) - 1);
+            for (u32 const size : sizes)
+            {
+               total += size;
+            }
+
+            return static_cast<u32>(std::min<u64>(total, unbounded));
+         }
+
+         /**
+          * @brief Give the space left by the tracks to the weighted ones, in proportion of their
+          * weight
+          */
+         void distribute(std::span<track const> tracks, std::span<u32> sizes, u32 available,
+                         u32 spacing)
+         {
+            u32 const used = total_size(sizes, spacing);
+            if (available == unbounded || used >= available)
+            {
+               return;
+            }
+
+            u64 total_weight = 0;
+            for (track const& t : tracks)
+            {
+               if (t.sizing == track_sizing::weight)
+               {
+                  total_weight += t.value;
+               }
+            }
+
+            if (total_weight == 0)
+            {
+               return;
+            }
+
+            // Shares are computed from the running weight so that rounding doesn't lose pixels
+            u64 const left = available - used;
+            u64 weight_seen = 0;
+            u64 given = 0;
+            for (u64 i = 0; i < std::size(tracks); ++i)
+            {
+               if (tracks[i].sizing == track_sizing::weight)
+               {
+                  weight_seen += tracks[i].value;
+
+                  u64 const share = left * weight_seen / total_weight - given;
+                  sizes[i] += static_cast<u32>(share);
+                  given += share;
+               }
+            }
+         }
+
+         void compute_offsets(std::span<u32 const> sizes, std::span<i32> offsets, i32 origin,
+                              u32 spacing)
+         {
+            i64 offset = origin;
+            for (u64 i = 0; i < std::size(sizes); ++i)
+            {
+               offsets[i] = static_cast<i32>(offset);
+               offset += static_cast<i64>(sizes[i]) + spacing;
+            }
+         }
+      } // namespace
+
+      grid::grid(std::vector<track> rows, std::vector<track> columns, u32 spacing) :
+         m_rows(std::move(rows)), m_columns(std::move(columns)), m_spacing(spacing),
+         m_row_sizes(std::size(m_rows)), m_column_sizes(std::size(m_columns)),
+         m_row_offsets(std::size(m_rows)), m_column_offsets(std::size(m_columns))
+      {}
+
+      void grid::add(node& child, u32 row, u32 column)
+      {
+         // NOLINTNEXTLINE
+         assert(row < row_count() && column < column_count());
+
+         m_placements.push_back({.p_node = &child, .row = row, .column = column});
+         attach(child);
+      }
+      void grid::remove(node& child) { detach(child); }
+
+      auto grid::row_count() const noexcept -> u32 { return static_cast<u32>(std::size(m_rows)); }
+      auto grid::column_count() const noexcept -> u32
+      {
+         return static_cast<u32>(std::size(m_columns));
+      }
+
+      auto grid::measure_content(size_constraints const& /* available */) -> extent
+      {
+         measure_tracks();
+
+         return {.width = total_size(m_column_sizes, m_spacing),
+                 .height = total_size(m_row_sizes, m_spacing)};
+      }
+      void grid::arrange_content(rect const& area)
+      {
+         // The children that weren't invalidated return their cached size
+         measure_tracks();
+
+         distribute(m_columns, m_column_sizes, area.width, m_spacing);
+         distribute(m_rows, m_row_sizes, area.height, m_spacing);
+
+         compute_offsets(m_column_sizes, m_column_offsets, area.x, m_spacing);
+         compute_offsets(m_row_sizes, m_row_offsets, area.y, m_spacing);
+
+         for (placement const& cell : m_placements)
+         {
+            cell.p_node->arrange({.x = m_column_offsets[cell.column],
+                                  .y = m_row_offsets[cell.row],
+                                  .width = m_column_sizes[cell.column],
+                                  .height = m_row_sizes[cell.row]});
+         }
+      }
+
+      void grid::detach(node& child)
+      {
+         std::erase_if(m_placements,
+                       [&](placement const& cell) { return cell.p_node == &child; });
+
+         node::detach(child);
+      }
+
+      auto grid::cell_constraints(placement const& cell) const noexcept -> size_constraints
+      {
+         auto const& available = content_constraints();
+         auto const limit = [](track const& t, u32 max) {
+            return t.sizing == track_sizing::pixels ? std::min(t.value, max) : max;
+         };
+
+         return {.min = {},
+                 .max = {.width = limit(m_columns[cell.column], available.max.width),
+                         .height = limit(m_rows[cell.row], available.max.height)}};
+      }
+
+      void grid::measure_tracks()
+      {
+         auto const initial_size = [](track const& t) {
+            return t.sizing == track_sizing::pixels ? t.value : 0U;
+         };
+
+         std::ranges::transform(m_rows, std::begin(m_row_sizes), initial_size);
+         std::ranges::transform(m_columns, std::begin(m_column_sizes), initial_size);
+
+         for (placement const& cell : m_placements)
+         {
+            extent const size = cell.p_node->measure(cell_constraints(cell));
+
+            if (m_rows[cell.row].sizing != track_sizing::pixels)
+            {
+               m_row_sizes[cell.row] = std::max(m_row_sizes[cell.row], size.height);
+            }
+
+            if (m_columns[cell.column].sizing != track_sizing::pixels)
+            {
+               m_column_sizes[cell.column] = std::max(m_column_sizes[cell.column], size.width);
+            }
+         }
+      }
+   } // namespace layout
+} // namespace owl::inline v0
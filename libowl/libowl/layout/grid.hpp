@@ -0,0 +1,105 @@
+/**
+ * @file libowl/layout/grid.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#ifndef LIBOWL_LAYOUT_GRID_HPP_
+#define LIBOWL_LAYOUT_GRID_HPP_
+
+#include <libowl/layout/node.hpp>
+
+namespace owl::inline v0
+{
+   namespace layout
+   {
+      /**
+       * @brief How a row or a column of a grid is sized
+       */
+      enum struct track_sizing
+      {
+         content, ///< As large as the largest child in the track
+         pixels,  ///< A fixed number of pixels
+         weight   ///< As large as its content, plus a share of the space left by the other tracks
+      };
+
+      /**
+       * @brief A row or a column of a grid
+       */
+      struct track
+      {
+         track_sizing sizing = track_sizing::content;
+         u32 value = 0; ///< The size in pixels or the weight, depending on the sizing
+
+         static constexpr auto content() noexcept -> track { return {}; }
+         static constexpr auto pixels(u32 size) noexcept -> track
+         {
+            return {.sizing = track_sizing::pixels, .value = size};
+         }
+         static constexpr auto weight(u32 weight = 1) noexcept -> track
+         {
+            return {.sizing = track_sizing::weight, .value = weight};
+         }
+      };
+
+      /**
+       * @brief Lays its children out in cells of rows and columns. Every child fills its cell.
+       */
+      class grid : public node
+      {
+      public:
+         grid(std::vector<track> rows, std::vector<track> columns, u32 spacing = 0);
+
+         /**
+          * @brief Place a node in the cell at `row` and `column`. The node isn't owned by the grid
+          */
+         void add(node& child, u32 row, u32 column);
+         void remove(node& child);
+
+         [[nodiscard]] auto row_count() const noexcept -> u32;
+         [[nodiscard]] auto column_count() const noexcept -> u32;
+
+      protected:
+         auto measure_content(size_constraints const& available) -> extent override;
+         void arrange_content(rect const& area) override;
+
+         void detach(node& child) override;
+
+      private:
+         struct placement
+         {
+            node* p_node;
+            u32 row;
+            u32 column;
+         };
+
+         /**
+          * @brief Get the space a child may take in a cell. Only depends on the constraints of the
+          * grid, so the children stay cached between measure and arrange
+          */
+         [[nodiscard]] auto cell_constraints(placement const& cell) const noexcept
+            -> size_constraints;
+
+         /**
+          * @brief Measure the children and size the tracks after their content
+          */
+         void measure_tracks();
+
+      private:
+         std::vector<track> m_rows;
+         std::vector<track> m_columns;
+         u32 m_spacing;
+
+         std::vector<placement> m_placements;
+
+         std::vector<u32> m_row_sizes;
+         std::vector<u32> m_column_sizes;
+         std::vector<i32> m_row_offsets;
+         std::vector<i32> m_column_offsets;
+      };
+   } // namespace layout
+} // namespace owl::inline v0
+
+#endif // LIBOWL_LAYOUT_GRID_HPP_
@@ -0,0 +1,252 @@
+/**
+ * @file libowl/layout/node.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#include <libowl/layout/node.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+#include <cassert>
+
+namespace owl::inline v0
+{
+   namespace layout
+   {
+      namespace
+      {
+         /**
+          * @brief Narrow the space available to a node to its own constraints
+          */
+         auto restrict(size_constraints const& available, size_constraints const& own)
+            -> size_constraints
+         {
+            extent const min = {
+               .width = std::clamp(own.min.width, available.min.width, available.max.width),
+               .height = std::clamp(own.min.height, available.min.height, available.max.height)};
+
+            return {.min = min,
+                    .max = {.width = std::clamp(own.max.width, min.width, available.max.width),
+                            .height = std::clamp(own.max.height, min.height,
+                                                 available.max.height)}};
+         }
+      } // namespace
+
+      node::~node()
+      {
+         if (mp_parent)
+         {
+            mp_parent->detach(*this);
+         }
+
+         for (node* p_child : m_children)
+         {
+            p_child->mp_parent = nullptr;
+         }
+      }
+
+      auto node::measure(size_constraints const& available) -> extent
+      {
+         if (!m_needs_measure && available == m_available)
+         {
+            return m_measured_size;
+         }
+
+         m_available = available;
+         m_content_constraints = restrict(available, m_constraints);
+
+         extent const desired = measure_content(m_content_constraints);
+         extent const measured = {.width = std::clamp(desired.width,
+                                                      m_content_constraints.min.width,
+                                                      m_content_constraints.max.width),
+                                  .height = std::clamp(desired.height,
+                                                       m_content_constraints.min.height,
+                                                       m_content_constraints.max.height)};
+
+         if (measured != m_measured_size)
+         {
+            m_measured_size = measured;
+            m_needs_arrange = true;
+         }
+
+         m_needs_measure = false;
+
+         return m_measured_size;
+      }
+
+      void node::arrange(rect const& available_area)
+      {
+         // A node never grows past its constraints, even when given more space
+         rect const area = {.x = available_area.x,
+                            .y = available_area.y,
+                            .width = std::min(available_area.width, m_constraints.max.width),
+                            .height = std::min(available_area.height, m_constraints.max.height)};
+
+         if (area == m_area && !m_needs_arrange)
+         {
+            // Only the invalidated branches are walked down
+            if (m_has_dirty_child)
+            {
+               m_has_dirty_child = false;
+
+               for (node* p_child : m_children)
+               {
+                  if (p_child->needs_layout())
+                  {
+                     p_child->arrange(p_child->m_area);
+                  }
+               }
+            }
+
+            return;
+         }
+
+         m_area = area;
+         m_needs_arrange = false;
+         m_has_dirty_child = false;
+
+         arrange_content(area);
+      }
+
+      void node::update_layout(extent size)
+      {
+         // NOLINTNEXTLINE
+         assert(mp_parent == nullptr);
+
+         measure({.min = size, .max = size});
+         arrange({.x = 0, .y = 0, .width = size.width, .height = size.height});
+      }
+
+      void node::set_constraints(size_constraints const& constraints)
+      {
+         if (constraints == m_constraints)
+         {
+            return;
+         }
+
+         m_constraints = constraints;
+
+         // The node may have been fixed size before, its own size has to be computed again either
+         // way
+         m_needs_measure = true;
+         m_needs_arrange = true;
+
+         invalidate_ancestors();
+      }
+      auto node::constraints() const noexcept -> size_constraints const& { return m_constraints; }
+      auto node::is_fixed_size() const noexcept -> bool
+      {
+         return m_constraints.min == m_constraints.max;
+      }
+
+      void node::invalidate_measure()
+      {
+         if (m_needs_measure)
+         {
+            return;
+         }
+
+         // A fixed size node doesn't change size whatever its content, only the content has to be
+         // placed again
+         if (is_fixed_size())
+         {
+            invalidate_arrange();
+
+            return;
+         }
+
+         m_needs_measure = true;
+         m_needs_arrange = true;
+
+         invalidate_ancestors();
+      }
+      void node::invalidate_arrange()
+      {
+         if (m_needs_arrange)
+         {
+            return;
+         }
+
+         m_needs_arrange = true;
+
+         mark_ancestors_dirty();
+      }
+      auto node::needs_layout() const noexcept -> bool
+      {
+         return m_needs_measure || m_needs_arrange || m_has_dirty_child;
+      }
+
+      auto node::measured_size() const noexcept -> extent { return m_measured_size; }
+      auto node::area() const noexcept -> rect { return m_area; }
+
+      auto node::parent() const noexcept -> node* { return mp_parent; }
+      auto node::children() const noexcept -> std::span<node* const> { return m_children; }
+
+      void node::arrange_content(rect const& /* area */) {}
+
+      auto node::content_constraints() const noexcept -> size_constraints const&
+      {
+         return m_content_constraints;
+      }
+
+      void node::attach(node& child)
+      {
+         // NOLINTNEXTLINE
+         assert(child.mp_parent == nullptr);
+
+         child.mp_parent = this;
+         m_children.push_back(&child);
+
+         // The child may have been laid out in another tree
+         child.m_needs_measure = true;
+         child.m_needs_arrange = true;
+
+         invalidate_measure();
+      }
+      void node::detach(node& child)
+      {
+         // NOLINTNEXTLINE
+         assert(child.mp_parent == this);
+
+         child.mp_parent = nullptr;
+         std::erase(m_children, &child);
+
+         invalidate_measure();
+      }
+
+      void node::invalidate_ancestors() noexcept
+      {
+         for (node* p_node = mp_parent; p_node; p_node = p_node->mp_parent)
+         {
+            // The invalidation stops at the first fixed size ancestor, its size can't change
+            if (p_node->is_fixed_size())
+            {
+               p_node->invalidate_arrange();
+
+               return;
+            }
+
+            if (p_node->m_needs_measure)
+            {
+               return;
+            }
+
+            p_node->m_needs_measure = true;
+            p_node->m_needs_arrange = true;
+         }
+      }
+      void node::mark_ancestors_dirty() noexcept
+      {
+         // A node to lay out always has ancestors to lay out, the walk stops at the first one
+         for (node* p_node = mp_parent; p_node && !p_node->needs_layout();
+              p_node = p_node->mp_parent)
+         {
+            p_node->m_has_dirty_child = true;
+         }
+      }
+   } // namespace layout
+} // namespace owl::inline v0
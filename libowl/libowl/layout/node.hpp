@@ -0,0 +1,190 @@
+/**
+ * @file libowl/layout/node.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#ifndef LIBOWL_LAYOUT_NODE_HPP_
+#define LIBOWL_LAYOUT_NODE_HPP_
+
+#include <libowl/types.hpp>
+
+// C++ Standard Library
+
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace owl::inline v0
+{
+   namespace layout
+   {
+      /**
+       * @brief Used for a size without upper bound
+       */
+      static constexpr u32 unbounded = std::numeric_limits<u32>::max();
+
+      /**
+       * @brief A size in pixels
+       */
+      struct extent
+      {
+         u32 width = 0;
+         u32 height = 0;
+
+         auto operator==(extent const& rhs) const -> bool = default;
+      };
+
+      /**
+       * @brief An area in pixels, relative to the top left corner of the root of the tree
+       */
+      struct rect
+      {
+         i32 x = 0;
+         i32 y = 0;
+         u32 width = 0;
+         u32 height = 0;
+
+         auto operator==(rect const& rhs) const -> bool = default;
+      };
+
+      /**
+       * @brief The range of sizes a node may take. A node with a minimum equal to its maximum has
+       * a fixed size.
+       */
+      struct size_constraints
+      {
+         extent min = {};
+         extent max = {.width = unbounded, .height = unbounded};
+
+         auto operator==(size_constraints const& rhs) const -> bool = default;
+      };
+
+      /**
+       * @brief A node of a retained layout tree.
+       *
+       * Layout runs in two passes: measure computes the size a node wants within the constraints
+       * given by its parent, arrange gives the node its final area. Both results are cached and
+       * only computed again for the nodes that were invalidated, and the invalidation of a node
+       * stops at its first fixed size ancestor: that ancestor keeps its size, only its content has
+       * to be arranged again.
+       */
+      class node
+      {
+      public:
+         node() = default;
+         node(node const& other) = delete;
+         node(node&& other) noexcept = delete;
+         virtual ~node();
+
+         auto operator=(node const& other) = delete;
+         auto operator=(node&& other) noexcept = delete;
+
+         /**
+          * @brief Compute the size of the node within the space available. Returns the cached
+          * size if the node wasn't invalidated and the space available didn't change.
+          */
+         auto measure(size_constraints const& available) -> extent;
+         /**
+          * @brief Place the node in its final area, shrunk to the maximum size of the node. Does
+          * nothing if the area didn't change and neither the node nor its descendants were
+          * invalidated.
+          */
+         void arrange(rect const& available_area);
+
+         /**
+          * @brief Lay the tree out in an area of the given size. Root only.
+          */
+         void update_layout(extent size);
+
+         /**
+          * @brief Set the range of sizes the node may take
+          */
+         void set_constraints(size_constraints const& constraints);
+         [[nodiscard]] auto constraints() const noexcept -> size_constraints const&;
+         /**
+          * @brief Check if the constraints of the node leave it a single possible size
+          */
+         [[nodiscard]] auto is_fixed_size() const noexcept -> bool;
+
+         /**
+          * @brief Notify the tree that the content of the node changed size
+          */
+         void invalidate_measure();
+         /**
+          * @brief Notify the tree that the content of the node has to be placed again, without
+          * changing size
+          */
+         void invalidate_arrange();
+         /**
+          * @brief Check if the node or one of its descendants has to be laid out again
+          */
+         [[nodiscard]] auto needs_layout() const noexcept -> bool;
+
+         /**
+          * @brief Get the size computed by the last measure
+          */
+         [[nodiscard]] auto measured_size() const noexcept -> extent;
+         /**
+          * @brief Get the area given by the last arrange
+          */
+         [[nodiscard]] auto area() const noexcept -> rect;
+
+         [[nodiscard]] auto parent() const noexcept -> node*;
+         [[nodiscard]] auto children() const noexcept -> std::span<node* const>;
+
+      protected:
+         /**
+          * @brief Compute the size wanted by the content of the node. `available` already
+          * accounts for the constraints of the node.
+          */
+         virtual auto measure_content(size_constraints const& available) -> extent = 0;
+         /**
+          * @brief Measure and arrange the children of the node in its area. Children must be
+          * measured with the same constraints as in measure_content, to hit their cache.
+          */
+         virtual void arrange_content(rect const& area);
+
+         /**
+          * @brief Get the constraints given to the last measure_content
+          */
+         [[nodiscard]] auto content_constraints() const noexcept -> size_constraints const&;
+
+         void attach(node& child);
+         /**
+          * @brief Remove a child from the node. Also called when a child is destroyed.
+          */
+         virtual void detach(node& child);
+
+      private:
+         /**
+          * @brief Measure the ancestors again, up to the first fixed size one
+          */
+         void invalidate_ancestors() noexcept;
+         /**
+          * @brief Make the layout pass walk down to the node
+          */
+         void mark_ancestors_dirty() noexcept;
+
+      private:
+         node* mp_parent = nullptr;
+         std::vector<node*> m_children;
+
+         size_constraints m_constraints;
+         size_constraints m_available;
+         size_constraints m_content_constraints;
+
+         extent m_measured_size;
+         rect m_area;
+
+         // A new node has never been laid out
+         bool m_needs_measure = true;
+         bool m_needs_arrange = true;
+         bool m_has_dirty_child = false;
+      };
+   } // namespace layout
+} // namespace owl::inline v0
+
+#endif // LIBOWL_LAYOUT_NODE_HPP_
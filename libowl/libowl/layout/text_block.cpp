@@ -0,0 +1,79 @@
+/**
+ * @file libowl/layout/text_block.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#include <libowl/layout/text_block.hpp>
+
+// C++ Standard Library
+
+#include <algorithm>
+
+namespace owl::inline v0
+{
+   namespace layout
+   {
+      namespace
+      {
+         auto is_utf8_continuation(char c) noexcept -> bool
+         {
+            return (static_cast<u8>(c) & 0xC0U) == 0x80U; // NOLINT
+         }
+      } // namespace
+
+      text_block::text_block(std::string text) :
+         m_text(std::move(text)), m_text_size(compute_text_size())
+      {}
+
+      void text_block::set_text(std::string text)
+      {
+         m_text = std::move(text);
+
+         extent const size = compute_text_size();
+         if (size != m_text_size)
+         {
+            m_text_size = size;
+            invalidate_measure();
+         }
+      }
+      auto text_block::text() const noexcept -> std::string_view { return m_text; }
+
+      auto text_block::measure_content(size_constraints const& /* available */) -> extent
+      {
+         return m_text_size;
+      }
+
+      auto text_block::compute_text_size() const noexcept -> extent
+      {
+         if (std::empty(m_text))
+         {
+            return {};
+         }
+
+         u32 line_count = 1;
+         u32 longest_line = 0;
+         u32 line_length = 0;
+         for (char const c : m_text)
+         {
+            if (c == '\n')
+            {
+               longest_line = std::max(longest_line, line_length);
+               line_length = 0;
+               ++line_count;
+            }
+            else if (!is_utf8_continuation(c))
+            {
+               ++line_length;
+            }
+         }
+
+         longest_line = std::max(longest_line, line_length);
+
+         return {.width = longest_line * glyph_size.width,
+                 .height = line_count * glyph_size.height};
+      }
+   } // namespace layout
+} // namespace owl::inline v0
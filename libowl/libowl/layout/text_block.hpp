@@ -0,0 +1,56 @@
+/**
+ * @file libowl/layout/text_block.hpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#ifndef LIBOWL_LAYOUT_TEXT_BLOCK_HPP_
+#define LIBOWL_LAYOUT_TEXT_BLOCK_HPP_
+
+#include <libowl/layout/node.hpp>
+
+// C++ Standard Library
+
+#include <string>
+#include <string_view>
+
+namespace owl::inline v0
+{
+   namespace layout
+   {
+      /**
+       * @brief A leaf sized after the lines of text it holds.
+       *
+       * There is no text shaping yet, every code point takes one cell of `glyph_size`.
+       */
+      class text_block : public node
+      {
+      public:
+         static constexpr extent glyph_size = {.width = 8, .height = 16};
+
+      public:
+         text_block() = default;
+         explicit text_block(std::string text);
+
+         /**
+          * @brief Replace the text. Only invalidates the layout if the size of the text changed.
+          */
+         void set_text(std::string text);
+         [[nodiscard]] auto text() const noexcept -> std::string_view;
+
+      protected:
+         auto measure_content(size_constraints const& available) -> extent override;
+
+      private:
+         [[nodiscard]] auto compute_text_size() const noexcept -> extent;
+
+      private:
+         std::string m_text;
+         extent m_text_size;
+      };
+   } // namespace layout
+} // namespace owl::inline v0
+
+#endif // LIBOWL_LAYOUT_TEXT_BLOCK_HPP_
@@ -6,16 +6,19 @@
 #include <libowl/gfx/device.hpp>
 #include <libowl/detail/x11/window.hpp>
 #include <libowl/gui/event/event.hpp>
+#include <libowl/gui/event/event_batch.hpp>
 #include <libowl/gui/monitor.hpp>
 #include <libowl/version.hpp>
 #include <libowl/window.hpp>
 
 #include <libmannele/core/semantic_version.hpp>
+#include <libmannele/tracing/trace.hpp>
 
 #include <fmt/chrono.h>
 
 #include <range/v3/algorithm/remove.hpp>
 
+#include <cassert>
 #include <chrono>
 
 #include <spdlog/logger.h>
@@ -43,7 +46,7 @@ namespace owl::inline v0
       }
    } // namespace
 
-   system::system(std::string_view app_name) :
+   system::system(std::string_view app_name, threading_model model) :
       m_logger(create_logger(app_name)),
       m_instance({.app_info = {.name = app_name, .version = {}},
                   .eng_info = {.name = "owl", .version = library_version},
@@ -52,72 +55,143 @@ namespace owl::inline v0
                   .logger = m_logger}),
       m_physical_devices(ash::enumerate_physical_devices(m_instance)),
       m_xserver_connection(x11::connect_to_server(m_logger).value()),
-      m_monitors(list_available_monitors(m_xserver_connection)),
-      m_thread_id(std::this_thread::get_id())
+      m_monitors(m_xserver_connection),
+      m_thread_id(std::this_thread::get_id()), m_threading_model(model)
    {}
 
    auto system::run() -> i32
    {
-      std::optional<int> exit_code = std::nullopt;
+      m_event_loop.watch(x11::file_descriptor(m_xserver_connection));
 
-      // Switch to UTC
-      auto curr_time = sys_nanosecond(std::chrono::system_clock::now());
+      auto curr_time = std::chrono::steady_clock::now();
 
-      do
+      while (true)
       {
-         auto const new_time = sys_nanosecond(std::chrono::system_clock::now());
-         auto const delta_time = new_time - curr_time;
-         curr_time = new_time;
+         MANNELE_TRACE_ZONE_CAT("owl::system::frame", "owl");
 
          handle_events();
 
-         render(delta_time);
-
          if (std::empty(m_windows))
          {
             m_logger.info("No windows open");
 
-            exit_code = 0;
+            break;
          }
-      } while (not exit_code);
+
+         auto const new_time = std::chrono::steady_clock::now();
+         auto const delta_time = new_time - curr_time;
+         curr_time = new_time;
+
+         const bool is_animating = render(delta_time);
+
+         // Rendering may read events from the connection along with replies, those won't make its
+         // file descriptor readable anymore
+         if (handle_queued_events())
+         {
+            continue;
+         }
+
+         // The X server can't answer requests that are still buffered
+         x11::flush(m_xserver_connection);
+
+         m_event_loop.wait(not is_animating);
+
+         if (not is_animating)
+         {
+            // The time spent idle is not part of the next animation step
+            curr_time = std::chrono::steady_clock::now();
+         }
+      }
 
       m_logger.info("shutting down");
 
-      return exit_code.value();
+      return 0;
    }
 
    void system::handle_events()
+   {
+      MANNELE_TRACE_ZONE_CAT("owl::system::handle_events", "owl");
+
+      // Read everything available first, runs of movements and resizes are then collapsed
+      m_event_buffer.clear();
+      while (auto event = poll_for_event(m_xserver_connection))
+      {
+         m_event_buffer.push_back(std::move(event).value());
+      }
+
+      dispatch_events();
+   }
+   auto system::handle_queued_events() -> bool
+   {
+      m_event_buffer.clear();
+      while (auto event = poll_for_queued_event(m_xserver_connection))
+      {
+         m_event_buffer.push_back(std::move(event).value());
+      }
+
+      dispatch_events();
+
+      return not std::empty(m_event_buffer);
+   }
+   void system::dispatch_events()
    {
       using detail::overloaded;
 
-      while (auto const event = poll_for_event(m_xserver_connection))
+      if (std::empty(m_event_buffer))
+      {
+         return;
+      }
+
+      sort_into_batches(m_event_buffer, m_event_batches);
+
+      for (event_variant const& event : m_event_batches.system_events)
       {
          // clang-format off
          std::visit(
             overloaded{
-               [&](key_event const& e) { m_window_in_focus->handle_event(e); }, 
-               [](mouse_button_event const&) {},
-               [](mouse_movement_event const&) {},
-               [&](structure_changed_event const& e) { handle_structure_changed_event(e); },
                [&](focus_event const& e) { handle_focus_event(e); },
-               [&](command cmd) { handle_command(cmd); } },
-            event.value());
+               [&](crtc_changed_event const& e) { m_monitors.update(e); },
+               [&](output_changed_event const& e) { m_monitors.update(e); },
+               [&](command cmd) { handle_command(cmd); },
+               [](auto const&) {} },
+            event);
          // clang-format on
       }
-   }
 
-   void system::handle_structure_changed_event(structure_changed_event const& event)
+      for (window_event_batch const& batch : m_event_batches.windows)
+      {
+         if (std::empty(batch.events))
+         {
+            break;
+         }
+
+         dispatch_window_batch(batch);
+      }
+   }
+   void system::dispatch_window_batch(window_event_batch const& batch)
    {
-      auto const it = std::ranges::find(m_windows, event.window_id, &window::id);
-      if (it != std::end(m_windows))
+      auto const it = std::ranges::find(m_windows, batch.window_id, &window::id);
+      if (it == std::end(m_windows))
       {
-         m_logger.debug("window \"{}\" has been moved to {}", (*it)->title(), event.dimension);
+         // Events still in flight for a window that was just closed
+         m_logger.debug("dropping {} events for window with id {}", std::size(batch.events),
+                        batch.window_id);
+
+         return;
       }
-      else
+
+      for (event_variant const& event : batch.events)
       {
-         m_logger.warn("window with id {} was not found!", event.window_id);
+         if (auto const* p_changed = std::get_if<structure_changed_event>(&event))
+         {
+            m_logger.debug("window \"{}\" has been moved to {}", (*it)->title(),
+                           p_changed->dimension);
+         }
       }
+
+      (*it)->dispatch_events(batch.events);
    }
+
    void system::handle_focus_event(focus_event const& event)
    {
       if (event.type == focus_type::in)
@@ -157,22 +231,41 @@ namespace owl::inline v0
       }
    }
 
-   void system::render(std::chrono::nanoseconds delta_time)
+   auto system::render(std::chrono::nanoseconds delta_time) -> bool
    {
+      MANNELE_TRACE_ZONE_CAT("owl::system::render", "owl");
+
+      bool is_animating = false;
       for (const auto& window : m_windows)
       {
-         window->render(delta_time);
+         if (window->has_render_thread())
+         {
+            continue;
+         }
+
+         // Consume the request first, a redraw requested while rendering is kept for the next one
+         const bool is_dirty = window->take_redraw_request();
+         if (is_dirty or window->is_animating())
+         {
+            window->render(delta_time);
+         }
+
+         is_animating = is_animating or window->is_animating();
       }
+
+      return is_animating;
    }
 
    auto system::make_window(std::string_view name) -> window&
    {
+      monitor& target_monitor = *m_monitors.active_monitors().at(0);
+
       return add_window(
          std::make_unique<x11::window>(x11::window_create_info{.p_system = this,
                                                                .name = name,
                                                                .conn = m_xserver_connection,
                                                                .instance = m_instance,
-                                                               .target_monitor = m_monitors[0],
+                                                               .target_monitor = target_monitor,
                                                                .logger = m_logger}));
    }
 
@@ -181,10 +274,43 @@ namespace owl::inline v0
       return m_thread_id == std::this_thread::get_id();
    }
 
+   void system::post(std::function<void()> task) { m_event_loop.post(std::move(task)); }
+   void system::wake() const noexcept { m_event_loop.wake(); }
+
+   auto system::add_timer(std::chrono::nanoseconds delay, std::function<void()> task,
+                          std::chrono::nanoseconds period) -> u64
+   {
+      // NOLINTNEXTLINE
+      assert(is_gui_thread());
+
+      return m_event_loop.add_timer(delay, std::move(task), period);
+   }
+   void system::cancel_timer(u64 id)
+   {
+      // NOLINTNEXTLINE
+      assert(is_gui_thread());
+
+      m_event_loop.cancel_timer(id);
+   }
+
    auto system::add_window(std::unique_ptr<window>&& wnd) -> window&
+   {
+      wnd->set_device(acquire_device(*wnd));
+
+      if (m_threading_model == threading_model::render_thread_per_window)
+      {
+         wnd->start_render_thread();
+      }
+
+      m_windows.push_back(std::move(wnd));
+
+      return *m_windows.back().get();
+   }
+
+   auto system::acquire_device(window const& wnd) -> gfx::shared_device
    {
       auto results = ash::find_most_suitable_physical_device(
-         m_physical_devices, {.surface = wnd->target().surface(),
+         m_physical_devices, {.surface = wnd.target().surface(),
                               .require_transfer_queue = true,
                               .require_compute_queue = true,
                               .desired_version = m_instance.version(),
@@ -200,14 +326,32 @@ namespace owl::inline v0
 
       auto const& result_data = results.value();
 
-      m_logger.info(R"(rendering window "{}" using physical device "{}")", wnd->title(),
+      auto const it = std::ranges::find_if(m_devices, [&](gfx::shared_device const& device) {
+         return &device->physical() == result_data.p_physical_device;
+      });
+
+      if (it != std::end(m_devices) && (*it)->can_present_to(wnd.target().surface()))
+      {
+         m_logger.info(R"(rendering window "{}" using the existing device of "{}")", wnd.title(),
+                       result_data.p_physical_device->properties.deviceName);
+
+         return *it;
+      }
+
+      m_logger.info(R"(rendering window "{}" using physical device "{}")", wnd.title(),
                     result_data.p_physical_device->properties.deviceName);
 
-      wnd->set_device(gfx::device(result_data.p_physical_device, result_data.queues_to_create,
-                                  result_data.extension_to_enable, m_logger));
+      auto device =
+         std::make_shared<gfx::device>(result_data.p_physical_device, result_data.queues_to_create,
+                                       result_data.extension_to_enable, m_logger);
 
-      m_windows.push_back(std::move(wnd));
+      // When the queues of the shared device can't present to the window, it gets a device of
+      // its own that isn't shared
+      if (it == std::end(m_devices))
+      {
+         m_devices.push_back(device);
+      }
 
-      return *m_windows.back().get();
+      return device;
    }
 } // namespace owl::inline v0
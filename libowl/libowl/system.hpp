@@ -2,7 +2,11 @@
 #define LIBOWL_SYSTEM_HPP_
 
 #include <libowl/chrono.hpp>
+#include <libowl/detail/event_loop.hpp>
+#include <libowl/gfx/device.hpp>
 #include <libowl/gui/event/command.hpp>
+#include <libowl/gui/event/event.hpp>
+#include <libowl/gui/event/event_batch.hpp>
 #include <libowl/gui/event/focus_event.hpp>
 #include <libowl/gui/event/structure_changed_event.hpp>
 #include <libowl/gui/monitor.hpp>
@@ -24,6 +28,15 @@ namespace owl::inline v0
    static constexpr auto library_version = mannele::semantic_version{
       .major = LIBOWL_VERSION_MAJOR, .minor = LIBOWL_VERSION_MINOR, .patch = LIBOWL_VERSION_PATCH};
 
+   /**
+    * @brief How the frames of the windows are produced
+    */
+   enum struct threading_model
+   {
+      single_threaded,         ///< The main loop renders every window on the GUI thread
+      render_thread_per_window ///< The GUI thread only dispatches events, windows render apart
+   };
+
    /**
     * @brief Central starting point of the library. Used for keeping track of all the windows and
     * events for the GUI
@@ -39,11 +52,16 @@ namespace owl::inline v0
        * @brief Initializes the gui system
        *
        * @param[in] app_name The name of the app
+       * @param[in] model Whether each window is rendered by its own thread
        */
-      explicit system(std::string_view app_name);
+      explicit system(std::string_view app_name,
+                      threading_model model = threading_model::single_threaded);
 
       /**
        * @brief The main loop
+       *
+       * Sleeps until the X server sends an event, a timer expires or another thread wakes it up.
+       * Only windows with a pending redraw request or a running animation are rendered.
        */
       auto run() -> i32;
 
@@ -58,13 +76,43 @@ namespace owl::inline v0
 
       [[nodiscard]] auto is_gui_thread() const noexcept -> bool;
 
+      /**
+       * @brief Run `task` on the GUI thread. Safe to call from any thread.
+       */
+      void post(std::function<void()> task);
+      /**
+       * @brief Wake the main loop up if it is idle. Safe to call from any thread.
+       */
+      void wake() const noexcept;
+
+      /**
+       * @brief Run `task` on the GUI thread once `delay` elapsed, then every `period` if it is not
+       * zero. Must be called from the GUI thread.
+       *
+       * @return The id used to cancel the timer
+       */
+      auto add_timer(std::chrono::nanoseconds delay, std::function<void()> task,
+                     std::chrono::nanoseconds period = std::chrono::nanoseconds::zero()) -> u64;
+      void cancel_timer(u64 id);
+
    private:
       void handle_events();
-      void handle_structure_changed_event(structure_changed_event const& event);
+      auto handle_queued_events() -> bool;
+      /**
+       * @brief Sort the events read in this iteration into coalesced batches, handle the ones for
+       * the system then hand each window its batch
+       */
+      void dispatch_events();
+      void dispatch_window_batch(window_event_batch const& batch);
       void handle_focus_event(focus_event const& event);
       void handle_command(command cmd);
 
-      void render(std::chrono::nanoseconds delta_time);
+      /**
+       * @brief Render the windows that are dirty or animating
+       *
+       * @return Whether any window is animating, and the loop must not sleep
+       */
+      auto render(std::chrono::nanoseconds delta_time) -> bool;
 
       /**
        * @brief Add a window to the list of root windows stored by the system
@@ -75,19 +123,32 @@ namespace owl::inline v0
        */
       auto add_window(unique_window&& wnd) -> window&;
 
+      /**
+       * @brief Find the device of the physical device best suited to render to `wnd`, creating it
+       * on first use. Windows on the same physical device share its device.
+       */
+      auto acquire_device(window const& wnd) -> gfx::shared_device;
+
    private:
       spdlog::logger m_logger;
 
       ash::instance m_instance;
       std::vector<ash::physical_device> m_physical_devices;
+      std::vector<gfx::shared_device> m_devices; ///< At most one per physical device
 
       x11::connection m_xserver_connection;
 
-      std::vector<monitor> m_monitors;
+      monitor_registry m_monitors;
       std::vector<unique_window> m_windows;
       window* m_window_in_focus = nullptr;
 
+      std::vector<event_variant> m_event_buffer;
+      event_batches m_event_batches;
+
       std::thread::id m_thread_id;
+      threading_model m_threading_model;
+
+      detail::event_loop m_event_loop;
    };
 } // namespace owl::inline v0
 
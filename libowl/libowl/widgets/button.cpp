@@ -12,6 +12,10 @@ namespace owl::inline v0
 {
    namespace widget
    {
-      button::button(window& window, widget* p_parent) : super(window, p_parent) {}
+      button::button(owl::window& window, widget* p_parent, std::string caption) :
+         super(window, p_parent), m_layout(std::move(caption))
+      {}
+
+      auto button::layout_node() noexcept -> layout::node& { return m_layout; }
    } // namespace widget
 } // namespace owl::inline v0
@@ -9,6 +9,7 @@
 #ifndef LIBOWL_WIDGETS_BUTTON_HPP_
 #define LIBOWL_WIDGETS_BUTTON_HPP_
 
+#include <libowl/layout/text_block.hpp>
 #include <libowl/widgets/widget.hpp>
 
 namespace owl::inline v0
@@ -20,9 +21,12 @@ namespace owl::inline v0
          using super = widget;
 
       public:
-         button(window& window, widget* p_parent);
+         button(owl::window& window, widget* p_parent, std::string caption = {});
+
+         [[nodiscard]] auto layout_node() noexcept -> layout::node& override;
 
       private:
+         layout::text_block m_layout; ///< Sized after the caption
       };
    } // namespace widget
 } // namespace owl::inline v0
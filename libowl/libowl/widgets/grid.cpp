@@ -12,6 +12,15 @@ namespace owl::inline v0
 {
    namespace widget
    {
-      grid::grid(window& window, widget* p_parent) : super(window, p_parent) {}
+      grid::grid(owl::window& window, widget* p_parent) :
+         grid(window, p_parent, {layout::track::weight()}, {layout::track::weight()})
+      {}
+      grid::grid(owl::window& window, widget* p_parent, std::vector<layout::track> rows,
+                 std::vector<layout::track> columns, u32 spacing) :
+         super(window, p_parent),
+         m_layout(std::move(rows), std::move(columns), spacing)
+      {}
+
+      auto grid::layout_node() noexcept -> layout::node& { return m_layout; }
    } // namespace widget
 } // namespace owl::inline v0
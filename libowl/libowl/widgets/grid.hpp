@@ -9,10 +9,13 @@
 #ifndef LIBOWL_WIDGETS_GRID_HPP_
 #define LIBOWL_WIDGETS_GRID_HPP_
 
+#include <libowl/layout/grid.hpp>
 #include <libowl/widgets/widget.hpp>
 
 #include <cassert>
 #include <concepts>
+#include <memory>
+#include <vector>
 
 namespace owl::inline v0
 {
@@ -23,18 +26,37 @@ namespace owl::inline v0
          using super = widget;
 
       public:
-         grid(window& window, widget* p_parent);
+         /**
+          * @brief Create a grid of a single cell taking all the space given
+          */
+         grid(owl::window& window, widget* p_parent);
+         grid(owl::window& window, widget* p_parent, std::vector<layout::track> rows,
+              std::vector<layout::track> columns, u32 spacing = 0);
 
-         /*
          template <typename Widget, typename... Args>
-            requires std::constructible_from<Widget, window&, widget*, Args...>
-         auto make_widget(std::size_t row, std::size_t col, Args... args) -> Widget&
+            requires std::constructible_from<Widget, owl::window&, widget*, Args...>
+         auto make_widget(u32 row, u32 column, Args&&... args) -> Widget&
          {
+            // NOLINTNEXTLINE
             assert(is_gui_thread());
+
+            auto p_widget =
+               std::make_unique<Widget>(owning_window(), this, std::forward<Args>(args)...);
+            Widget& result = *p_widget;
+
+            m_layout.add(result.layout_node(), row, column);
+            m_widgets.push_back(std::move(p_widget));
+
+            return result;
          }
-         */
+
+         [[nodiscard]] auto layout_node() noexcept -> layout::node& override;
 
       private:
+         // Outlives the widgets, they detach from it when destroyed
+         layout::grid m_layout;
+
+         std::vector<std::unique_ptr<widget>> m_widgets;
       };
    } // namespace widget
 } // namespace owl::inline v0
@@ -4,6 +4,13 @@ namespace owl::inline v0
 {
    namespace widget
    {
-      label::label(window& wnd, widget* p_parent) : widget(wnd, p_parent) {}
+      label::label(owl::window& wnd, widget* p_parent, std::string text) :
+         widget(wnd, p_parent), m_layout(std::move(text))
+      {}
+
+      void label::set_text(std::string text) { m_layout.set_text(std::move(text)); }
+      auto label::text() const noexcept -> std::string_view { return m_layout.text(); }
+
+      auto label::layout_node() noexcept -> layout::node& { return m_layout; }
    } // namespace widget
 } // namespace owl::inline v0
@@ -9,18 +9,29 @@
 #ifndef LIBOWL_WIDGETS_LABEL_HPP_
 #define LIBOWL_WIDGETS_LABEL_HPP_
 
+#include <libowl/layout/text_block.hpp>
 #include <libowl/widgets/widget.hpp>
 
 namespace owl::inline v0
 {
    namespace widget
    {
-      class label : widget
+      class label : public widget
       {
       public:
-         label(window& wnd, widget* p_parent);
+         label(owl::window& wnd, widget* p_parent, std::string text = {});
+
+         /**
+          * @brief Replace the text. Only the ancestors up to the first fixed size one are laid
+          * out again, and only if the size of the text changed.
+          */
+         void set_text(std::string text);
+         [[nodiscard]] auto text() const noexcept -> std::string_view;
+
+         [[nodiscard]] auto layout_node() noexcept -> layout::node& override;
 
       private:
+         layout::text_block m_layout;
       };
    } // namespace widget
 } // namespace owl::inline v0
@@ -24,6 +24,11 @@ namespace owl::inline v0
          return m_window.is_gui_thread();
       }
 
+      void widget::set_size_constraints(layout::size_constraints const& constraints)
+      {
+         layout_node().set_constraints(constraints);
+      }
+
       [[nodiscard]] auto widget::owning_window() const noexcept -> owl::window const&
       {
          return m_window;
@@ -9,6 +9,8 @@
 #ifndef LIBOWL_WIDGETS_WIDGET_HPP_
 #define LIBOWL_WIDGETS_WIDGET_HPP_
 
+#include <libowl/layout/node.hpp>
+
 namespace owl::inline v0
 {
    class window;
@@ -19,9 +21,21 @@ namespace owl::inline v0
       {
       public:
          widget(owl::window& window, widget* p_parent);
+         virtual ~widget() = default;
 
          [[nodiscard]] auto is_gui_thread() const noexcept -> bool;
 
+         /**
+          * @brief Get the node laying the widget out
+          */
+         [[nodiscard]] virtual auto layout_node() noexcept -> layout::node& = 0;
+
+         /**
+          * @brief Set the range of sizes the widget may take. A fixed size widget stops the
+          * layout invalidations coming from its content.
+          */
+         void set_size_constraints(layout::size_constraints const& constraints);
+
          //      virtual void render() = 0;
 
          // Getters
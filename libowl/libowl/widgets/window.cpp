@@ -15,9 +15,18 @@ namespace owl::inline v0
    namespace widget
    {
       window::window(owl::window& wnd) :
-         widget(wnd, nullptr), m_titlebar(wnd, this), m_frame(wnd, this)
-      {}
+         widget(wnd, nullptr),
+         m_layout({layout::track::content(), layout::track::weight()}, {layout::track::weight()}),
+         m_titlebar(wnd, this), m_frame(wnd, this)
+      {
+         m_layout.add(m_titlebar.layout_node(), 0, 0);
+         m_layout.add(m_frame.layout_node(), 1, 0);
+      }
 
       auto window::frame() noexcept -> grid& { return m_frame; }
+
+      void window::update_layout(layout::extent size) { m_layout.update_layout(size); }
+
+      auto window::layout_node() noexcept -> layout::node& { return m_layout; }
    } // namespace widget
 } // namespace owl::inline v0
@@ -9,6 +9,7 @@
 #ifndef LIBOWL_WIDGETS_WINDOW_HPP_
 #define LIBOWL_WIDGETS_WINDOW_HPP_
 
+#include <libowl/layout/grid.hpp>
 #include <libowl/widgets/grid.hpp>
 
 namespace owl::inline v0
@@ -22,7 +23,18 @@ namespace owl::inline v0
 
          auto frame() noexcept -> grid&;
 
+         /**
+          * @brief Lay the widgets out in an area of the given size. Only the widgets invalidated
+          * since the last call are measured and arranged again.
+          */
+         void update_layout(layout::extent size);
+
+         [[nodiscard]] auto layout_node() noexcept -> layout::node& override;
+
       private:
+         // The title bar takes the height it needs, the frame the rest
+         layout::grid m_layout;
+
          grid m_titlebar;
 
          grid m_frame;
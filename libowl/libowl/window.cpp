@@ -8,13 +8,52 @@
 
 #include <libowl/window.hpp>
 
+#include <libowl/detail/render_thread.hpp>
+#include <libowl/detail/visit_helper.hpp>
 #include <libowl/system.hpp>
 
 namespace owl::inline v0
 {
+   window::~window() = default;
+
    void window::render(std::chrono::nanoseconds) {}
 
    void window::handle_event(const key_event&) {}
+   void window::handle_event(const mouse_movement_event&) {}
+
+   void window::dispatch_events(std::span<event_variant const> events)
+   {
+      for (event_variant const& event : events)
+      {
+         if (m_render_thread)
+         {
+            m_render_thread->push(event_variant(event));
+         }
+         else
+         {
+            apply_event(event);
+         }
+      }
+   }
+
+   void window::apply_event(event_variant const& event)
+   {
+      using detail::overloaded;
+
+      // clang-format off
+      std::visit(
+         overloaded{
+            [&](key_event const& e) { handle_event(e); },
+            [&](mouse_movement_event const& e) { handle_event(e); },
+            [&](structure_changed_event const& e) {
+               m_render_target.update_dimensions(e.dimension);
+               request_redraw();
+            },
+            [&](expose_event const&) { request_redraw(); },
+            [](auto const&) {} },
+         event);
+      // clang-format on
+   }
 
    [[nodiscard]] auto window::is_gui_thread() const noexcept -> bool
    {
@@ -33,11 +72,65 @@ namespace owl::inline v0
       return *mp_target_monitor;
    }
 
-   void window::set_device(gfx::device&& device) noexcept
+   void window::set_device(gfx::shared_device device)
    {
       m_render_target.set_device(std::move(device));
    }
 
+   void window::request_redraw() noexcept
+   {
+      // Only the first request needs to wake the rendering thread up
+      if (!m_is_dirty.exchange(true))
+      {
+         wake_renderer();
+      }
+   }
+   auto window::take_redraw_request() noexcept -> bool { return m_is_dirty.exchange(false); }
+
+   void window::set_animating(bool is_animating) noexcept
+   {
+      if (!m_is_animating.exchange(is_animating) && is_animating)
+      {
+         wake_renderer();
+      }
+   }
+   [[nodiscard]] auto window::is_animating() const noexcept -> bool { return m_is_animating; }
+
+   void window::start_render_thread()
+   {
+      // NOLINTNEXTLINE
+      assert(is_gui_thread() && !m_render_thread);
+
+      m_render_thread = std::make_unique<detail::render_thread>(*this);
+   }
+   [[nodiscard]] auto window::has_render_thread() const noexcept -> bool
+   {
+      return m_render_thread != nullptr;
+   }
+
+   void window::stop_render_thread()
+   {
+      if (m_render_thread)
+      {
+         m_render_thread->stop();
+      }
+   }
+
+   void window::wake_renderer() noexcept
+   {
+      if (m_render_thread)
+      {
+         if (!m_render_thread->is_current_thread())
+         {
+            m_render_thread->notify();
+         }
+      }
+      else if (!is_gui_thread())
+      {
+         m_system.wake();
+      }
+   }
+
    window::window(system& system, std::string_view title, owl::monitor& target_monitor,
                   spdlog::logger& logger) :
       m_system(system),
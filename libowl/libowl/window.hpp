@@ -11,6 +11,7 @@
 
 #include <libowl/gfx/device.hpp>
 #include <libowl/gfx/render_target.hpp>
+#include <libowl/gui/event/event.hpp>
 #include <libowl/gui/event/keyboard_event.hpp>
 #include <libowl/gui/monitor.hpp>
 
@@ -18,13 +19,20 @@
 
 // C++ Standard Library
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <span>
 
 namespace owl::inline v0
 {
    class system;
 
+   namespace detail
+   {
+      class render_thread;
+   } // namespace detail
+
    /**
     * @brief
     */
@@ -33,7 +41,7 @@ namespace owl::inline v0
    public:
       window(window const& other) = delete;
       window(window&& other) noexcept = delete;
-      virtual ~window() = default;
+      virtual ~window();
 
       auto operator=(window const& other) = delete;
       auto operator=(window&& other) noexcept = delete;
@@ -41,8 +49,42 @@ namespace owl::inline v0
       virtual void render(std::chrono::nanoseconds delta_time);
 
       void handle_event(key_event const& event);
+      void handle_event(mouse_movement_event const& event);
+
+      /**
+       * @brief Hand the coalesced events of one iteration of the main loop over to the thread
+       * rendering the window. GUI thread only.
+       */
+      void dispatch_events(std::span<event_variant const> events);
+
+      void set_device(gfx::shared_device device);
+
+      /**
+       * @brief Render the window on the next iteration of the main loop. Safe to call from any
+       * thread.
+       */
+      void request_redraw() noexcept;
+      /**
+       * @brief Consume the pending redraw request, if any
+       */
+      auto take_redraw_request() noexcept -> bool;
+
+      /**
+       * @brief Render the window on every iteration of the main loop while an animation runs,
+       * instead of only when a redraw was requested
+       */
+      void set_animating(bool is_animating) noexcept;
+      /**
+       * @brief Check if the window renders on every iteration of the main loop
+       */
+      [[nodiscard]] auto is_animating() const noexcept -> bool;
 
-      void set_device(gfx::device&& device) noexcept;
+      /**
+       * @brief Render the window on its own thread instead of in the main loop. Events dispatched
+       * to the window are then also handled on that thread.
+       */
+      void start_render_thread();
+      [[nodiscard]] auto has_render_thread() const noexcept -> bool;
 
       /**
        * @brief
@@ -77,6 +119,18 @@ namespace owl::inline v0
 
       void set_render_target(render_target&& target);
 
+      /**
+       * @brief Join the render thread, if any. Must be called first by the destructors of derived
+       * windows, the render thread may still use them otherwise.
+       */
+      void stop_render_thread();
+
+   private:
+      friend class detail::render_thread;
+
+      void apply_event(event_variant const& event);
+      void wake_renderer() noexcept;
+
    private:
       system& m_system;
 
@@ -87,6 +141,13 @@ namespace owl::inline v0
       owl::monitor* mp_target_monitor;
 
       render_target m_render_target;
+
+      // A new window has never been rendered
+      std::atomic<bool> m_is_dirty = true;
+      std::atomic<bool> m_is_animating = false;
+
+      // Last, so that it is joined before the rest of the window is destroyed
+      std::unique_ptr<detail::render_thread> m_render_thread;
    };
 
    using unique_window = std::unique_ptr<window>;
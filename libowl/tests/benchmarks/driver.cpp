@@ -0,0 +1,191 @@
+/**
+ * @file tests/benchmarks/driver.cpp
+ * @author wmbat wmbat-dev@protonmail.com
+ * @date 22nd of January 2022
+ * @brief Full and incremental layout of a tree of 10k labels spread in 100 grids.
+ * @copyright Copyright (C) 2022 wmbat
+ */
+
+#include <libowl/layout/grid.hpp>
+#include <libowl/layout/text_block.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using owl::u32;
+using owl::u64;
+
+namespace layout = owl::layout;
+
+static constexpr u32 panel_rows = 10;
+static constexpr u32 panel_columns = 10;
+static constexpr u32 label_rows = 10;
+static constexpr u32 label_columns = 10;
+static constexpr u32 label_count = panel_rows * panel_columns * label_rows * label_columns;
+
+static constexpr u64 iteration_count = 10;
+static constexpr u64 text_change_count = 1000;
+
+static constexpr layout::extent window_size = {.width = 1920, .height = 1080};
+
+/**
+ * @brief The layout of a window made of panels of labels. The widgets need a live window, the
+ * benchmark builds the layout nodes they are made of instead.
+ */
+struct widget_tree
+{
+   // Destroyed last, the panels and labels detach from their parent when destroyed
+   std::unique_ptr<layout::grid> root;
+   std::vector<std::unique_ptr<layout::grid>> panels;
+   std::vector<std::unique_ptr<layout::text_block>> labels;
+};
+
+auto make_tree(bool has_fixed_size_panels, std::function<std::string(u32)> const& text_of)
+   -> widget_tree
+{
+   widget_tree tree;
+   tree.root = std::make_unique<layout::grid>(std::vector(panel_rows, layout::track::weight()),
+                                              std::vector(panel_columns, layout::track::weight()),
+                                              4);
+
+   for (u32 i = 0; i < panel_rows * panel_columns; ++i)
+   {
+      auto& panel = tree.panels.emplace_back(std::make_unique<layout::grid>(
+         std::vector(label_rows, layout::track::content()),
+         std::vector(label_columns, layout::track::content()), 2));
+
+      if (has_fixed_size_panels)
+      {
+         layout::extent const size = {.width = window_size.width / panel_columns,
+                                      .height = window_size.height / panel_rows};
+         panel->set_constraints({.min = size, .max = size});
+      }
+
+      tree.root->add(*panel, i / panel_columns, i % panel_columns);
+   }
+
+   for (u32 i = 0; i < label_count; ++i)
+   {
+      auto& label = tree.labels.emplace_back(std::make_unique<layout::text_block>(text_of(i)));
+
+      u32 const cell = i % (label_rows * label_columns);
+      tree.panels[i / (label_rows * label_columns)]->add(*label, cell / label_columns,
+                                                         cell % label_columns);
+   }
+
+   return tree;
+}
+
+auto default_text(u32 index) -> std::string { return "label " + std::to_string(index); }
+
+/**
+ * @brief Check the incremental layout of `tree` against the layout of the same tree from scratch
+ */
+auto matches_full_layout(widget_tree const& tree, bool has_fixed_size_panels) -> bool
+{
+   auto const reference = make_tree(has_fixed_size_panels, [&](u32 index) {
+      return std::string(tree.labels[index]->text());
+   });
+   reference.root->update_layout(window_size);
+
+   for (u64 i = 0; i < std::size(tree.panels); ++i)
+   {
+      if (tree.panels[i]->area() != reference.panels[i]->area())
+      {
+         return false;
+      }
+   }
+
+   for (u64 i = 0; i < std::size(tree.labels); ++i)
+   {
+      if (tree.labels[i]->area() != reference.labels[i]->area())
+      {
+         return false;
+      }
+   }
+
+   return true;
+}
+
+void report(char const* name, std::chrono::nanoseconds total, u64 count)
+{
+   double const milliseconds = std::chrono::duration<double, std::milli>(total).count();
+
+   std::cout << name << " " << label_count
+             << " labels: " << milliseconds / static_cast<double>(count) << " ms\n";
+}
+
+auto run(bool has_fixed_size_panels) -> bool
+{
+   std::cout << (has_fixed_size_panels ? "fixed size panels\n" : "content sized panels\n");
+
+   std::chrono::nanoseconds total{};
+   for (u64 i = 0; i < iteration_count; ++i)
+   {
+      auto const tree = make_tree(has_fixed_size_panels, default_text);
+
+      auto const start = std::chrono::steady_clock::now();
+      tree.root->update_layout(window_size);
+      total += std::chrono::steady_clock::now() - start;
+   }
+
+   report("   full layout", total, iteration_count);
+
+   auto tree = make_tree(has_fixed_size_panels, default_text);
+   tree.root->update_layout(window_size);
+
+   total = {};
+   for (u64 i = 0; i < iteration_count; ++i)
+   {
+      // The grids are measured again with new constraints
+      layout::extent const size = {.width = window_size.width - static_cast<u32>(i % 2),
+                                   .height = window_size.height};
+
+      auto const start = std::chrono::steady_clock::now();
+      tree.root->update_layout(size);
+      total += std::chrono::steady_clock::now() - start;
+   }
+
+   tree.root->update_layout(window_size);
+
+   report("   resize", total, iteration_count);
+
+   total = {};
+   for (u64 i = 0; i < text_change_count; ++i)
+   {
+      // Spread the changes over the panels, and change the size of the text every time
+      u32 const index = static_cast<u32>((i * 7919) % label_count); // NOLINT
+      auto& label = *tree.labels[index];
+      label.set_text(std::string(label.text()) + "!");
+
+      auto const start = std::chrono::steady_clock::now();
+      tree.root->update_layout(window_size);
+      total += std::chrono::steady_clock::now() - start;
+   }
+
+   report("   label text change", total, text_change_count);
+
+   if (!matches_full_layout(tree, has_fixed_size_panels))
+   {
+      std::cerr << "incremental layout differs from the full layout\n";
+
+      return false;
+   }
+
+   return true;
+}
+
+auto main() -> int
+{
+   if (!run(false) || !run(true))
+   {
+      return EXIT_FAILURE;
+   }
+
+   return EXIT_SUCCESS;
+}
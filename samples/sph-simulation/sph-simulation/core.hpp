@@ -15,6 +15,7 @@
 #include <execution>
 #include <filesystem>
 #include <numbers>
+#include <span>
 
 #define IS_GCC (defined(__GNUC__) && !defined(__clang__))
 #define IS_CLANG defined(__clang__)
@@ -35,6 +36,22 @@ auto parallel_for(Range&& range, Fun&& fun)
                         std::forward<Fun>(fun));
 }
 
+/**
+ * @brief 64 bit FNV-1a hash of `bytes`. Passing the result of a previous call as `seed` hashes the
+ * concatenation of both inputs.
+ */
+inline auto hash_bytes(std::span<const std::byte> bytes,
+                       std::uint64_t seed = 0xcbf29ce484222325) noexcept -> std::uint64_t // NOLINT
+{
+   for (const std::byte byte : bytes)
+   {
+      seed ^= static_cast<std::uint64_t>(byte);
+      seed *= 0x100000001b3; // NOLINT
+   }
+
+   return seed;
+}
+
 static constexpr std::uint32_t image_width = 1920;
 static constexpr std::uint32_t image_height = 1080;
 
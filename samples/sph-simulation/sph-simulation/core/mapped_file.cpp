@@ -0,0 +1,100 @@
+#include <sph-simulation/core/mapped_file.hpp>
+
+#include <magic_enum.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+using namespace reglisse;
+
+mapped_file::mapped_file(void* p_data, mannele::u64 size) : mp_data(p_data), m_size(size) {}
+mapped_file::mapped_file(mapped_file&& other) noexcept :
+   mp_data(std::exchange(other.mp_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+{}
+mapped_file::~mapped_file()
+{
+   if (mp_data)
+   {
+      munmap(mp_data, m_size);
+   }
+}
+
+auto mapped_file::operator=(mapped_file&& rhs) noexcept -> mapped_file&
+{
+   if (this != &rhs)
+   {
+      if (mp_data)
+      {
+         munmap(mp_data, m_size);
+      }
+
+      mp_data = std::exchange(rhs.mp_data, nullptr);
+      m_size = std::exchange(rhs.m_size, 0);
+   }
+
+   return *this;
+}
+
+auto mapped_file::data() const noexcept -> std::span<const std::byte>
+{
+   return data_as<std::byte>();
+}
+
+auto map_file(const filepath& path) -> result<mapped_file, mapped_file_error>
+{
+   const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC); // NOLINT
+   if (fd == -1)
+   {
+      return err(mapped_file_error::failed_to_open_file);
+   }
+
+   struct stat file_stats
+   {
+   };
+   if (fstat(fd, &file_stats) == -1)
+   {
+      close(fd);
+
+      return err(mapped_file_error::failed_to_open_file);
+   }
+
+   const auto size = static_cast<mannele::u64>(file_stats.st_size);
+   if (size == 0)
+   {
+      close(fd);
+
+      return ok(mapped_file{});
+   }
+
+   void* p_data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+   // The mapping keeps its own reference to the file
+   close(fd);
+
+   if (p_data == MAP_FAILED) // NOLINT
+   {
+      return err(mapped_file_error::failed_to_map_file);
+   }
+
+   return ok(mapped_file{p_data, size});
+}
+
+struct mapped_file_error_category : std::error_category
+{
+   [[nodiscard]] auto name() const noexcept -> const char* override { return "mapped_file"; }
+   [[nodiscard]] auto message(int err) const -> std::string override
+   {
+      return std::string(magic_enum::enum_name(static_cast<mapped_file_error>(err)));
+   }
+};
+
+static const mapped_file_error_category mapped_file_error_cat{};
+
+auto make_error_condition(mapped_file_error err) -> std::error_condition
+{
+   return std::error_condition({static_cast<int>(err), mapped_file_error_cat});
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <sph-simulation/core.hpp>
+
+#include <libmannele/core.hpp>
+
+#include <libreglisse/result.hpp>
+
+#include <span>
+
+enum struct mapped_file_error
+{
+   failed_to_open_file,
+   failed_to_map_file
+};
+
+auto make_error_condition(mapped_file_error err) -> std::error_condition;
+
+/**
+ * @brief Read-only memory mapping of a whole file. The content is paged in by the OS on access
+ * instead of being copied in a user space buffer.
+ */
+class mapped_file
+{
+public:
+   mapped_file() = default;
+   mapped_file(const mapped_file&) = delete;
+   mapped_file(mapped_file&& other) noexcept;
+   ~mapped_file();
+
+   auto operator=(const mapped_file&) -> mapped_file& = delete;
+   auto operator=(mapped_file&& rhs) noexcept -> mapped_file&;
+
+   [[nodiscard]] auto data() const noexcept -> std::span<const std::byte>;
+
+   /**
+    * @brief View the content of the file as an array of `Any`. Mappings are page aligned, so any
+    * fundamental alignment is satisfied.
+    */
+   template <typename Any>
+   [[nodiscard]] auto data_as() const noexcept -> std::span<const Any>
+   {
+      // NOLINTNEXTLINE
+      return {reinterpret_cast<const Any*>(mp_data), m_size / sizeof(Any)};
+   }
+
+   friend auto map_file(const filepath& path) -> reglisse::result<mapped_file, mapped_file_error>;
+
+private:
+   mapped_file(void* p_data, mannele::u64 size);
+
+   void* mp_data{nullptr};
+   mannele::u64 m_size{};
+};
+
+auto map_file(const filepath& path) -> reglisse::result<mapped_file, mapped_file_error>;
@@ -149,12 +149,13 @@ namespace detail
           .pPushConstantRanges = std::data(push_constants)});
    }
 
-   auto create_graphics_pipeline(const cacao::device& device, const render_pass& render_pass,
-                                 vk::PipelineLayout layout,
+   auto create_graphics_pipeline(const cacao::device& device, vk::PipelineCache cache,
+                                 const render_pass& render_pass, vk::PipelineLayout layout,
                                  std::span<const pipeline_shader_data> shader_infos,
                                  std::span<vk::VertexInputBindingDescription> bindings,
                                  std::span<vk::VertexInputAttributeDescription> attributes,
                                  std::span<vk::Viewport> viewports, std::span<vk::Rect2D> scissors,
+                                 std::span<const vk::DynamicState> dynamic_states,
                                  mannele::log_ptr logger) -> vk::UniquePipeline
    {
       const auto logical = device.logical();
@@ -162,6 +163,10 @@ namespace detail
       std::vector<vk::PipelineShaderStageCreateInfo> shader_stage_info{};
       shader_stage_info.reserve(std::size(shader_infos));
 
+      // Stages point into it, it must not reallocate
+      std::vector<vk::SpecializationInfo> specialization_infos{};
+      specialization_infos.reserve(std::size(shader_infos));
+
       mannele::u64 vertex_shader_index{std::numeric_limits<std::size_t>::max()};
       for (std::uint32_t index = 0; const auto& info : shader_infos)
       {
@@ -169,7 +174,10 @@ namespace detail
             vk::PipelineShaderStageCreateInfo{}
                .setPNext(nullptr)
                .setFlags({})
-               .setPSpecializationInfo(nullptr)
+               .setPSpecializationInfo(info.specialization.is_empty()
+                                          ? nullptr
+                                          : &specialization_infos.emplace_back(
+                                               info.specialization.info()))
                .setStage(detail::to_shader_stage_flag(info.p_shader->type()))
                .setModule(info.p_shader->module())
                .setPName("main"));
@@ -244,6 +252,10 @@ namespace detail
             .setPAttachments(&colour_blend_attachment_state)
             .setBlendConstants({0.0F, 0.0F, 0.0F, 0.0F});
 
+      const vk::PipelineDynamicStateCreateInfo dynamic_state_create_info{
+         .dynamicStateCount = static_cast<std::uint32_t>(std::size(dynamic_states)),
+         .pDynamicStates = std::data(dynamic_states)};
+
       const auto info = vk::GraphicsPipelineCreateInfo{}
                            .setPNext(nullptr)
                            .setFlags({})
@@ -256,18 +268,23 @@ namespace detail
                            .setPMultisampleState(&multisample_state_create_info)
                            .setPColorBlendState(&colour_blend_state_create_info)
                            .setPDepthStencilState(&depth_stencil_create_info)
+                           .setPDynamicState(std::empty(dynamic_states)
+                                                ? nullptr
+                                                : &dynamic_state_create_info)
                            .setLayout(layout)
                            .setRenderPass(render_pass.value())
                            .setSubpass(0)
                            .setBasePipelineHandle(nullptr);
 
-      return logical.createGraphicsPipelineUnique(nullptr, info).value;
+      return logical.createGraphicsPipelineUnique(cache, info).value;
    }
 
-   auto create_compute_pipeline(const cacao::device& device, vk::PipelineLayout layout,
-                                const pipeline_shader_data& shader_info) -> vk::UniquePipeline
+   auto create_compute_pipeline(const cacao::device& device, vk::PipelineCache cache,
+                                vk::PipelineLayout layout, const pipeline_shader_data& shader_info)
+      -> vk::UniquePipeline
    {
       const auto logical = device.logical();
+      const auto specialization_info = shader_info.specialization.info();
 
       const auto info = vk::ComputePipelineCreateInfo{
          .flags = {},
@@ -276,17 +293,39 @@ namespace detail
                    .stage = detail::to_shader_stage_flag(shader_info.p_shader->type()),
                    .module = shader_info.p_shader->module(),
                    .pName = "main",
-                   .pSpecializationInfo = nullptr},
+                   .pSpecializationInfo = shader_info.specialization.is_empty()
+                      ? nullptr
+                      : &specialization_info},
          .layout = layout,
          .basePipelineHandle = nullptr};
 
-      return logical.createComputePipelineUnique(nullptr, info).value;
+      return logical.createComputePipelineUnique(cache, info).value;
    }
 
 } // namespace detail
 
 ///////////////////////////////////////////////
 
+auto specialization_data::is_empty() const noexcept -> bool
+{
+   return std::empty(m_entries);
+}
+
+auto specialization_data::info() const noexcept -> vk::SpecializationInfo
+{
+   return {.mapEntryCount = static_cast<mannele::u32>(std::size(m_entries)),
+           .pMapEntries = std::data(m_entries),
+           .dataSize = std::size(m_data),
+           .pData = std::data(m_data)};
+}
+
+auto specialization_data::hash() const noexcept -> mannele::u64
+{
+   return hash_bytes(m_data, hash_bytes(std::as_bytes(std::span(m_entries))));
+}
+
+///////////////////////////////////////////////
+
 detail::pipeline_base::pipeline_base(const cacao::device& device,
                                      std::span<const pipeline_shader_data> shader_infos,
                                      mannele::log_ptr logger) :
@@ -295,8 +334,10 @@ detail::pipeline_base::pipeline_base(const cacao::device& device,
    m_push_constants(detail::populate_push_constants(shader_infos)),
    m_pipeline_layout(detail::create_pipeline_layout(device, m_set_layouts, m_push_constants))
 {}
-detail::pipeline_base::pipeline_base(const cacao::device&, const pipeline_shader_data&,
-                                     mannele::log_ptr)
+detail::pipeline_base::pipeline_base(const cacao::device& device,
+                                     const pipeline_shader_data& shader_info,
+                                     mannele::log_ptr logger) :
+   pipeline_base(device, std::span(&shader_info, 1), logger)
 {}
 
 [[nodiscard]] auto detail::pipeline_base::layout() const noexcept -> vk::PipelineLayout
@@ -7,7 +7,9 @@
 #include <libcacao/device.hpp>
 #include <libcacao/shader.hpp>
 
+#include <cstring>
 #include <span>
+#include <type_traits>
 
 using vertex_bindings_array = std::vector<vk::VertexInputBindingDescription>;
 using vertex_attributes_array = std::vector<vk::VertexInputAttributeDescription>;
@@ -39,11 +41,60 @@ struct push_constant_data
    mannele::u64 offset{};
 };
 
+/**
+ * @brief Values of the specialization constants of a shader stage, packed the way
+ * VkSpecializationInfo expects them. Constants are baked in the pipeline at creation, letting the
+ * driver fold loops and arithmetic that depend on them.
+ */
+class specialization_data
+{
+public:
+   /**
+    * @brief Give a value to the constant declared with `layout(constant_id = id)`. Booleans must
+    * be passed as VkBool32.
+    */
+   template <typename Any>
+   auto set(mannele::u32 constant_id, const Any& value) -> specialization_data&
+      requires(std::is_trivially_copyable_v<Any> && !std::is_same_v<Any, bool>)
+   {
+      const auto offset = std::size(m_data);
+
+      m_data.resize(offset + sizeof(Any));
+      std::memcpy(std::data(m_data) + offset, &value, sizeof(Any));
+
+      m_entries.push_back({.constantID = constant_id,
+                           .offset = static_cast<mannele::u32>(offset),
+                           .size = sizeof(Any)});
+
+      return *this;
+   }
+
+   [[nodiscard]] auto is_empty() const noexcept -> bool;
+
+   /**
+    * @brief The returned info points into this object and is only valid as long as it is neither
+    * modified nor destroyed.
+    */
+   [[nodiscard]] auto info() const noexcept -> vk::SpecializationInfo;
+
+   /**
+    * @brief Hash of the constant ids and values, two shader stages with the same module and hash
+    * produce the same pipeline.
+    */
+   [[nodiscard]] auto hash() const noexcept -> mannele::u64;
+
+private:
+   std::vector<vk::SpecializationMapEntry> m_entries;
+   std::vector<std::byte> m_data;
+};
+
 struct pipeline_shader_data
 {
    cacao::shader* p_shader{nullptr};
    std::vector<set_layout_data> set_layouts{};
    std::vector<push_constant_data> push_constants{};
+
+   specialization_data specialization{};
 };
 
 struct graphics_pipeline_create_info
@@ -51,6 +102,8 @@ struct graphics_pipeline_create_info
    const cacao::device& device;
    const render_pass& pass;
 
+   vk::PipelineCache cache{};
+
    mannele::log_ptr logger{};
 
    vertex_bindings_array bindings{};
@@ -59,6 +112,12 @@ struct graphics_pipeline_create_info
    std::vector<vk::Viewport> viewports{};
    std::vector<vk::Rect2D> scissors{};
 
+   /**
+    * @brief States set while recording instead of baked in the pipeline. A dynamic viewport and
+    * scissor let the pipeline outlive a resize of the framebuffers it renders to.
+    */
+   std::vector<vk::DynamicState> dynamic_states{};
+
    std::vector<pipeline_shader_data> shader_infos{};
 };
 
@@ -66,6 +125,8 @@ struct compute_pipeline_create_info
 {
    const cacao::device& device;
 
+   vk::PipelineCache cache{};
+
    pipeline_shader_data shader_info{};
 
    mannele::log_ptr logger{};
@@ -100,16 +161,17 @@ namespace detail
       vk::UniquePipelineLayout m_pipeline_layout{nullptr};
    };
 
-   auto create_graphics_pipeline(const cacao::device& device, const render_pass& render_pass,
-                                 vk::PipelineLayout layout,
+   auto create_graphics_pipeline(const cacao::device& device, vk::PipelineCache cache,
+                                 const render_pass& render_pass, vk::PipelineLayout layout,
                                  std::span<const pipeline_shader_data> shader_infos,
                                  std::span<vk::VertexInputBindingDescription> bindings,
                                  std::span<vk::VertexInputAttributeDescription> attributes,
                                  std::span<vk::Viewport> viewports, std::span<vk::Rect2D> scissors,
+                                 std::span<const vk::DynamicState> dynamic_states,
                                  mannele::log_ptr logger) -> vk::UniquePipeline;
 
-   auto create_compute_pipeline(const cacao::device& device, vk::PipelineLayout layout,
-                                const pipeline_shader_data& shader_info)
+   auto create_compute_pipeline(const cacao::device& device, vk::PipelineCache cache,
+                                vk::PipelineLayout layout, const pipeline_shader_data& shader_info)
       -> vk::UniquePipeline;
 } // namespace detail
 
@@ -123,15 +185,17 @@ public:
    explicit pipeline(graphics_pipeline_create_info&& info) requires(Type ==
                                                                     pipeline_type::graphics) :
       base(info.device, info.shader_infos, info.logger),
-      m_pipeline(detail::create_graphics_pipeline(info.device, info.pass, base::layout(),
-                                                  info.shader_infos, info.bindings, info.attributes,
-                                                  info.viewports, info.scissors, info.logger))
+      m_pipeline(detail::create_graphics_pipeline(info.device, info.cache, info.pass,
+                                                  base::layout(), info.shader_infos, info.bindings,
+                                                  info.attributes, info.viewports, info.scissors,
+                                                  info.dynamic_states, info.logger))
    {
       info.logger.debug("graphics pipeline created");
    }
    explicit pipeline(compute_pipeline_create_info&& info) requires(Type == pipeline_type::compute) :
       base(info.device, info.shader_info, info.logger),
-      m_pipeline(detail::create_compute_pipeline(info.device, base::layout(), info.shader_info))
+      m_pipeline(detail::create_compute_pipeline(info.device, info.cache, base::layout(),
+                                                 info.shader_info))
    {
       info.logger.debug("compute pipeline created");
    }
@@ -3,15 +3,126 @@
 #include <libreglisse/operations/transform_err.hpp>
 #include <libreglisse/try.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <utility>
 
 using namespace reglisse;
 
-pipeline_registry::pipeline_registry(mannele::log_ptr logger) : m_logger{logger} {}
+void describe_count(std::vector<std::byte>& description, std::size_t count)
+{
+   const auto value = static_cast<mannele::u64>(count);
+   const auto bytes = std::as_bytes(std::span(&value, 1));
+
+   description.insert(std::end(description), std::begin(bytes), std::end(bytes));
+}
+
+/**
+ * @brief Append `values` to `description`, prefixed by their count so that neighbouring arrays
+ * and names can never be mistaken for one another.
+ */
+template <typename Any>
+void describe_values(std::vector<std::byte>& description, std::span<Any> values)
+{
+   const auto bytes = std::as_bytes(values);
+
+   describe_count(description, std::size(values));
+   description.insert(std::end(description), std::begin(bytes), std::end(bytes));
+}
+
+void describe_shader_stages(std::vector<std::byte>& description,
+                            std::span<const pipeline_shader_data> shader_infos)
+{
+   for (const auto& info : shader_infos)
+   {
+      const auto module =
+         std::bit_cast<mannele::u64>(static_cast<VkShaderModule>(info.p_shader->module()));
+      describe_values(description, std::span(&module, 1));
+
+      const auto specialization = info.specialization.info();
+      describe_values(description,
+                      std::span(specialization.pMapEntries, specialization.mapEntryCount));
+      describe_values(description,
+                      std::span(static_cast<const std::byte*>(specialization.pData),
+                                specialization.dataSize));
+
+      describe_count(description, std::size(info.set_layouts));
+      for (const auto& set_layout : info.set_layouts)
+      {
+         describe_values(description, std::span(set_layout.name));
+         describe_values(description, std::span(set_layout.bindings));
+      }
+
+      describe_count(description, std::size(info.push_constants));
+      for (const auto& push_constant : info.push_constants)
+      {
+         const std::array range{push_constant.size, push_constant.offset};
+         describe_values(description, std::span(push_constant.name));
+         describe_values(description, std::span(range));
+      }
+   }
+}
+
+auto describe_variant(const graphics_pipeline_create_info& info) -> std::vector<std::byte>
+{
+   const auto pass = std::bit_cast<mannele::u64>(static_cast<VkRenderPass>(info.pass.value()));
+
+   std::vector<std::byte> description;
+   describe_values(description, std::span(&pass, 1));
+   describe_values(description, std::span(info.bindings));
+   describe_values(description, std::span(info.attributes));
+   describe_values(description, std::span(info.viewports));
+   describe_values(description, std::span(info.scissors));
+   describe_values(description, std::span(info.dynamic_states));
+   describe_shader_stages(description, info.shader_infos);
+
+   return description;
+}
+
+auto describe_variant(const compute_pipeline_create_info& info) -> std::vector<std::byte>
+{
+   std::vector<std::byte> description;
+   describe_shader_stages(description, std::span(&info.shader_info, 1));
+
+   return description;
+}
+
+pipeline_registry::pipeline_registry(const cacao::pipeline_cache& cache, mannele::log_ptr logger) :
+   mp_cache{&cache}, m_logger{logger}
+{}
+
+auto pipeline_registry::find_variant(const variant_map& variants, mannele::u64 hash,
+                                     std::span<const std::byte> description)
+   -> reglisse::maybe<key_type>
+{
+   const auto [first, last] = variants.equal_range(hash);
+   for (auto it = first; it != last; ++it)
+   {
+      if (std::ranges::equal(it->second.description, description))
+      {
+         return some(it->second.key);
+      }
+   }
+
+   return none;
+}
 
 auto pipeline_registry::insert(graphics_pipeline_create_info&& info)
    -> reglisse::result<insert_kv<pipeline_type::graphics>, pipeline_registry_error>
 {
+   info.cache = mp_cache->value();
+
+   auto description = describe_variant(info);
+   const auto variant = hash_bytes(description);
+   if (const auto existing = find_variant(m_graphics_variants, variant, description))
+   {
+      m_logger.debug("graphics pipeline variant {:#x} reused", variant);
+
+      const key_type key = existing.borrow();
+      return ok(insert_kv{key, &m_graphics_pipelines.at(key)});
+   }
+
    auto gfx = pipeline<pipeline_type::graphics>(std::move(info));
    const std::size_t key = id_counter++;
 
@@ -20,8 +131,39 @@ auto pipeline_registry::insert(graphics_pipeline_create_info&& info)
       return err(pipeline_registry_error::failed_to_insert_pipeline);
    }
 
+   m_graphics_variants.emplace(
+      variant, variant_entry{.description = std::move(description), .key = key});
+
    return ok(insert_kv{key_type{key}, &m_graphics_pipelines.at(key)});
 }
+auto pipeline_registry::insert(compute_pipeline_create_info&& info)
+   -> reglisse::result<insert_kv<pipeline_type::compute>, pipeline_registry_error>
+{
+   info.cache = mp_cache->value();
+
+   auto description = describe_variant(info);
+   const auto variant = hash_bytes(description);
+   if (const auto existing = find_variant(m_compute_variants, variant, description))
+   {
+      m_logger.debug("compute pipeline variant {:#x} reused", variant);
+
+      const key_type key = existing.borrow();
+      return ok(insert_kv{key, &m_compute_pipelines.at(key)});
+   }
+
+   auto compute = pipeline<pipeline_type::compute>(std::move(info));
+   const std::size_t key = id_counter++;
+
+   if (auto [it, res] = m_compute_pipelines.try_emplace(key, std::move(compute)); !res)
+   {
+      return err(pipeline_registry_error::failed_to_insert_pipeline);
+   }
+
+   m_compute_variants.emplace(
+      variant, variant_entry{.description = std::move(description), .key = key});
+
+   return ok(insert_kv{key_type{key}, &m_compute_pipelines.at(key)});
+}
 
 struct pipeline_registry_error_category : std::error_category
 {
@@ -3,6 +3,9 @@
 #include <sph-simulation/core.hpp>
 #include <sph-simulation/core/pipeline.hpp>
 
+#include <libcacao/pipeline_cache.hpp>
+
+#include <libreglisse/maybe.hpp>
 #include <libreglisse/operations/transform_err.hpp>
 #include <libreglisse/try.hpp>
 
@@ -16,6 +19,12 @@ enum struct pipeline_registry_error
 
 auto make_error_condition(pipeline_registry_error err) -> std::error_condition;
 
+/**
+ * @brief Own every pipeline of the application. Pipelines are cached per variant: inserting a
+ * pipeline whose state, shaders and specialization constant values match one already in the
+ * registry hands back the existing pipeline instead of creating another. Set layout and push
+ * constant names are part of the variant, since pipelines are queried by them.
+ */
 class pipeline_registry
 {
    using graphics_map = std::unordered_map<std::size_t, pipeline<pipeline_type::graphics>>;
@@ -24,6 +33,20 @@ class pipeline_registry
 public:
    using key_type = mannele::u64;
 
+private:
+   /**
+    * @brief Every value the pipeline of `key` was created from, compared on lookup since two
+    * variants may share a hash.
+    */
+   struct variant_entry
+   {
+      std::vector<std::byte> description;
+      key_type key;
+   };
+
+   using variant_map = std::unordered_multimap<mannele::u64, variant_entry>;
+
+public:
    template <pipeline_type Type>
    class lookup_v
    {
@@ -65,7 +88,11 @@ public:
    };
 
 public:
-   pipeline_registry(mannele::log_ptr logger);
+   /**
+    * @param cache Pipeline cache shared by every pipeline inserted in the registry. Must outlive
+    * the registry.
+    */
+   pipeline_registry(const cacao::pipeline_cache& cache, mannele::log_ptr logger);
 
    auto insert(graphics_pipeline_create_info&& info)
       -> reglisse::result<insert_kv<pipeline_type::graphics>, pipeline_registry_error>;
@@ -112,6 +139,9 @@ public:
             remove_v res{std::move(it->second)};
 
             m_graphics_pipelines.erase(key);
+            std::erase_if(m_graphics_variants, [&](const auto& kv) {
+               return kv.second.key == key;
+            });
 
             return ok(std::move(res));
          }
@@ -123,7 +153,10 @@ public:
          {
             remove_v res{std::move(it->second)};
 
-            m_graphics_pipelines.erase(key);
+            m_compute_pipelines.erase(key);
+            std::erase_if(m_compute_variants, [&](const auto& kv) {
+               return kv.second.key == key;
+            });
 
             return ok(std::move(res));
          }
@@ -133,9 +166,19 @@ public:
    }
 
 private:
+   static auto find_variant(const variant_map& variants, mannele::u64 hash,
+                            std::span<const std::byte> description) -> reglisse::maybe<key_type>;
+
+private:
+   const cacao::pipeline_cache* mp_cache{nullptr};
+
    graphics_map m_graphics_pipelines;
    compute_map m_compute_pipelines;
 
+   // Variant hash to the description and key of the pipeline created for it
+   variant_map m_graphics_variants;
+   variant_map m_compute_variants;
+
    mannele::log_ptr m_logger;
 
    mannele::u64 id_counter{0};
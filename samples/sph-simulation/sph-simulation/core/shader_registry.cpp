@@ -1,11 +1,14 @@
 #include <sph-simulation/core/shader_registry.hpp>
 
+#include <sph-simulation/core/mapped_file.hpp>
+
 #include <libreglisse/operations/transform_err.hpp>
 #include <libreglisse/try.hpp>
 
 #include <magic_enum.hpp>
 
-#include <fstream>
+#include <exception>
+#include <utility>
 
 using namespace reglisse;
 
@@ -16,31 +19,57 @@ shader_registry::shader_registry(cacao::device& device, mannele::log_ptr logger)
 auto shader_registry::insert(const filepath& path, cacao::shader_type type)
    -> result<insert_kv, shader_registry_error>
 {
-   using file_it = std::istreambuf_iterator<char>;
-
-   std::ifstream file{asset_default_dir / path, std::ios::binary};
-   if (!file.is_open())
+   return insert_shader(path, type);
+}
+auto shader_registry::insert_all(std::span<const shader_load_info> infos)
+   -> std::vector<result<insert_kv, shader_registry_error>>
+{
+   std::vector<result<insert_kv, shader_registry_error>> results;
+   results.reserve(std::size(infos));
+   for ([[maybe_unused]] const auto& info : infos)
    {
-      return err(shader_registry_error::failed_to_open_file);
+      results.emplace_back(err(shader_registry_error::failed_to_insert_shader));
    }
 
-   const std::vector<uint8_t> raw_shader_data{file_it{file}, file_it{}};
+   // Reflection and module creation dominate, each shader is independent of the others
+   parallel_for(infos, [&](const shader_load_info& info) {
+      const auto index = static_cast<std::size_t>(&info - std::data(infos));
 
-   spirv_binary data{};
-   data.resize(raw_shader_data.size() / sizeof(std::uint32_t));
+      results[index] = insert_shader(info.path, info.type);
+   });
 
-   std::memcpy(static_cast<void*>(data.data()), raw_shader_data.data(),
-               sizeof(std::uint32_t) * data.size());
+   return results;
+}
 
-   const auto [it, res] = m_shaders.try_emplace(path.string(),
-                                                cacao::shader({.device = m_device,
-                                                               .name = path.string(),
-                                                               .type = type,
-                                                               .binary = data,
-                                                               .logger = m_logger}));
-   if (res)
+auto shader_registry::insert_shader(const filepath& path, cacao::shader_type type)
+   -> result<insert_kv, shader_registry_error>
+{
+   // insert_all() runs in a parallel algorithm, where an escaping exception terminates the program
+   try
+   {
+      auto file = map_file(asset_default_dir / path);
+      if (file.is_err())
+      {
+         return err(shader_registry_error::failed_to_open_file);
+      }
+
+      auto shader = cacao::shader({.device = m_device,
+                                   .name = path.string(),
+                                   .type = type,
+                                   .binary = file.borrow().data_as<mannele::u32>(),
+                                   .logger = m_logger});
+
+      std::scoped_lock lock{m_mutex};
+
+      const auto [it, res] = m_shaders.try_emplace(path.string(), std::move(shader));
+      if (res)
+      {
+         return ok(insert_kv(it->first, &it->second));
+      }
+   }
+   catch (const std::exception& e)
    {
-      return ok(insert_kv(it->first, &it->second));
+      m_logger.error("Failed to create shader {}: {}", path.string(), e.what());
    }
 
    return err(shader_registry_error::failed_to_insert_shader);
@@ -5,7 +5,10 @@
 #include <libcacao/shader.hpp>
 
 #include <filesystem>
+#include <mutex>
+#include <span>
 #include <string>
+#include <vector>
 
 enum struct shader_registry_error
 {
@@ -18,6 +21,12 @@ auto make_error_condition(shader_registry_error err) -> std::error_condition;
 
 using spirv_binary = std::vector<mannele::u32>;
 
+struct shader_load_info
+{
+   filepath path;
+   cacao::shader_type type;
+};
+
 class shader_registry
 {
    using shader_map = std::unordered_map<std::string, cacao::shader>;
@@ -68,11 +77,23 @@ public:
 
    auto insert(const filepath& path, cacao::shader_type type)
       -> reglisse::result<insert_kv, shader_registry_error>;
+   /**
+    * @brief Load, reflect and create the modules of multiple shaders in parallel.
+    *
+    * @return The result of each insertion, in the same order as `infos`.
+    */
+   auto insert_all(std::span<const shader_load_info> infos)
+      -> std::vector<reglisse::result<insert_kv, shader_registry_error>>;
    auto lookup(const key_type& key) -> reglisse::result<lookup_v, shader_registry_error>;
    auto remove(const key_type& key) -> reglisse::result<remove_v, shader_registry_error>;
 
+private:
+   auto insert_shader(const filepath& path, cacao::shader_type type)
+      -> reglisse::result<insert_kv, shader_registry_error>;
+
 private:
    shader_map m_shaders;
+   std::mutex m_mutex;
 
    cacao::device& m_device;
 
@@ -2,7 +2,10 @@
 
 #include <sph-simulation/sim_config_parser.hpp>
 
+#include <sph-simulation/render/mesh_cache.hpp>
+
 #include <libmannele/logging/logger.hpp>
+#include <libmannele/tracing/trace.hpp>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/span.hpp>
@@ -34,9 +37,55 @@ auto main(int argc, char** argv) -> int
       return EXIT_FAILURE;
    }
 
+   // Compile meshes to their binary cache ahead of time instead of on first load
+   if (arguments[0] == "--compile-meshes")
+   {
+      int exit_code = EXIT_SUCCESS;
+      for (const auto path : arguments | ranges::views::tail)
+      {
+         if (auto size = compile_mesh(path, mesh_cache_path(path), &logger))
+         {
+            logger.info("Compiled mesh {} ({} bytes)", path, size.borrow());
+         }
+         else
+         {
+            logger.error("Failed to compile mesh {}: {}", path,
+                         make_error_condition(size.borrow_err()).message());
+
+            exit_code = EXIT_FAILURE;
+         }
+      }
+
+      return exit_code;
+   }
+
+   // An optional second argument is where the trace of the whole run is written
+   const bool is_tracing = std::size(arguments) > 1;
+   if (is_tracing)
+   {
+      mannele::start_tracing();
+      mannele::set_trace_thread_name("main");
+   }
+
    if (auto config = parse_sim_config_json(arguments[0]))
    {
-      return start_simulation({.config = config.borrow(), .logger = &logger});
+      const int exit_code = start_simulation({.config = config.borrow(), .logger = &logger});
+
+      if (is_tracing)
+      {
+         mannele::stop_tracing();
+
+         if (auto written = mannele::write_chrome_trace(arguments[1]))
+         {
+            logger.info("Wrote {} trace events to {}", written.value(), arguments[1]);
+         }
+         else
+         {
+            logger.warning("Failed to write the trace to {}", arguments[1]);
+         }
+      }
+
+      return exit_code;
    }
 
    logger.error("Failed to parse json: {}", arguments[0]);
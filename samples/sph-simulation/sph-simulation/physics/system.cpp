@@ -4,6 +4,8 @@
 #include <sph-simulation/physics/collision/colliders.hpp>
 #include <sph-simulation/physics/collision/contact.hpp>
 
+#include <libmannele/tracing/trace.hpp>
+
 #include <entt/entt.hpp>
 
 #include <glm/gtx/rotate_vector.hpp>
@@ -72,11 +74,15 @@ namespace physics
 
    auto detect_collisions(const system_update_info& info)
    {
+      MANNELE_TRACE_ZONE_CAT("physics::detect_collisions", "physics");
+
       return detect_sphere_and_plane_collision(info.spheres, info.planes);
    }
 
    void update(const system_update_info& info)
    {
+      MANNELE_TRACE_ZONE_CAT("physics::update", "physics");
+
       const auto contacts = detect_collisions(info);
 
       for (auto contact_data : contacts)
@@ -2,8 +2,8 @@
 
 #include <sph-simulation/core/pipeline.hpp>
 
-#include <libcacao/buffer.hpp>
-#include <libcacao/descriptor_pool.hpp>
+#include <libcacao/descriptor_allocator.hpp>
+#include <libcacao/uniform_ring_buffer.hpp>
 
 #include <glm/mat4x4.hpp>
 
@@ -11,8 +11,9 @@ struct camera_create_info
 {
    const cacao::device& device;
    const cacao::descriptor_set_layout& layout;
+   const cacao::uniform_ring_buffer& uniforms;
 
-   mannele::u32 image_count{};
+   cacao::descriptor_allocator& descriptors;
 
    mannele::log_ptr logger{};
 };
@@ -36,14 +37,18 @@ public:
    camera() = default;
    camera(const camera_create_info& info);
 
-   void update(mannele::u64 image_index, const matrices& matrices);
+   /**
+    * @brief Write the camera matrices into the current frame's region of the uniform ring buffer.
+    */
+   void update(cacao::uniform_ring_buffer& uniforms, const matrices& matrices);
 
-   auto lookup_set(mannele::u64 image_index) -> vk::DescriptorSet;
+   [[nodiscard]] auto descriptor_set() const -> vk::DescriptorSet;
+   [[nodiscard]] auto dynamic_offset() const noexcept -> mannele::u32;
 
 private:
-   std::vector<cacao::buffer> m_uniform_buffers;
+   vk::DescriptorSet m_descriptor_set;
 
-   cacao::descriptor_pool m_descriptor_pool;
+   mannele::u32 m_dynamic_offset{};
 
-   vk::Device m_device;
+   mannele::log_ptr m_logger;
 };
@@ -43,23 +43,6 @@ auto find_supported_formats(std::span<const vk::Format> candidates, vk::ImageTil
    return none;
 }
 
-auto find_memory_type(uint32_t type_filter, const vk::MemoryPropertyFlags& properties,
-                      vk::PhysicalDevice device) -> maybe<std::uint32_t>
-{
-   const auto memory_properties = device.getMemoryProperties();
-
-   for (uint32_t i = 0; i < memory_properties.memoryTypeCount; i++)
-   {
-      if ((type_filter & (1 << i)) &&
-          (memory_properties.memoryTypes[i].propertyFlags & properties) == properties)
-      {
-         return some(i);
-      }
-   }
-
-   return none;
-}
-
 auto to_image_aspect_flag(const vk::ImageUsageFlags& flags) noexcept -> vk::ImageAspectFlagBits
 {
    if ((flags & vk::ImageUsageFlagBits::eColorAttachment) ==
@@ -86,7 +69,6 @@ image::image(const image_create_info& info) :
    m_usage(info.usage), m_memory_properties(info.memory_properties), m_dimensions(info.dimensions)
 {
    const auto logical = info.device.logical();
-   const auto physical = info.device.physical();
    const auto format_feature_flag = to_format_feature_flags(m_usage);
 
    if (auto fmt = find_supported_formats(info.formats, m_tiling, format_feature_flag, info.device))
@@ -111,18 +93,13 @@ image::image(const image_create_info& info) :
        .sharingMode = vk::SharingMode::eExclusive,
        .initialLayout = vk::ImageLayout::eUndefined});
 
-   const auto memory_reqs = logical.getImageMemoryRequirements(m_image.get());
-   if (auto type = find_memory_type(memory_reqs.memoryTypeBits, m_memory_properties, physical))
-   {
-      m_memory = logical.allocateMemoryUnique(
-         {.allocationSize = memory_reqs.size, .memoryTypeIndex = type.borrow()});
-   }
-   else
-   {
-      throw cacao::runtime_error({});
-   }
+   m_allocation = info.allocator.allocate(
+      {.requirements = logical.getImageMemoryRequirements(m_image.get()),
+       .desired_mem_flags = m_memory_properties,
+       .fallback_mem_flags = m_memory_properties,
+       .is_linear = m_tiling == vk::ImageTiling::eLinear});
 
-   logical.bindImageMemory(m_image.get(), m_memory.get(), 0);
+   logical.bindImageMemory(m_image.get(), m_allocation.memory(), m_allocation.offset());
 
    m_view = logical.createImageViewUnique({.image = m_image.get(),
                                            .viewType = vk::ImageViewType::e2D,
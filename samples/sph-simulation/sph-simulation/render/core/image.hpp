@@ -1,6 +1,7 @@
 #ifndef SPH_SIMULATION_RENDER_IMAGE_HPP
 #define SPH_SIMULATION_RENDER_IMAGE_HPP
 
+#include <libcacao/allocator.hpp>
 #include <libcacao/device.hpp>
 
 #include <libmannele/dimension.hpp>
@@ -8,6 +9,7 @@
 struct image_create_info
 {
    const cacao::device& device;
+   cacao::allocator& allocator;
 
    std::vector<vk::Format> formats;
 
@@ -32,8 +34,8 @@ public:
    [[nodiscard]] auto subresource_layers() const -> vk::ImageSubresourceLayers;
 
 private:
+   cacao::memory_allocation m_allocation;
    vk::UniqueImage m_image;
-   vk::UniqueDeviceMemory m_memory;
    vk::UniqueImageView m_view;
 
    vk::Format m_fmt{};
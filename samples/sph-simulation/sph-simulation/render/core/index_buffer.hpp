@@ -2,16 +2,17 @@
 #define SPH_SIMULATION_RENDER_CORE_INDEX_BUFFER_HPP_
 
 #include <libcacao/buffer.hpp>
-#include <libcacao/command_pool.hpp>
 #include <libcacao/device.hpp>
 #include <libcacao/export.hpp>
+#include <libcacao/upload_service.hpp>
 
 #include <libmannele/core.hpp>
 
 struct LIBCACAO_SYMEXPORT index_buffer_create_info
 {
    const cacao::device& device;
-   const cacao::command_pool& pool;
+   cacao::allocator& allocator;
+   cacao::upload_service& uploads;
 
    std::span<const mannele::u32> indices;
 
@@ -1,5 +1,7 @@
 #include <sph-simulation/render/core/render_pass.hpp>
 
+#include <libmannele/tracing/trace.hpp>
+
 #include <libreglisse/try.hpp>
 
 #include <range/v3/view/iota.hpp>
@@ -8,11 +10,12 @@ using mannele::u64;
 
 namespace vi = ranges::views;
 
-render_pass::render_pass(render_pass_create_info&& info)
+render_pass::render_pass(render_pass_create_info&& info) :
+   mp_profiler(info.p_profiler), m_name(std::move(info.name))
 {
    m_render_pass = create_render_pass(info);
    m_framebuffers = create_framebuffers(info);
-   m_buff_calls = [](vk::CommandBuffer, u64) {}; // NOLINT
+   m_buff_calls = [](vk::CommandBuffer, u64, render_slice) {}; // NOLINT
 }
 
 auto render_pass::value() const -> vk::RenderPass
@@ -20,7 +23,16 @@ auto render_pass::value() const -> vk::RenderPass
    return m_render_pass.get();
 }
 
-void render_pass::record_render_calls(const std::function<void(vk::CommandBuffer, u64)>& calls)
+void render_pass::record_render_calls(const render_calls& calls)
+{
+   m_buff_calls = [calls](vk::CommandBuffer buffer, u64 image_index, render_slice slice) {
+      if (slice.index == 0)
+      {
+         std::invoke(calls, buffer, image_index);
+      }
+   };
+}
+void render_pass::record_parallel_render_calls(const parallel_render_calls& calls)
 {
    m_buff_calls = calls;
 }
@@ -31,6 +43,8 @@ void render_pass::submit_render_calls(vk::CommandBuffer buffer, mannele::u64 ima
 {
    // assert(image_index < std::size(m_framebuffers)); // NOLINT
 
+   const auto scope = mp_profiler ? mp_profiler->scope(buffer, m_name) : cacao::gpu_scope{};
+
    buffer.beginRenderPass({.pNext = nullptr,
                            .renderPass = m_render_pass.get(),
                            .framebuffer = m_framebuffers.at(image_index).value(),
@@ -39,46 +53,99 @@ void render_pass::submit_render_calls(vk::CommandBuffer buffer, mannele::u64 ima
                            .pClearValues = std::data(clear_colours)},
                           vk::SubpassContents::eInline);
 
-   std::invoke(m_buff_calls, buffer, image_index);
+   std::invoke(m_buff_calls, buffer, image_index, render_slice{});
+
+   buffer.endRenderPass();
+}
+void render_pass::submit_render_calls(vk::CommandBuffer buffer, mannele::u64 image_index,
+                                      vk::Rect2D render_area,
+                                      std::span<const vk::ClearValue> clear_colours,
+                                      std::span<const vk::CommandBuffer> secondary_buffers)
+{
+   if (std::empty(secondary_buffers))
+   {
+      submit_render_calls(buffer, image_index, render_area, clear_colours);
+
+      return;
+   }
+
+   const auto framebuffer = m_framebuffers.at(image_index).value();
+   const vk::CommandBufferInheritanceInfo inheritance{
+      .renderPass = m_render_pass.get(), .subpass = 0, .framebuffer = framebuffer};
+
+   parallel_for(secondary_buffers, [&](const vk::CommandBuffer& secondary) {
+      MANNELE_TRACE_ZONE_CAT("render_pass::record_secondary", "render");
+
+      const auto index = static_cast<u64>(&secondary - std::data(secondary_buffers));
+
+      secondary.begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit |
+                          vk::CommandBufferUsageFlagBits::eRenderPassContinue,
+                       .pInheritanceInfo = &inheritance});
+
+      std::invoke(m_buff_calls, secondary, image_index,
+                  render_slice{.index = index, .count = std::size(secondary_buffers)});
+
+      secondary.end();
+   });
+
+   // Timestamps can't be written inside a render pass executing secondary command buffers
+   const auto scope = mp_profiler ? mp_profiler->scope(buffer, m_name) : cacao::gpu_scope{};
+
+   buffer.beginRenderPass({.pNext = nullptr,
+                           .renderPass = m_render_pass.get(),
+                           .framebuffer = framebuffer,
+                           .renderArea = render_area,
+                           .clearValueCount = static_cast<std::uint32_t>(std::size(clear_colours)),
+                           .pClearValues = std::data(clear_colours)},
+                          vk::SubpassContents::eSecondaryCommandBuffers);
+
+   buffer.executeCommands(secondary_buffers);
 
    buffer.endRenderPass();
 }
 
 auto render_pass::create_render_pass(const render_pass_create_info& info) -> vk::UniqueRenderPass
 {
-   std::array<vk::AttachmentDescription, 2> attachment_descriptions{};
+   std::vector<vk::AttachmentDescription> attachment_descriptions;
+
+   vk::AttachmentReference colour_ref{};
+   vk::AttachmentReference depth_stencil_ref{};
 
    if (info.colour_attachment)
    {
-      attachment_descriptions[0] = info.colour_attachment.borrow();
+      colour_ref = {.attachment = static_cast<std::uint32_t>(std::size(attachment_descriptions)),
+                    .layout = vk::ImageLayout::eColorAttachmentOptimal};
+      attachment_descriptions.push_back(info.colour_attachment.borrow());
    }
 
    if (info.depth_stencil_attachment)
    {
-      attachment_descriptions[1] = info.depth_stencil_attachment.borrow();
+      depth_stencil_ref = {
+         .attachment = static_cast<std::uint32_t>(std::size(attachment_descriptions)),
+         .layout = vk::ImageLayout::eDepthStencilAttachmentOptimal};
+      attachment_descriptions.push_back(info.depth_stencil_attachment.borrow());
    }
 
-   const vk::AttachmentReference colour_ref{.attachment = 0,
-                                            .layout = vk::ImageLayout::eColorAttachmentOptimal};
-   const vk::AttachmentReference depth_stencil_ref{
-      .attachment = 1, .layout = vk::ImageLayout::eDepthStencilAttachmentOptimal};
-
    const std::vector<vk::SubpassDescription> descriptions{
       {.pipelineBindPoint = vk::PipelineBindPoint::eGraphics,
-       .colorAttachmentCount = 1,
-       .pColorAttachments = &colour_ref,
-       .pDepthStencilAttachment = &depth_stencil_ref}};
-
-   const std::vector<vk::SubpassDependency> dependencies{
-      {.srcSubpass = VK_SUBPASS_EXTERNAL,
-       .dstSubpass = 0,
-       .srcStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput |
-          vk::PipelineStageFlagBits::eEarlyFragmentTests,
-       .dstStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput |
-          vk::PipelineStageFlagBits::eEarlyFragmentTests,
-       .srcAccessMask = {},
-       .dstAccessMask = vk::AccessFlagBits::eColorAttachmentWrite |
-          vk::AccessFlagBits::eDepthStencilAttachmentWrite}};
+       .colorAttachmentCount = info.colour_attachment ? 1U : 0U,
+       .pColorAttachments = info.colour_attachment ? &colour_ref : nullptr,
+       .pDepthStencilAttachment = info.depth_stencil_attachment ? &depth_stencil_ref : nullptr}};
+
+   std::vector<vk::SubpassDependency> dependencies;
+   if (!info.is_synchronized_externally)
+   {
+      dependencies.push_back(
+         {.srcSubpass = VK_SUBPASS_EXTERNAL,
+          .dstSubpass = 0,
+          .srcStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+             vk::PipelineStageFlagBits::eEarlyFragmentTests,
+          .dstStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput |
+             vk::PipelineStageFlagBits::eEarlyFragmentTests,
+          .srcAccessMask = {},
+          .dstAccessMask = vk::AccessFlagBits::eColorAttachmentWrite |
+             vk::AccessFlagBits::eDepthStencilAttachmentWrite});
+   }
 
    return info.device.logical().createRenderPassUnique(
       {.attachmentCount = static_cast<std::uint32_t>(std::size(attachment_descriptions)),
@@ -4,27 +4,72 @@
 #include <sph-simulation/render/core/framebuffer.hpp>
 
 #include <libcacao/device.hpp>
+#include <libcacao/gpu_profiler.hpp>
 
 #include <libmannele/core.hpp>
 
 #include <libreglisse/maybe.hpp>
 
+#include <functional>
 #include <span>
+#include <string>
 
 struct render_pass_create_info
 {
-   cacao::device& device;
+   const cacao::device& device;
 
    reglisse::maybe<vk::AttachmentDescription> colour_attachment;
    reglisse::maybe<vk::AttachmentDescription> depth_stencil_attachment;
 
    std::vector<framebuffer_create_info> framebuffer_create_infos{};
 
+   /**
+    * @brief Skip the subpass dependency on previous work. The owner of the render pass is then
+    * responsible for the barriers around it, as done by the render_graph.
+    */
+   bool is_synchronized_externally{false};
+
+   /**
+    * @brief Profiler measuring the GPU time of the render pass under `name`, if any.
+    */
+   cacao::gpu_profiler* p_profiler{nullptr};
+   std::string name{};
+
    mannele::log_ptr logger{nullptr};
 };
 
+/**
+ * @brief The part of the render calls handled by one recording thread. Calls are split in `count`
+ * slices recorded concurrently in separate secondary command buffers.
+ */
+struct render_slice
+{
+   mannele::u64 index{0};
+   mannele::u64 count{1};
+
+   /**
+    * @brief First element of a list of `size` elements belonging to the slice.
+    */
+   [[nodiscard]] constexpr auto first(mannele::u64 size) const noexcept -> mannele::u64
+   {
+      return size * index / count;
+   }
+   /**
+    * @brief One past the last element of a list of `size` elements belonging to the slice.
+    */
+   [[nodiscard]] constexpr auto last(mannele::u64 size) const noexcept -> mannele::u64
+   {
+      return size * (index + 1) / count;
+   }
+};
+
 class render_pass
 {
+public:
+   using render_calls = std::function<void(vk::CommandBuffer, mannele::u64)>;
+   using parallel_render_calls =
+      std::function<void(vk::CommandBuffer, mannele::u64, render_slice)>;
+
 public:
    render_pass() = default;
    /**
@@ -42,15 +87,30 @@ public:
    auto value() const -> vk::RenderPass; // NOLINT
 
    /**
-    * @brief
+    * @brief Set render calls that can only be recorded from a single thread. When recording in
+    * parallel, they are recorded by the first slice.
     */
-   void record_render_calls(const std::function<void(vk::CommandBuffer, mannele::u64)>& calls);
+   void record_render_calls(const render_calls& calls);
+   /**
+    * @brief Set render calls that can be split in slices recorded concurrently. Each slice must
+    * bind all the state it needs since secondary command buffers do not inherit it.
+    */
+   void record_parallel_render_calls(const parallel_render_calls& calls);
 
    /**
-    * @brief
+    * @brief Record the render pass and its render calls inline in `buffer`. The render pass is
+    * wrapped in a profiler scope when created with a profiler, as with the parallel version.
     */
    void submit_render_calls(vk::CommandBuffer buffer, mannele::u64 framebuffer_index,
                             vk::Rect2D render_area, std::span<const vk::ClearValue> clear_colours);
+   /**
+    * @brief Record the render calls in parallel, one slice per secondary command buffer, and
+    * execute them from the render pass in `buffer`. Every secondary buffer must come from a
+    * different command pool since pools may not be used from multiple threads at once.
+    */
+   void submit_render_calls(vk::CommandBuffer buffer, mannele::u64 framebuffer_index,
+                            vk::Rect2D render_area, std::span<const vk::ClearValue> clear_colours,
+                            std::span<const vk::CommandBuffer> secondary_buffers);
 
 private:
    auto create_render_pass(const render_pass_create_info& info) -> vk::UniqueRenderPass;
@@ -61,5 +121,8 @@ private:
 
    std::vector<framebuffer> m_framebuffers;
 
-   std::function<void(vk::CommandBuffer, mannele::u64)> m_buff_calls;
+   cacao::gpu_profiler* mp_profiler{nullptr};
+   std::string m_name;
+
+   parallel_render_calls m_buff_calls;
 };
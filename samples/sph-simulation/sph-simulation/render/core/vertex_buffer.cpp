@@ -4,38 +4,16 @@ auto create_buffer(const vertex_buffer_create_info& info) -> cacao::buffer
 {
    const mannele::u64 size = sizeof(vertex) * std::size(info.vertices);
 
-   auto staging_buffer =
-      cacao::buffer({.device = info.device,
-                     .buffer_size = size,
-                     .usage = vk::BufferUsageFlagBits::eTransferSrc,
-                     .desired_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible |
-                        vk::MemoryPropertyFlagBits::eHostCoherent,
-                     .logger = info.logger});
-
-   {
-      void* p_data = info.device.logical().mapMemory(staging_buffer.memory(), 0, size, {});
-      memcpy(p_data, info.vertices.data(), size);
-      info.device.logical().unmapMemory(staging_buffer.memory());
-   }
-
    auto vertex_buffer = cacao::buffer(
       {.device = info.device,
+       .allocator = info.allocator,
        .buffer_size = size,
        .usage = vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eVertexBuffer,
        .desired_mem_flags = vk::MemoryPropertyFlagBits::eDeviceLocal,
        .logger = info.logger});
 
-   const auto cmd_buffer = create_standalone_command_buffers(
-      info.device, info.pool, cacao::command_buffer_level::primary, 1);
-   cmd_buffer[0]->begin({.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
-   cmd_buffer[0]->copyBuffer(staging_buffer.value(), vertex_buffer.value(),
-                             {vk::BufferCopy{.size = size}});
-   cmd_buffer[0]->end();
-
-   const auto queue = info.device.find_best_suited_queue(cacao::queue_flag_bits::transfer).value;
-   queue.submit({vk::SubmitInfo{.commandBufferCount = 1, .pCommandBuffers = &cmd_buffer[0].get()}},
-                nullptr);
-   queue.waitIdle();
+   info.uploads.upload(vertex_buffer, info.vertices, 0, vk::AccessFlagBits::eVertexAttributeRead,
+                       vk::PipelineStageFlagBits::eVertexInput);
 
    return vertex_buffer;
 }
@@ -4,13 +4,14 @@
 #include <sph-simulation/data_types/vertex.hpp>
 
 #include <libcacao/buffer.hpp>
-#include <libcacao/command_pool.hpp>
 #include <libcacao/export.hpp>
+#include <libcacao/upload_service.hpp>
 
 struct LIBCACAO_SYMEXPORT vertex_buffer_create_info
 {
    const cacao::device& device;
-   const cacao::command_pool& pool;
+   cacao::allocator& allocator;
+   cacao::upload_service& uploads;
 
    std::span<const vertex> vertices;
 
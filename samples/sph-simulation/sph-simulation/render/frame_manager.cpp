@@ -1,74 +1,96 @@
 #include <sph-simulation/render/frame_manager.hpp>
 
 #include <libmannele/core.hpp>
+#include <libmannele/tracing/trace.hpp>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/generate_n.hpp>
 #include <range/v3/view/iota.hpp>
 
+#include <algorithm>
+#include <utility>
+
 namespace rv = ranges::views;
 
 using namespace reglisse;
 
+auto create_swapchain(const cacao::device& device, vk::SurfaceKHR surface,
+                      vk::ImageUsageFlags usage, const mannele::dimension_u32& dimension,
+                      cacao::swapchain* p_old_swapchain, mannele::log_ptr logger)
+   -> cacao::swapchain;
 auto create_render_finished_semaphores(const cacao::device& device, mannele::u64 count)
    -> std::vector<vk::UniqueSemaphore>;
-auto create_image_available_semaphores(const cacao::device& device)
-   -> std::array<vk::UniqueSemaphore, max_frames_in_flight>;
-auto create_in_flight_fences(const cacao::device& device)
-   -> std::array<vk::UniqueFence, max_frames_in_flight>;
+auto create_frame_semaphores(const cacao::device& device, mannele::u32 count)
+   -> std::vector<vk::UniqueSemaphore>;
+auto create_frame_timeline(const cacao::device& device, mannele::log_ptr logger)
+   -> vk::UniqueSemaphore;
 
 frame_manager::frame_manager(const frame_manager_create_info& info) :
-   m_logger(info.logger), mp_device(&info.device),
-   m_swapchain(cacao::swapchain_create_info{
-      .device = *mp_device,
-      .surface = info.surface,
-      .desired_formats = {{vk::Format::eB8G8R8A8Srgb, vk::ColorSpaceKHR::eSrgbNonlinear}},
-      .desired_present_modes = {vk::PresentModeKHR::eMailbox, vk::PresentModeKHR::eFifo},
-      .desired_dimensions = info.window.dimension(),
-      .graphics_queue_index = 0,
-      .present_queue_index = 0,
-      .image_usage_flags = info.image_usage,
-      .composite_alpha_flags = vk::CompositeAlphaFlagBitsKHR::eOpaque,
-      .should_clip = true,
-      .old_swapchain = nullptr,
-      .logger = m_logger}),
+   m_logger(info.logger), mp_window(&info.window), mp_device(&info.device),
+   m_surface(info.surface), m_image_usage(info.image_usage),
+   m_swapchain(create_swapchain(*mp_device, m_surface, m_image_usage,
+                                mp_window->framebuffer_dimension(), nullptr, m_logger)),
+   m_swapchain_dimension(mp_window->framebuffer_dimension()),
+   m_frames_in_flight(std::max(1U, info.frames_in_flight)),
    m_render_finished_semaphores(
       create_render_finished_semaphores(*mp_device, std::size(m_swapchain.image_views()))),
-   m_image_available_semaphores(create_image_available_semaphores(*mp_device)),
-   m_in_flight_fences(create_in_flight_fences(*mp_device)),
-   m_depth_image({.device = info.device,
-                  .formats = {std::begin(depth_formats), std::end(depth_formats)},
-                  .tiling = vk::ImageTiling::eOptimal,
-                  .usage = vk::ImageUsageFlagBits::eDepthStencilAttachment,
-                  .memory_properties = vk::MemoryPropertyFlagBits::eDeviceLocal,
-                  .dimensions = {m_swapchain.extent().width, m_swapchain.extent().height},
-                  .logger = info.logger}
-
-   )
+   m_image_available_semaphores(create_frame_semaphores(*mp_device, m_frames_in_flight)),
+   m_compute_finished_semaphores(create_frame_semaphores(*mp_device, m_frames_in_flight)),
+   m_frame_timeline(create_frame_timeline(*mp_device, m_logger))
 {
-   m_images_in_flight.resize(std::size(m_swapchain.images()));
+   m_images_in_flight.resize(std::size(m_swapchain.images()), 0);
+
+   m_logger.debug("frame manager created with {} frames in flight", m_frames_in_flight);
 }
 
 auto frame_manager::begin_frame() -> reglisse::maybe<frame_data>
 {
+   MANNELE_TRACE_ZONE_CAT("frame_manager::begin_frame", "frame");
+
    const auto device = mp_device->logical();
+   const auto slot_wait_start = clock::now();
 
-   // NOLINTNEXTLINE
-   const auto wait_res = device.waitForFences({m_in_flight_fences[m_current_frame_index].get()},
-                                              true, std::numeric_limits<mannele::u64>::max());
-   if (wait_res != vk::Result::eSuccess)
+   // The slot is free once the frame recorded in it `m_frames_in_flight` frames ago is complete
+   if (m_frame_number >= m_frames_in_flight &&
+       !wait_for_frame(m_frame_number + 1 - m_frames_in_flight))
    {
-      m_logger.error("failed to wait for fence at frame index {}: {}", m_current_frame_index,
-                     vk::to_string(wait_res));
+      return none;
+   }
 
+   m_current_stats = frame_stats{.cpu_wait = clock::now() - slot_wait_start};
+
+   destroy_retired_resources();
+
+   const auto dimension = mp_window->framebuffer_dimension();
+   if (dimension.width == 0 || dimension.height == 0)
+   {
+      // A minimized window has nothing to present to
       return none;
    }
 
-   const auto [image_res, image_index] = device.acquireNextImageKHR(
-      m_swapchain.value(), std::numeric_limits<mannele::u64>::max(),
-      m_image_available_semaphores[m_current_frame_index].get(), nullptr); // NOLINT
+   if (m_is_swapchain_outdated || dimension.width != m_swapchain_dimension.width ||
+       dimension.height != m_swapchain_dimension.height)
+   {
+      recreate_swapchain(dimension);
+   }
 
-   if (image_res != vk::Result::eSuccess)
+   auto acquired = acquire_next_image();
+   if (acquired.result == vk::Result::eErrorOutOfDateKHR)
+   {
+      // The surface changed since the window size was queried, the semaphore was not signaled
+      recreate_swapchain(dimension);
+
+      acquired = acquire_next_image();
+   }
+
+   const auto [image_res, image_index] = acquired;
+
+   if (image_res == vk::Result::eSuboptimalKHR)
+   {
+      // The image can still be presented, the swapchain is recreated on the next frame
+      m_is_swapchain_outdated = true;
+   }
+   else if (image_res != vk::Result::eSuccess)
    {
       m_logger.error("failed to acquire next image: {}", vk::to_string(image_res));
 
@@ -77,47 +99,98 @@ auto frame_manager::begin_frame() -> reglisse::maybe<frame_data>
 
    m_logger.debug(R"(swapchain image "{}" acquired)", image_index);
 
+   // Images may be acquired out of order, so the frame last rendering to the image can be more
+   // recent than the one that used the slot
+   const auto image_wait_start = clock::now();
+   if (!wait_for_frame(m_images_in_flight.at(image_index)))
+   {
+      return none;
+   }
+
+   m_current_stats.cpu_wait += clock::now() - image_wait_start;
+
+   if (device.getSemaphoreCounterValue(m_frame_timeline.get()) >= m_frame_number)
+   {
+      // Every submitted frame is complete, the GPU is idle until this one is submitted
+      m_gpu_idle_start = some(clock::now());
+   }
+   else
+   {
+      m_gpu_idle_start = none;
+   }
+
    m_current_image_index = image_index;
 
-   return some(
-      frame_data{.image_index = m_current_image_index, .frame_index = m_current_frame_index});
+   const bool is_swapchain_recreated = std::exchange(m_is_swapchain_recreated, false);
+
+   return some(frame_data{.image_index = m_current_image_index,
+                          .frame_index = m_current_frame_index,
+                          .is_swapchain_recreated = is_swapchain_recreated});
+}
+
+void frame_manager::submit_async_compute(std::span<const vk::CommandBuffer> buffers,
+                                         vk::PipelineStageFlags wait_stages)
+{
+   const std::array signals{cacao::semaphore_signal{
+      .semaphore = m_compute_finished_semaphores.at(m_current_frame_index).get()}};
+
+   m_submissions.add(mp_device->role_queue(cacao::queue_flag_bits::compute),
+                     {.command_buffers = buffers, .signals = signals});
+
+   try
+   {
+      MANNELE_TRACE_ZONE_CAT("frame_manager::submit_async_compute", "frame");
+
+      m_submissions.flush();
+   }
+   catch (const vk::SystemError& err)
+   {
+      m_logger.error("[gfx] failed to submit compute queue");
+
+      std::terminate();
+   }
+
+   // The timeline value of the frame also covers the compute work since graphics waits on it
+   m_compute_wait_stages =
+      wait_stages ? wait_stages : vk::PipelineStageFlags(vk::PipelineStageFlagBits::eTopOfPipe);
 }
 
-// TODO(wmbat): REWORK
 void frame_manager::end_frame(std::span<cacao::command_pool> pools)
 {
-   const auto device = mp_device->logical();
+   const mannele::u64 frame_number = m_frame_number + 1;
+
+   std::array<cacao::semaphore_wait, 2> waits{cacao::semaphore_wait{
+      .semaphore = m_image_available_semaphores.at(m_current_frame_index).get(),
+      .stages = vk::PipelineStageFlagBits::eColorAttachmentOutput}};
+   std::size_t wait_count = 1;
 
-   if (m_images_in_flight.at(m_current_image_index))
+   if (m_compute_wait_stages)
    {
-      [[maybe_unused]] auto _ =
-         device.waitForFences({m_images_in_flight.at(m_current_frame_index)}, true,
-                              std::numeric_limits<std::uint64_t>::max());
+      waits[wait_count++] = {
+         .semaphore = m_compute_finished_semaphores.at(m_current_frame_index).get(),
+         .stages = m_compute_wait_stages};
+
+      m_compute_wait_stages = {};
    }
-   m_images_in_flight.at(m_current_image_index) =
-      m_in_flight_fences.at(m_current_frame_index).get();
 
-   const std::array wait_semaphores{m_image_available_semaphores.at(m_current_frame_index).get()};
-   const std::array signal_semaphores{m_render_finished_semaphores.at(m_current_image_index).get()};
-   const std::array command_buffers{pools[m_current_frame_index].primary_buffers()[0]};
-   const std::array<vk::PipelineStageFlags, 1> wait_stages{
-      vk::PipelineStageFlagBits::eColorAttachmentOutput};
+   const std::array present_semaphores{
+      m_render_finished_semaphores.at(m_current_image_index).get()};
+   const std::array signals{
+      cacao::semaphore_signal{.semaphore = present_semaphores[0]},
+      cacao::semaphore_signal{.semaphore = m_frame_timeline.get(), .value = some(frame_number)}};
 
-   device.resetFences({m_in_flight_fences.at(m_current_frame_index).get()});
+   const std::array command_buffers{pools[m_current_frame_index].primary_buffers()[0]};
 
-   const std::array submit_infos{
-      vk::SubmitInfo{.waitSemaphoreCount = std::size(wait_semaphores),
-                     .pWaitSemaphores = std::data(wait_semaphores),
-                     .pWaitDstStageMask = std::data(wait_stages),
-                     .commandBufferCount = std::size(command_buffers),
-                     .pCommandBuffers = std::data(command_buffers),
-                     .signalSemaphoreCount = std::size(signal_semaphores),
-                     .pSignalSemaphores = std::data(signal_semaphores)}};
+   m_submissions.add(mp_device->role_queue(cacao::queue_flag_bits::graphics),
+                     {.command_buffers = command_buffers,
+                      .waits = std::span(waits).first(wait_count),
+                      .signals = signals});
 
    try
    {
-      const auto gfx_queue = mp_device->find_best_suited_queue(cacao::queue_flag_bits::graphics);
-      gfx_queue.value.submit(submit_infos, m_in_flight_fences.at(m_current_frame_index).get());
+      MANNELE_TRACE_ZONE_CAT("frame_manager::submit", "frame");
+
+      m_submissions.flush();
    }
    catch (const vk::SystemError& err)
    {
@@ -126,22 +199,49 @@ void frame_manager::end_frame(std::span<cacao::command_pool> pools)
       std::terminate();
    }
 
+   if (m_gpu_idle_start)
+   {
+      m_current_stats.gpu_wait = clock::now() - m_gpu_idle_start.borrow();
+      m_gpu_idle_start = none;
+   }
+
+   m_last_stats = m_current_stats;
+   m_frame_number = frame_number;
+   m_images_in_flight.at(m_current_image_index) = frame_number;
+
    const std::array swapchains{m_swapchain.value()};
 
-   const auto present_queue = mp_device->find_best_suited_queue(cacao::queue_flag_bits::present);
-   if (present_queue.value.presentKHR(
-          vk::PresentInfoKHR{.waitSemaphoreCount = std::size(signal_semaphores),
-                             .pWaitSemaphores = std::data(signal_semaphores),
-                             .swapchainCount = std::size(swapchains),
-                             .pSwapchains = std::data(swapchains),
-                             .pImageIndices = &m_current_image_index}) != vk::Result::eSuccess)
+   const auto& present_queue = mp_device->role_queue(cacao::queue_flag_bits::present);
+
+   vk::Result present_res = vk::Result::eErrorOutOfDateKHR;
+   try
+   {
+      MANNELE_TRACE_ZONE_CAT("frame_manager::present", "frame");
+
+      present_res = present_queue.value.presentKHR(
+         vk::PresentInfoKHR{.waitSemaphoreCount = std::size(present_semaphores),
+                            .pWaitSemaphores = std::data(present_semaphores),
+                            .swapchainCount = std::size(swapchains),
+                            .pSwapchains = std::data(swapchains),
+                            .pImageIndices = &m_current_image_index});
+   }
+   catch (const vk::OutOfDateKHRError& err)
+   {
+      present_res = vk::Result::eErrorOutOfDateKHR;
+   }
+
+   if (present_res == vk::Result::eSuboptimalKHR || present_res == vk::Result::eErrorOutOfDateKHR)
+   {
+      m_is_swapchain_outdated = true;
+   }
+   else if (present_res != vk::Result::eSuccess)
    {
       m_logger.error("[gfx] failed to present present queue");
 
       std::terminate();
    }
 
-   m_current_frame_index = (m_current_frame_index + 1) % max_frames_in_flight;
+   m_current_frame_index = static_cast<mannele::u32>(m_frame_number % m_frames_in_flight);
 }
 
 auto frame_manager::frame_format() const noexcept -> vk::Format
@@ -157,23 +257,139 @@ auto frame_manager::image_count() const noexcept -> mannele::u64
 {
    return std::size(m_swapchain.image_views());
 }
+auto frame_manager::frames_in_flight() const noexcept -> mannele::u32
+{
+   return m_frames_in_flight;
+}
 
-auto frame_manager::get_framebuffer_info() const -> std::vector<framebuffer_create_info>
+auto frame_manager::images() const noexcept -> std::span<const vk::Image>
 {
-   std::vector<framebuffer_create_info> infos;
+   return m_swapchain.images();
+}
+auto frame_manager::image_views() const -> std::vector<vk::ImageView>
+{
+   std::vector<vk::ImageView> views;
+   views.reserve(std::size(m_swapchain.image_views()));
 
-   const auto swap_extent = m_swapchain.extent();
-   for (const auto& image_view : m_swapchain.image_views())
+   for (const auto& view : m_swapchain.image_views())
    {
-      infos.push_back(
-         framebuffer_create_info{.device = mp_device->logical(),
-                                 .attachments = {image_view.get(), m_depth_image.view()},
-                                 .dimensions = {swap_extent.width, swap_extent.height},
-                                 .layers = 1,
-                                 .logger = m_logger});
+      views.push_back(view.get());
    }
 
-   return infos;
+   return views;
+}
+
+auto frame_manager::last_frame_stats() const noexcept -> const frame_stats&
+{
+   return m_last_stats;
+}
+
+auto frame_manager::submissions() noexcept -> cacao::submission_batch&
+{
+   return m_submissions;
+}
+
+auto frame_manager::wait_for_frame(mannele::u64 frame_number) -> bool
+{
+   if (frame_number == 0)
+   {
+      return true;
+   }
+
+   MANNELE_TRACE_ZONE_CAT("frame_manager::wait_for_frame", "frame");
+
+   const auto semaphore = m_frame_timeline.get();
+   const auto wait_res = mp_device->logical().waitSemaphores(
+      vk::SemaphoreWaitInfo{
+         .semaphoreCount = 1, .pSemaphores = &semaphore, .pValues = &frame_number},
+      std::numeric_limits<mannele::u64>::max());
+
+   if (wait_res != vk::Result::eSuccess)
+   {
+      m_logger.error("failed to wait for frame {}: {}", frame_number, vk::to_string(wait_res));
+
+      return false;
+   }
+
+   return true;
+}
+
+auto frame_manager::acquire_next_image() -> vk::ResultValue<mannele::u32>
+{
+   MANNELE_TRACE_ZONE_CAT("frame_manager::acquire_next_image", "frame");
+
+   try
+   {
+      return mp_device->logical().acquireNextImageKHR(
+         m_swapchain.value(), std::numeric_limits<mannele::u64>::max(),
+         m_image_available_semaphores.at(m_current_frame_index).get(), nullptr); // NOLINT
+   }
+   catch (const vk::OutOfDateKHRError& err)
+   {
+      return {vk::Result::eErrorOutOfDateKHR, 0U};
+   }
+}
+
+void frame_manager::recreate_swapchain(const mannele::dimension_u32& dimension)
+{
+   struct retired_swapchain
+   {
+      cacao::swapchain swapchain;
+      std::vector<vk::UniqueSemaphore> render_finished_semaphores;
+   };
+
+   MANNELE_TRACE_ZONE_CAT("frame_manager::recreate_swapchain", "frame");
+
+   auto old_swapchain = std::move(m_swapchain);
+
+   m_swapchain =
+      create_swapchain(*mp_device, m_surface, m_image_usage, dimension, &old_swapchain, m_logger);
+   m_swapchain_dimension = dimension;
+   m_is_swapchain_outdated = false;
+   m_is_swapchain_recreated = true;
+
+   // Presentation may still wait on the semaphore of the last frame once the frame completes, the
+   // next frame submitted to the queue completing guarantees it doesn't
+   m_retired.push_back({.frame_number = m_frame_number + 1,
+                        .resource = std::make_shared<retired_swapchain>(
+                           retired_swapchain{.swapchain = std::move(old_swapchain),
+                                             .render_finished_semaphores =
+                                                std::move(m_render_finished_semaphores)})});
+
+   m_render_finished_semaphores =
+      create_render_finished_semaphores(*mp_device, std::size(m_swapchain.image_views()));
+   m_images_in_flight.assign(std::size(m_swapchain.images()), 0);
+
+   m_logger.info("swapchain recreated at {}x{}", dimension.width, dimension.height);
+}
+
+void frame_manager::destroy_retired_resources()
+{
+   const auto completed = mp_device->logical().getSemaphoreCounterValue(m_frame_timeline.get());
+
+   std::erase_if(m_retired, [&](const retired_resource& retired) {
+      return retired.frame_number <= completed;
+   });
+}
+
+auto create_swapchain(const cacao::device& device, vk::SurfaceKHR surface,
+                      vk::ImageUsageFlags usage, const mannele::dimension_u32& dimension,
+                      cacao::swapchain* p_old_swapchain, mannele::log_ptr logger)
+   -> cacao::swapchain
+{
+   return cacao::swapchain(cacao::swapchain_create_info{
+      .device = device,
+      .surface = surface,
+      .desired_formats = {{vk::Format::eB8G8R8A8Srgb, vk::ColorSpaceKHR::eSrgbNonlinear}},
+      .desired_present_modes = {vk::PresentModeKHR::eMailbox, vk::PresentModeKHR::eFifo},
+      .desired_dimensions = dimension,
+      .graphics_queue_index = 0,
+      .present_queue_index = 0,
+      .image_usage_flags = usage,
+      .composite_alpha_flags = vk::CompositeAlphaFlagBitsKHR::eOpaque,
+      .should_clip = true,
+      .old_swapchain = p_old_swapchain,
+      .logger = logger});
 }
 
 auto create_render_finished_semaphores(const cacao::device& device, mannele::u64 count)
@@ -186,27 +402,28 @@ auto create_render_finished_semaphores(const cacao::device& device, mannele::u64
    return rv::generate_n(create, count) | ranges::to_vector;
 }
 
-auto create_image_available_semaphores(const cacao::device& device)
-   -> std::array<vk::UniqueSemaphore, max_frames_in_flight>
+auto create_frame_semaphores(const cacao::device& device, mannele::u32 count)
+   -> std::vector<vk::UniqueSemaphore>
 {
-   std::array<vk::UniqueSemaphore, max_frames_in_flight> semaphores;
-
-   for (auto& semaphore : semaphores)
-   {
-      semaphore = device.logical().createSemaphoreUnique({});
-   }
+   const auto create = [&] {
+      return device.logical().createSemaphoreUnique({});
+   };
 
-   return semaphores;
+   return rv::generate_n(create, count) | ranges::to_vector;
 }
 
-auto create_in_flight_fences(const cacao::device& device)
-   -> std::array<vk::UniqueFence, max_frames_in_flight>
+auto create_frame_timeline(const cacao::device& device, mannele::log_ptr logger)
+   -> vk::UniqueSemaphore
 {
-   std::array<vk::UniqueFence, max_frames_in_flight> fences;
-   for (auto& fence : fences)
+   if (!device.has_timeline_semaphores())
    {
-      fence = device.logical().createFenceUnique({.flags = vk::FenceCreateFlagBits::eSignaled});
+      logger.error("[gfx] frame pacing requires a device with timeline semaphores");
+
+      std::terminate();
    }
 
-   return fences;
+   const vk::SemaphoreTypeCreateInfo type_info{.semaphoreType = vk::SemaphoreType::eTimeline,
+                                               .initialValue = 0};
+
+   return device.logical().createSemaphoreUnique({.pNext = &type_info});
 }
@@ -1,10 +1,10 @@
 #ifndef SPH_SIMULATION_RENDER_FRAME_MANAGER_HPP
 #define SPH_SIMULATION_RENDER_FRAME_MANAGER_HPP
 
-#include <sph-simulation/render/core/framebuffer.hpp>
-#include <sph-simulation/render/core/image.hpp>
+#include <sph-simulation/core.hpp>
 
 #include <libcacao/command_pool.hpp>
+#include <libcacao/submission_batch.hpp>
 #include <libcacao/swapchain.hpp>
 #include <libcacao/window.hpp>
 
@@ -13,7 +13,10 @@
 
 #include <libreglisse/maybe.hpp>
 
-static constexpr std::size_t max_frames_in_flight = 2;
+#include <chrono>
+#include <memory>
+#include <type_traits>
+
 static constexpr std::size_t expected_image_count = 3;
 
 struct frame_manager_create_info
@@ -22,7 +25,13 @@ struct frame_manager_create_info
    cacao::device& device;
    vk::SurfaceKHR surface;
 
-   vk::ImageUsageFlags image_usage; 
+   vk::ImageUsageFlags image_usage;
+
+   /**
+    * @brief How many frames may be recorded while the GPU is still executing previous ones. The
+    * device must be created with timeline semaphores.
+    */
+   mannele::u32 frames_in_flight{2};
 
    mannele::log_ptr logger;
 };
@@ -31,40 +40,147 @@ struct frame_data
 {
    mannele::u32 image_index;
    mannele::u32 frame_index;
+
+   /**
+    * @brief The swapchain was recreated before the image was acquired, so every resource created
+    * from the previous swapchain images must be recreated.
+    */
+   bool is_swapchain_recreated{false};
 };
 
+/**
+ * @brief Time spent waiting on either side of the queue for a single frame.
+ */
+struct frame_stats
+{
+   /**
+    * @brief Time the CPU was blocked in begin_frame() waiting for the GPU to release a frame slot
+    * or the acquired swapchain image. High values mean the queue is deep enough to be GPU bound.
+    */
+   std::chrono::duration<float, std::milli> cpu_wait{};
+   /**
+    * @brief Time the GPU had no frame left to execute while the CPU was recording this one, as
+    * observed from the CPU. It is a lower bound, high values mean the GPU is starved.
+    */
+   std::chrono::duration<float, std::milli> gpu_wait{};
+};
+
+/**
+ * @brief Paces the frames submitted to the swapchain.
+ *
+ * Frame completion is tracked with a single timeline semaphore signaled with the frame number by
+ * each graphics submission, so waiting for a frame slot or a swapchain image to be released is a
+ * wait on a value instead of a per frame fence.
+ *
+ * The swapchain is recreated at the start of a frame when the window was resized or the last
+ * acquire or present reported it suboptimal or out of date. The old swapchain is handed to the new
+ * one and destroyed along with its semaphores once the frames using it are complete, without
+ * waiting for the device to be idle.
+ */
 class frame_manager
 {
 public:
    frame_manager() = default;
    frame_manager(const frame_manager_create_info& info);
 
+   /**
+    * @brief Wait for the frame slot to be free and acquire the next swapchain image.
+    *
+    * @return none when no image can be rendered to, such as while the window is minimized.
+    */
    auto begin_frame() -> reglisse::maybe<frame_data>;
+   /**
+    * @brief Submit the async compute work of the current frame on the compute queue. The graphics
+    * submission of the frame made by end_frame() waits on it at `wait_stages`, while the graphics
+    * work of the previous frame may still be running.
+    */
+   void submit_async_compute(std::span<const vk::CommandBuffer> buffers,
+                             vk::PipelineStageFlags wait_stages);
    void end_frame(std::span<cacao::command_pool> pools);
 
    [[nodiscard]] auto frame_format() const noexcept -> vk::Format;
    [[nodiscard]] auto extent() const noexcept -> const vk::Extent2D;
    [[nodiscard]] auto image_count() const noexcept -> mannele::u64;
+   [[nodiscard]] auto frames_in_flight() const noexcept -> mannele::u32;
+
+   [[nodiscard]] auto images() const noexcept -> std::span<const vk::Image>;
+   [[nodiscard]] auto image_views() const -> std::vector<vk::ImageView>;
+
+   /**
+    * @brief Wait statistics of the last frame submitted by end_frame().
+    */
+   [[nodiscard]] auto last_frame_stats() const noexcept -> const frame_stats&;
+
+   /**
+    * @brief Submissions flushed along with the next submission made by submit_async_compute() or
+    * end_frame(), ahead of it.
+    */
+   [[nodiscard]] auto submissions() noexcept -> cacao::submission_batch&;
+
+   /**
+    * @brief Keep `resource` alive until every frame submitted so far is complete.
+    */
+   template <typename Any>
+   void defer_destruction(Any&& resource)
+   {
+      m_retired.push_back(
+         {.frame_number = m_frame_number,
+          .resource = std::make_shared<std::remove_cvref_t<Any>>(std::forward<Any>(resource))});
+   }
+
+private:
+   struct retired_resource
+   {
+      mannele::u64 frame_number{};
+      std::shared_ptr<void> resource;
+   };
+
+   auto wait_for_frame(mannele::u64 frame_number) -> bool;
+   auto acquire_next_image() -> vk::ResultValue<mannele::u32>;
 
-   [[nodiscard]] auto get_framebuffer_info() const -> std::vector<framebuffer_create_info>;
+   void recreate_swapchain(const mannele::dimension_u32& dimension);
+   void destroy_retired_resources();
 
 private:
+   using clock = std::chrono::steady_clock;
+
    mannele::log_ptr m_logger;
 
+   cacao::window* mp_window = nullptr;
    cacao::device* mp_device = nullptr;
+
+   vk::SurfaceKHR m_surface;
+   vk::ImageUsageFlags m_image_usage;
+
    cacao::swapchain m_swapchain;
+   mannele::dimension_u32 m_swapchain_dimension{};
+   bool m_is_swapchain_outdated{false};
+   bool m_is_swapchain_recreated{false}; ///< Not yet reported by begin_frame()
+
+   mannele::u32 m_frames_in_flight{};
 
    std::vector<vk::UniqueSemaphore> m_render_finished_semaphores;
 
-   std::array<vk::UniqueSemaphore, max_frames_in_flight> m_image_available_semaphores;
-   std::array<vk::UniqueFence, max_frames_in_flight> m_in_flight_fences;
+   std::vector<vk::UniqueSemaphore> m_image_available_semaphores;
+   std::vector<vk::UniqueSemaphore> m_compute_finished_semaphores;
 
-   std::vector<vk::Fence> m_images_in_flight{};
+   vk::UniqueSemaphore m_frame_timeline;
+   mannele::u64 m_frame_number{0}; ///< Number of frames submitted, last value signaled
 
-   image m_depth_image{};
+   std::vector<mannele::u64> m_images_in_flight; ///< Frame number last rendering to each image
+
+   vk::PipelineStageFlags m_compute_wait_stages{};
+
+   cacao::submission_batch m_submissions;
 
    mannele::u32 m_current_image_index{};
    mannele::u32 m_current_frame_index{};
+
+   frame_stats m_current_stats{};
+   frame_stats m_last_stats{};
+   reglisse::maybe<clock::time_point> m_gpu_idle_start{reglisse::none};
+
+   std::vector<retired_resource> m_retired;
 };
 
 #endif // SPH_SIMULATION_RENDER_FRAME_MANAGER_HPP
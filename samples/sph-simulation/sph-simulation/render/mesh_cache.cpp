@@ -0,0 +1,370 @@
+#include <sph-simulation/render/mesh_cache.hpp>
+
+#include <sph-simulation/render/mesh_optimizer.hpp>
+#include <sph-simulation/render/renderable.hpp>
+
+#include <libcacao/util/align.hpp>
+
+#include <magic_enum.hpp>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <type_traits>
+
+using namespace reglisse;
+
+using mannele::i64;
+using mannele::u32;
+using mannele::u64;
+
+/**
+ * @brief Layout of the start of every mesh cache file. The vertex and index blobs follow at the
+ * given offsets.
+ */
+struct mesh_cache_header
+{
+   static constexpr u32 current_magic = 0x4D485053; // "SPHM"
+   static constexpr u32 current_version = 2;
+
+   u32 magic{current_magic};
+   u32 version{current_version};
+
+   u64 source_size{};
+   i64 source_mtime{};
+   u64 source_hash{};
+
+   u64 vertex_count{};
+   u64 vertex_offset{};
+   u64 index_count{};
+   u64 index_offset{};
+};
+
+static_assert(std::is_trivially_copyable_v<mesh_cache_header>);
+static_assert(std::is_trivially_copyable_v<vertex>);
+
+static constexpr u64 mesh_blob_alignment = 16;
+
+struct source_stamp
+{
+   u64 size{};
+   i64 mtime{};
+};
+
+auto stamp_source(const filepath& source) -> std::optional<source_stamp>
+{
+   std::error_code error{};
+
+   const auto size = std::filesystem::file_size(source, error);
+   if (error)
+   {
+      return std::nullopt;
+   }
+
+   const auto mtime = std::filesystem::last_write_time(source, error);
+   if (error)
+   {
+      return std::nullopt;
+   }
+
+   return source_stamp{.size = static_cast<u64>(size),
+                       .mtime = static_cast<i64>(mtime.time_since_epoch().count())};
+}
+
+/**
+ * @brief Hash of the content of a file. Empty or unreadable files hash like empty data.
+ */
+auto hash_source(const filepath& source) -> u64
+{
+   auto file = map_file(source);
+   if (file.is_err())
+   {
+      return hash_bytes({});
+   }
+
+   return hash_bytes(file.borrow().data());
+}
+
+/**
+ * @brief Check that `count` elements starting at `offset` fit in the data. Doesn't compute the end
+ * of the blob, which a corrupt header could make overflow.
+ */
+auto is_blob_in_bounds(u64 offset, u64 count, u64 element_size, u64 data_size) -> bool
+{
+   return offset <= data_size && count <= (data_size - offset) / element_size;
+}
+
+auto read_header(std::span<const std::byte> data) -> std::optional<mesh_cache_header>
+{
+   mesh_cache_header header{};
+   if (std::size(data) < sizeof(header))
+   {
+      return std::nullopt;
+   }
+
+   std::memcpy(&header, std::data(data), sizeof(header));
+
+   const bool is_valid = header.magic == mesh_cache_header::current_magic &&
+      header.version == mesh_cache_header::current_version &&
+      header.vertex_offset % mesh_blob_alignment == 0 &&
+      header.index_offset % mesh_blob_alignment == 0 &&
+      is_blob_in_bounds(header.vertex_offset, header.vertex_count, sizeof(vertex),
+                        std::size(data)) &&
+      is_blob_in_bounds(header.index_offset, header.index_count, sizeof(u32), std::size(data));
+
+   return is_valid ? std::optional(header) : std::nullopt;
+}
+
+auto write_cache(const filepath& cache, const mesh_cache_header& header,
+                 const renderable_data& data) -> bool
+{
+   std::error_code error{};
+   if (cache.has_parent_path())
+   {
+      std::filesystem::create_directories(cache.parent_path(), error);
+   }
+
+   auto temp_path = cache;
+   temp_path += ".tmp";
+
+   {
+      auto output = std::ofstream(temp_path, std::ios::binary | std::ios::trunc);
+
+      u64 cursor = 0;
+      const auto write_at = [&](u64 offset, const void* p_data, u64 size) {
+         static constexpr std::array<char, mesh_blob_alignment> padding{};
+
+         output.write(std::data(padding), static_cast<std::streamsize>(offset - cursor));
+         output.write(static_cast<const char*>(p_data), static_cast<std::streamsize>(size));
+
+         cursor = offset + size;
+      };
+
+      write_at(0, &header, sizeof(header));
+      write_at(header.vertex_offset, std::data(data.vertices),
+               std::size(data.vertices) * sizeof(vertex));
+      write_at(header.index_offset, std::data(data.indices),
+               std::size(data.indices) * sizeof(u32));
+
+      if (!output)
+      {
+         return false;
+      }
+   }
+
+   std::filesystem::rename(temp_path, cache, error);
+   if (error)
+   {
+      std::filesystem::remove(temp_path, error);
+
+      return false;
+   }
+
+   return true;
+}
+
+/**
+ * @brief Record a new timestamp in the header of a cache whose source was touched but left
+ * unchanged, so the source is not hashed again on the next load.
+ */
+void restamp_cache(const filepath& cache, mesh_cache_header header, const source_stamp& stamp)
+{
+   header.source_size = stamp.size;
+   header.source_mtime = stamp.mtime;
+
+   auto output = std::fstream(cache, std::ios::binary | std::ios::in | std::ios::out);
+   output.write(reinterpret_cast<const char*>(&header), sizeof(header)); // NOLINT
+}
+
+auto map_cache(mapped_file file) -> result<cached_mesh, mesh_cache_error>
+{
+   const auto header = read_header(file.data());
+   if (!header)
+   {
+      return err(mesh_cache_error::invalid_cache);
+   }
+
+   const auto* p_data = std::data(file.data());
+
+   // NOLINTNEXTLINE
+   const auto* p_vertices = reinterpret_cast<const vertex*>(p_data + header->vertex_offset);
+   // NOLINTNEXTLINE
+   const auto* p_indices = reinterpret_cast<const u32*>(p_data + header->index_offset);
+
+   return ok(cached_mesh{std::move(file),
+                         {p_vertices, header->vertex_count},
+                         {p_indices, header->index_count}});
+}
+
+cached_mesh::cached_mesh(mapped_file file, std::span<const vertex> vertices,
+                         std::span<const mannele::u32> indices) :
+   m_file(std::move(file)),
+   m_vertices(vertices), m_indices(indices)
+{}
+cached_mesh::cached_mesh(std::vector<vertex> vertices, std::vector<mannele::u32> indices) :
+   m_owned_vertices(std::move(vertices)), m_owned_indices(std::move(indices)),
+   m_vertices(m_owned_vertices), m_indices(m_owned_indices)
+{}
+
+auto cached_mesh::vertices() const noexcept -> std::span<const vertex>
+{
+   return m_vertices;
+}
+auto cached_mesh::indices() const noexcept -> std::span<const mannele::u32>
+{
+   return m_indices;
+}
+
+auto mesh_cache_path(const filepath& source) -> filepath
+{
+   auto path = source;
+   path += ".mesh";
+
+   return path;
+}
+
+struct compiled_mesh
+{
+   mesh_cache_header header;
+   renderable_data data;
+};
+
+auto compile_mesh_data(const filepath& source, mannele::log_ptr logger)
+   -> result<compiled_mesh, mesh_cache_error>
+{
+   const auto stamp = stamp_source(source);
+   if (!stamp)
+   {
+      return err(mesh_cache_error::failed_to_load_source);
+   }
+
+   renderable_data data;
+
+   try
+   {
+      data = load_obj(source);
+   }
+   catch (const std::exception&)
+   {
+      return err(mesh_cache_error::failed_to_load_source);
+   }
+
+   const auto stats = optimize_mesh(data);
+
+   logger.info("Mesh {} optimized, ACMR {:.3f} -> {:.3f}", source.string(), stats.acmr_before,
+                stats.acmr_after);
+
+   const u64 vertex_offset = cacao::align_up(sizeof(mesh_cache_header), mesh_blob_alignment);
+   const u64 index_offset = cacao::align_up(
+      vertex_offset + std::size(data.vertices) * sizeof(vertex), mesh_blob_alignment);
+
+   const auto header = mesh_cache_header{.source_size = stamp->size,
+                                         .source_mtime = stamp->mtime,
+                                         .source_hash = hash_source(source),
+                                         .vertex_count = std::size(data.vertices),
+                                         .vertex_offset = vertex_offset,
+                                         .index_count = std::size(data.indices),
+                                         .index_offset = index_offset};
+
+   return ok(compiled_mesh{.header = header, .data = std::move(data)});
+}
+
+auto cache_file_size(const mesh_cache_header& header) -> u64
+{
+   return header.index_offset + header.index_count * sizeof(u32);
+}
+
+auto compile_mesh(const filepath& source, const filepath& cache, mannele::log_ptr logger)
+   -> result<u64, mesh_cache_error>
+{
+   const auto compiled = compile_mesh_data(source, logger);
+   if (compiled.is_err())
+   {
+      return err(compiled.borrow_err());
+   }
+
+   const auto& [header, data] = compiled.borrow();
+   if (!write_cache(cache, header, data))
+   {
+      return err(mesh_cache_error::failed_to_write_cache);
+   }
+
+   return ok(cache_file_size(header));
+}
+
+auto load_mesh(const filepath& source, mannele::log_ptr logger)
+   -> result<cached_mesh, mesh_cache_error>
+{
+   const auto cache = mesh_cache_path(source);
+   const auto stamp = stamp_source(source);
+
+   if (auto file = map_file(cache); file.is_ok())
+   {
+      if (const auto header = read_header(file.borrow().data()))
+      {
+         if (!stamp)
+         {
+            return map_cache(std::move(file).take());
+         }
+
+         if (header->source_size == stamp->size && header->source_mtime == stamp->mtime)
+         {
+            return map_cache(std::move(file).take());
+         }
+
+         if (header->source_size == stamp->size && header->source_hash == hash_source(source))
+         {
+            restamp_cache(cache, *header, *stamp);
+
+            return map_cache(std::move(file).take());
+         }
+      }
+   }
+
+   auto compiled = compile_mesh_data(source, logger);
+   if (compiled.is_err())
+   {
+      return err(compiled.borrow_err());
+   }
+
+   auto [header, data] = std::move(compiled).take();
+
+   if (!write_cache(cache, header, data))
+   {
+      logger.warning("Failed to write the mesh cache {}, using the mesh compiled in memory",
+                     cache.string());
+
+      return ok(cached_mesh(std::move(data.vertices), std::move(data.indices)));
+   }
+
+   logger.info("Compiled mesh {} into {} ({} bytes)", source.string(), cache.string(),
+               cache_file_size(header));
+
+   auto file = map_file(cache);
+   if (file.is_err())
+   {
+      logger.warning("Failed to map the mesh cache {}, using the mesh compiled in memory",
+                     cache.string());
+
+      return ok(cached_mesh(std::move(data.vertices), std::move(data.indices)));
+   }
+
+   return map_cache(std::move(file).take());
+}
+
+struct mesh_cache_error_category : std::error_category
+{
+   [[nodiscard]] auto name() const noexcept -> const char* override { return "mesh_cache"; }
+   [[nodiscard]] auto message(int err) const -> std::string override
+   {
+      return std::string(magic_enum::enum_name(static_cast<mesh_cache_error>(err)));
+   }
+};
+
+static const mesh_cache_error_category mesh_cache_error_cat{};
+
+auto make_error_condition(mesh_cache_error err) -> std::error_condition
+{
+   return std::error_condition({static_cast<int>(err), mesh_cache_error_cat});
+}
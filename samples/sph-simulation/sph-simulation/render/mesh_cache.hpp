@@ -0,0 +1,74 @@
+#pragma once
+
+#include <sph-simulation/core.hpp>
+#include <sph-simulation/core/mapped_file.hpp>
+#include <sph-simulation/data_types/vertex.hpp>
+
+#include <libmannele/core.hpp>
+#include <libmannele/logging/log_ptr.hpp>
+
+#include <libreglisse/result.hpp>
+
+#include <span>
+#include <vector>
+
+enum struct mesh_cache_error
+{
+   failed_to_load_source,
+   failed_to_write_cache,
+   invalid_cache
+};
+
+auto make_error_condition(mesh_cache_error err) -> std::error_condition;
+
+/**
+ * @brief Vertices and indices of a mesh viewed directly inside a memory mapped cache file, ready
+ * to be copied into a staging buffer. Holds the compiled mesh itself when no cache could be
+ * written.
+ */
+class cached_mesh
+{
+public:
+   cached_mesh() = default;
+   cached_mesh(mapped_file file, std::span<const vertex> vertices,
+               std::span<const mannele::u32> indices);
+   cached_mesh(std::vector<vertex> vertices, std::vector<mannele::u32> indices);
+
+   [[nodiscard]] auto vertices() const noexcept -> std::span<const vertex>;
+   [[nodiscard]] auto indices() const noexcept -> std::span<const mannele::u32>;
+
+private:
+   mapped_file m_file;
+
+   // Moving a vector keeps its storage, the views stay valid when the mesh is moved
+   std::vector<vertex> m_owned_vertices;
+   std::vector<mannele::u32> m_owned_indices;
+
+   std::span<const vertex> m_vertices;
+   std::span<const mannele::u32> m_indices;
+};
+
+/**
+ * @brief Path of the binary cache compiled from the mesh at `source`.
+ */
+auto mesh_cache_path(const filepath& source) -> filepath;
+
+/**
+ * @brief Parse the OBJ file at `source`, optimize it for the post-transform cache and write it to
+ * `cache` as a header followed by the vertex and index blobs, each aligned for direct upload. The
+ * cache is keyed by the size, modification time and content hash of the source.
+ */
+auto compile_mesh(const filepath& source, const filepath& cache, mannele::log_ptr logger)
+   -> reglisse::result<mannele::u64, mesh_cache_error>;
+
+/**
+ * @brief Load the mesh at `source` through its binary cache, compiling it first if the cache is
+ * missing or stale.
+ *
+ * A cache whose recorded size and modification time match the source is mapped as is, without
+ * reading the source. The source is only hashed when its timestamp changed, so a touched but
+ * unchanged file doesn't trigger a recompilation. A cache is used as is when its source doesn't
+ * exist, which allows shipping only compiled meshes.
+ */
+auto load_mesh(const filepath& source, mannele::log_ptr logger)
+   -> reglisse::result<cached_mesh, mesh_cache_error>;
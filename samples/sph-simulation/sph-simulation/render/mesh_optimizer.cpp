@@ -0,0 +1,330 @@
+#include <sph-simulation/render/mesh_optimizer.hpp>
+
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <numeric>
+
+using mannele::i64;
+using mannele::u32;
+using mannele::u64;
+
+static constexpr u32 unused_vertex = std::numeric_limits<u32>::max();
+
+auto compute_acmr(std::span<const u32> indices, u64 vertex_count, u32 cache_size) -> float
+{
+   if (std::size(indices) < 3)
+   {
+      return 0.0F;
+   }
+
+   // A vertex is in the cache while fewer than `cache_size` misses happened since it was loaded
+   std::vector<u64> loaded_at(vertex_count, 0);
+
+   u64 misses = 0;
+   for (const u32 index : indices)
+   {
+      if (loaded_at[index] == 0 || misses - loaded_at[index] >= cache_size)
+      {
+         ++misses;
+         loaded_at[index] = misses;
+      }
+   }
+
+   return static_cast<float>(misses) / static_cast<float>(std::size(indices) / 3);
+}
+
+/**
+ * @brief Triangles using each vertex, stored contiguously per vertex.
+ */
+struct vertex_adjacency
+{
+   std::vector<u32> offsets;
+   std::vector<u32> triangles;
+
+   [[nodiscard]] auto of(u32 vertex) const -> std::span<const u32>
+   {
+      return std::span(triangles).subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+   }
+};
+
+auto build_adjacency(std::span<const u32> indices, u64 vertex_count) -> vertex_adjacency
+{
+   vertex_adjacency adjacency{.offsets = std::vector<u32>(vertex_count + 1, 0),
+                              .triangles = std::vector<u32>(std::size(indices))};
+
+   for (const u32 index : indices)
+   {
+      ++adjacency.offsets[index + 1];
+   }
+
+   std::partial_sum(std::begin(adjacency.offsets), std::end(adjacency.offsets),
+                    std::begin(adjacency.offsets));
+
+   auto cursors = adjacency.offsets;
+   for (u64 i = 0; i < std::size(indices); ++i)
+   {
+      adjacency.triangles[cursors[indices[i]]++] = static_cast<u32>(i / 3);
+   }
+
+   return adjacency;
+}
+
+auto optimize_vertex_cache(std::span<const u32> indices, u64 vertex_count, u32 cache_size,
+                           std::vector<u64>* p_clusters) -> std::vector<u32>
+{
+   // NOLINTNEXTLINE
+   assert(std::size(indices) % 3 == 0);
+
+   const u64 triangle_count = std::size(indices) / 3;
+   const auto adjacency = build_adjacency(indices, vertex_count);
+
+   std::vector<u32> live_triangles(vertex_count, 0);
+   for (u64 v = 0; v < vertex_count; ++v)
+   {
+      live_triangles[v] = static_cast<u32>(std::size(adjacency.of(static_cast<u32>(v))));
+   }
+
+   std::vector<u32> cache_time(vertex_count, 0);
+   std::vector<bool> is_emitted(triangle_count, false);
+   std::vector<u32> dead_ends;
+
+   std::vector<u32> output;
+   output.reserve(std::size(indices));
+
+   // Starting past the cache size makes every vertex initially out of the cache
+   u32 timestamp = cache_size + 1;
+   u32 input_cursor = 0;
+
+   const auto skip_dead_end = [&]() -> u32 {
+      while (!std::empty(dead_ends))
+      {
+         const u32 vertex = dead_ends.back();
+         dead_ends.pop_back();
+
+         if (live_triangles[vertex] > 0)
+         {
+            return vertex;
+         }
+      }
+
+      while (input_cursor < vertex_count)
+      {
+         const u32 vertex = input_cursor++;
+         if (live_triangles[vertex] > 0)
+         {
+            return vertex;
+         }
+      }
+
+      return unused_vertex;
+   };
+
+   std::vector<u32> candidates;
+
+   u32 fanning = skip_dead_end();
+   while (fanning != unused_vertex)
+   {
+      candidates.clear();
+
+      for (const u32 triangle : adjacency.of(fanning))
+      {
+         if (is_emitted[triangle])
+         {
+            continue;
+         }
+
+         for (u64 corner = 0; corner < 3; ++corner)
+         {
+            const u32 vertex = indices[triangle * 3 + corner];
+
+            output.push_back(vertex);
+            dead_ends.push_back(vertex);
+            candidates.push_back(vertex);
+
+            --live_triangles[vertex];
+
+            if (timestamp - cache_time[vertex] > cache_size)
+            {
+               cache_time[vertex] = timestamp++;
+            }
+         }
+
+         is_emitted[triangle] = true;
+      }
+
+      // Prefer the candidate that stays longest in the cache while its remaining triangles are
+      // emitted, a fan around it then only costs cache hits
+      u32 best = unused_vertex;
+      u32 best_priority = 0;
+      for (const u32 vertex : candidates)
+      {
+         if (live_triangles[vertex] == 0)
+         {
+            continue;
+         }
+
+         u32 priority = 0;
+         if (timestamp - cache_time[vertex] + 2 * live_triangles[vertex] <= cache_size)
+         {
+            priority = timestamp - cache_time[vertex];
+         }
+
+         if (best == unused_vertex || priority > best_priority)
+         {
+            best = vertex;
+            best_priority = priority;
+         }
+      }
+
+      if (best == unused_vertex)
+      {
+         best = skip_dead_end();
+
+         if (p_clusters && best != unused_vertex)
+         {
+            p_clusters->push_back(std::size(output));
+         }
+      }
+
+      fanning = best;
+   }
+
+   return output;
+}
+
+auto optimize_overdraw(std::span<const u32> indices, std::span<const vertex> vertices,
+                       std::span<const u64> clusters) -> std::vector<u32>
+{
+   struct cluster_bounds
+   {
+      u64 begin{};
+      u64 end{};
+      float sort_key{};
+   };
+
+   const auto triangle_position = [&](u64 first_index) {
+      const auto& p0 = vertices[indices[first_index + 0]].position;
+      const auto& p1 = vertices[indices[first_index + 1]].position;
+      const auto& p2 = vertices[indices[first_index + 2]].position;
+
+      return std::array{p0, p1, p2};
+   };
+
+   glm::vec3 mesh_centroid{0.0F};
+   float mesh_area = 0.0F;
+
+   for (u64 i = 0; i < std::size(indices); i += 3)
+   {
+      const auto [p0, p1, p2] = triangle_position(i);
+      const float area = glm::length(glm::cross(p1 - p0, p2 - p0));
+
+      mesh_centroid += (p0 + p1 + p2) * (area / 3.0F);
+      mesh_area += area;
+   }
+
+   if (mesh_area > 0.0F)
+   {
+      mesh_centroid /= mesh_area;
+   }
+
+   std::vector<cluster_bounds> bounds;
+   bounds.reserve(std::size(clusters) + 1);
+
+   for (u64 i = 0; i <= std::size(clusters); ++i)
+   {
+      const u64 begin = i == 0 ? 0 : clusters[i - 1];
+      const u64 end = i == std::size(clusters) ? std::size(indices) : clusters[i];
+
+      glm::vec3 centroid{0.0F};
+      glm::vec3 normal{0.0F};
+      float area = 0.0F;
+
+      for (u64 j = begin; j < end; j += 3)
+      {
+         const auto [p0, p1, p2] = triangle_position(j);
+         const glm::vec3 scaled_normal = glm::cross(p1 - p0, p2 - p0);
+         const float triangle_area = glm::length(scaled_normal);
+
+         centroid += (p0 + p1 + p2) * (triangle_area / 3.0F);
+         normal += scaled_normal;
+         area += triangle_area;
+      }
+
+      if (area > 0.0F)
+      {
+         centroid /= area;
+      }
+
+      const float normal_length = glm::length(normal);
+      if (normal_length > 0.0F)
+      {
+         normal /= normal_length;
+      }
+
+      bounds.push_back({.begin = begin,
+                        .end = end,
+                        .sort_key = glm::dot(centroid - mesh_centroid, normal)});
+   }
+
+   std::ranges::stable_sort(bounds, std::ranges::greater{}, &cluster_bounds::sort_key);
+
+   std::vector<u32> output;
+   output.reserve(std::size(indices));
+
+   for (const auto& cluster : bounds)
+   {
+      output.insert(std::end(output), std::begin(indices) + static_cast<i64>(cluster.begin),
+                    std::begin(indices) + static_cast<i64>(cluster.end));
+   }
+
+   return output;
+}
+
+void optimize_vertex_fetch(std::vector<vertex>& vertices, std::vector<u32>& indices)
+{
+   std::vector<u32> remap(std::size(vertices), unused_vertex);
+   std::vector<vertex> reordered;
+   reordered.reserve(std::size(vertices));
+
+   for (u32& index : indices)
+   {
+      if (remap[index] == unused_vertex)
+      {
+         remap[index] = static_cast<u32>(std::size(reordered));
+         reordered.push_back(vertices[index]);
+      }
+
+      index = remap[index];
+   }
+
+   vertices = std::move(reordered);
+}
+
+auto optimize_mesh(renderable_data& data, const mesh_optimization_info& info)
+   -> mesh_optimization_stats
+{
+   const u64 vertex_count = std::size(data.vertices);
+
+   mesh_optimization_stats stats{
+      .acmr_before = compute_acmr(data.indices, vertex_count, info.cache_size)};
+
+   std::vector<u64> clusters;
+   data.indices = optimize_vertex_cache(data.indices, vertex_count, info.cache_size,
+                                        info.optimize_overdraw ? &clusters : nullptr);
+
+   if (info.optimize_overdraw)
+   {
+      data.indices = optimize_overdraw(data.indices, data.vertices, clusters);
+   }
+
+   // Last, it only renames vertices and leaves the triangle order untouched
+   optimize_vertex_fetch(data.vertices, data.indices);
+
+   stats.acmr_after = compute_acmr(data.indices, std::size(data.vertices), info.cache_size);
+
+   return stats;
+}
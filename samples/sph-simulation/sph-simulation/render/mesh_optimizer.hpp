@@ -0,0 +1,60 @@
+#pragma once
+
+#include <sph-simulation/data_types/vertex.hpp>
+
+#include <libmannele/core.hpp>
+
+#include <span>
+#include <vector>
+
+/**
+ * @brief Average cache miss ratio of drawing `indices` through a FIFO post-transform cache of
+ * `cache_size` entries, in transformed vertices per triangle. Ranges from 0.5 for an ideal mesh to
+ * 3 when no vertex is ever reused.
+ */
+auto compute_acmr(std::span<const mannele::u32> indices, mannele::u64 vertex_count,
+                  mannele::u32 cache_size = 16) -> float;
+
+/**
+ * @brief Reorder the triangles of `indices` for the post-transform cache using Tipsify (Sander et
+ * al. 2007), in linear time.
+ *
+ * @param clusters If not null, filled with the index offset of every point where the ordering had
+ * to jump to an unrelated part of the mesh. Triangles between two such points form a cluster that
+ * may be reordered as a whole without hurting the cache.
+ */
+auto optimize_vertex_cache(std::span<const mannele::u32> indices, mannele::u64 vertex_count,
+                           mannele::u32 cache_size = 16,
+                           std::vector<mannele::u64>* p_clusters = nullptr)
+   -> std::vector<mannele::u32>;
+
+/**
+ * @brief Reorder the clusters of `indices` so the ones facing away from the center of the mesh are
+ * drawn first, letting them occlude the rest and reducing overdraw on mostly convex meshes.
+ */
+auto optimize_overdraw(std::span<const mannele::u32> indices, std::span<const vertex> vertices,
+                       std::span<const mannele::u64> clusters) -> std::vector<mannele::u32>;
+
+/**
+ * @brief Reorder `vertices` in the order `indices` first references them and remap the indices to
+ * match, so vertex fetches walk memory linearly. Unreferenced vertices are dropped.
+ */
+void optimize_vertex_fetch(std::vector<vertex>& vertices, std::vector<mannele::u32>& indices);
+
+struct mesh_optimization_info
+{
+   mannele::u32 cache_size{16};
+   bool optimize_overdraw{true};
+};
+
+struct mesh_optimization_stats
+{
+   float acmr_before{};
+   float acmr_after{};
+};
+
+/**
+ * @brief Run every optimization on a mesh, in the order that keeps the gains of the previous ones.
+ */
+auto optimize_mesh(renderable_data& data, const mesh_optimization_info& info = {})
+   -> mesh_optimization_stats;
@@ -0,0 +1,1045 @@
+#include <sph-simulation/render/render_graph.hpp>
+
+#include <libmannele/tracing/trace.hpp>
+
+#include <range/v3/view/iota.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <ranges>
+
+using mannele::u32;
+using mannele::u64;
+
+using namespace reglisse;
+
+namespace vi = ranges::views;
+
+static constexpr auto write_access_mask =
+   vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eColorAttachmentWrite |
+   vk::AccessFlagBits::eDepthStencilAttachmentWrite | vk::AccessFlagBits::eTransferWrite |
+   vk::AccessFlagBits::eHostWrite | vk::AccessFlagBits::eMemoryWrite;
+
+struct access_info
+{
+   vk::PipelineStageFlags stages{};
+   vk::AccessFlags access{};
+   vk::ImageLayout layout{};
+   vk::ImageUsageFlags usage{};
+
+   bool is_write{false};
+};
+
+auto to_access_info(const resource_use& use) -> access_info
+{
+   switch (use.access)
+   {
+      case resource_access::colour_attachment:
+         return {.stages = vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                 .access = vk::AccessFlagBits::eColorAttachmentRead |
+                    vk::AccessFlagBits::eColorAttachmentWrite,
+                 .layout = vk::ImageLayout::eColorAttachmentOptimal,
+                 .usage = vk::ImageUsageFlagBits::eColorAttachment,
+                 .is_write = true};
+      case resource_access::depth_stencil_attachment:
+         return {.stages = vk::PipelineStageFlagBits::eEarlyFragmentTests |
+                    vk::PipelineStageFlagBits::eLateFragmentTests,
+                 .access = vk::AccessFlagBits::eDepthStencilAttachmentRead |
+                    vk::AccessFlagBits::eDepthStencilAttachmentWrite,
+                 .layout = vk::ImageLayout::eDepthStencilAttachmentOptimal,
+                 .usage = vk::ImageUsageFlagBits::eDepthStencilAttachment,
+                 .is_write = true};
+      case resource_access::sampled:
+         return {.stages = use.stages,
+                 .access = vk::AccessFlagBits::eShaderRead,
+                 .layout = vk::ImageLayout::eShaderReadOnlyOptimal,
+                 .usage = vk::ImageUsageFlagBits::eSampled};
+      case resource_access::storage_read:
+         return {.stages = use.stages,
+                 .access = vk::AccessFlagBits::eShaderRead,
+                 .layout = vk::ImageLayout::eGeneral,
+                 .usage = vk::ImageUsageFlagBits::eStorage};
+      case resource_access::storage_write:
+         return {.stages = use.stages,
+                 .access = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+                 .layout = vk::ImageLayout::eGeneral,
+                 .usage = vk::ImageUsageFlagBits::eStorage,
+                 .is_write = true};
+   }
+
+   return {};
+}
+
+auto is_attachment(const resource_use& use) -> bool
+{
+   return use.access == resource_access::colour_attachment ||
+      use.access == resource_access::depth_stencil_attachment;
+}
+
+auto has_stencil_component(vk::Format format) -> bool
+{
+   return format == vk::Format::eD16UnormS8Uint || format == vk::Format::eD24UnormS8Uint ||
+      format == vk::Format::eD32SfloatS8Uint || format == vk::Format::eS8Uint;
+}
+
+render_graph::render_graph(const render_graph_create_info& info) :
+   mp_device(&info.device), mp_allocator(&info.allocator), mp_profiler(info.p_profiler),
+   m_logger(info.logger)
+{
+   const auto graphics_queue = info.device.find_best_suited_queue(cacao::queue_flag_bits::graphics);
+   const auto compute_queue = info.device.find_best_suited_queue(cacao::queue_flag_bits::compute);
+
+   m_graphics_family = graphics_queue.family_index;
+   m_compute_family = compute_queue.family_index;
+   m_has_async_queue = graphics_queue.value != compute_queue.value;
+}
+
+auto render_graph::create_image(const transient_image_info& info) -> resource_handle
+{
+   assert(!m_is_compiled); // NOLINT
+
+   m_resources.push_back({.name = info.name, .format = info.format, .extent = info.extent});
+
+   return static_cast<resource_handle>(std::size(m_resources) - 1);
+}
+auto render_graph::import_image(const imported_image_info& info) -> resource_handle
+{
+   assert(!m_is_compiled); // NOLINT
+
+   m_resources.push_back({.name = info.name,
+                          .is_imported = true,
+                          .format = info.format,
+                          .extent = info.extent,
+                          .images = info.images,
+                          .views = info.views,
+                          .initial_layout = info.initial_layout,
+                          .initial_stages = info.initial_stages,
+                          .final_layout = info.final_layout});
+
+   return static_cast<resource_handle>(std::size(m_resources) - 1);
+}
+auto render_graph::import_buffer(const imported_buffer_info& info) -> resource_handle
+{
+   assert(!m_is_compiled); // NOLINT
+
+   m_resources.push_back(
+      {.name = info.name, .is_image = false, .is_imported = true, .buffers = info.buffers});
+
+   return static_cast<resource_handle>(std::size(m_resources) - 1);
+}
+
+auto render_graph::add_pass(const render_graph_pass_info& info) -> pass_handle
+{
+   assert(!m_is_compiled); // NOLINT
+
+   m_passes.push_back({.info = info});
+
+   return static_cast<pass_handle>(std::size(m_passes) - 1);
+}
+
+void render_graph::set_render_calls(pass_handle pass, const render_pass::render_calls& calls)
+{
+   auto& node = m_passes.at(pass);
+   node.render_calls = calls;
+   node.parallel_render_calls = nullptr;
+
+   forward_render_calls(node);
+}
+void render_graph::set_parallel_render_calls(pass_handle pass,
+                                             const render_pass::parallel_render_calls& calls)
+{
+   auto& node = m_passes.at(pass);
+   node.render_calls = nullptr;
+   node.parallel_render_calls = calls;
+
+   forward_render_calls(node);
+}
+void render_graph::set_compute_calls(pass_handle pass, const compute_calls& calls)
+{
+   m_passes.at(pass).dispatch_calls = calls;
+}
+
+void render_graph::compile()
+{
+   assert(!m_is_compiled); // NOLINT
+
+   cull_passes();
+   assign_queues();
+   compute_lifetimes();
+   create_transient_images();
+   derive_barriers();
+   create_render_passes();
+
+   m_is_compiled = true;
+
+   for (auto& node : m_passes)
+   {
+      forward_render_calls(node);
+   }
+
+   const auto live_count = std::ranges::count_if(m_passes, [](const pass_node& node) {
+      return !node.is_culled;
+   });
+   m_logger.debug("Render graph compiled with {} live passes out of {}", live_count,
+                  std::size(m_passes));
+}
+
+auto render_graph::reimport_image(resource_handle handle, const imported_image_info& info)
+   -> retired_resources
+{
+   assert(m_is_compiled); // NOLINT
+
+   auto& imported = m_resources.at(handle);
+   assert(imported.is_imported && imported.is_image); // NOLINT
+
+   if (imported.format != info.format)
+   {
+      m_logger.warning(R"(Render graph image "{}" changed format, pipelines must be recreated)",
+                       imported.name);
+   }
+
+   const vk::Extent2D old_extent = imported.extent;
+
+   imported.format = info.format;
+   imported.extent = info.extent;
+   imported.images = info.images;
+   imported.views = info.views;
+
+   retired_resources retired;
+
+   for (auto& resource : m_resources)
+   {
+      if (!resource.is_image || resource.is_imported)
+      {
+         continue;
+      }
+
+      if (resource.extent == old_extent)
+      {
+         resource.extent = info.extent;
+      }
+
+      if (resource.owned_view)
+      {
+         retired.views.push_back(std::move(resource.owned_view));
+      }
+      if (resource.owned_image)
+      {
+         retired.images.push_back(std::move(resource.owned_image));
+      }
+
+      resource.images.clear();
+      resource.views.clear();
+      resource.aliased_predecessor = none;
+   }
+
+   retired.memory = std::move(m_transient_memory);
+   m_transient_memory.clear();
+
+   for (auto& node : m_passes)
+   {
+      if (!node.is_culled && node.info.type == pass_type::graphics)
+      {
+         retired.passes.push_back(std::move(node.pass));
+      }
+
+      node.barriers.clear();
+   }
+
+   m_final_barriers.clear();
+   m_async_release_barriers.clear();
+   m_async_wait_stages = {};
+   m_graphics_pass_count = 0;
+
+   // The memory layout of the transient images may change with their size, and the aliasing
+   // barriers with it
+   create_transient_images();
+   derive_barriers();
+   create_render_passes();
+
+   for (auto& node : m_passes)
+   {
+      forward_render_calls(node);
+   }
+
+   m_logger.debug(R"(Render graph image "{}" reimported at {}x{})", imported.name,
+                  info.extent.width, info.extent.height);
+
+   return retired;
+}
+
+void render_graph::execute(vk::CommandBuffer buffer, u64 image_index, u64 frame_index,
+                           std::span<const cacao::command_pool> recording_pools)
+{
+   assert(m_is_compiled); // NOLINT
+
+   MANNELE_TRACE_ZONE_CAT("render_graph::execute", "render");
+
+   for (auto& node : m_passes)
+   {
+      if (node.is_culled || node.is_async)
+      {
+         continue;
+      }
+
+      record_barriers(buffer, image_index, frame_index, node.barriers);
+
+      if (node.info.type == pass_type::compute)
+      {
+         if (node.dispatch_calls)
+         {
+            const auto scope =
+               mp_profiler ? mp_profiler->scope(buffer, node.info.name) : cacao::gpu_scope{};
+
+            std::invoke(node.dispatch_calls, buffer, frame_index);
+         }
+
+         continue;
+      }
+
+      const u64 framebuffer_index = node.framebuffer_count > 1 ? image_index : 0;
+
+      if (std::empty(recording_pools))
+      {
+         node.pass.submit_render_calls(buffer, framebuffer_index, node.render_area,
+                                       node.clear_values);
+      }
+      else
+      {
+         m_secondary_buffers.resize(std::size(recording_pools));
+         for (auto i : vi::iota(0U, std::size(recording_pools)))
+         {
+            m_secondary_buffers[i] = recording_pools[i].secondary_buffers()[node.graphics_index];
+         }
+
+         node.pass.submit_render_calls(buffer, framebuffer_index, node.render_area,
+                                       node.clear_values, m_secondary_buffers);
+      }
+   }
+
+   record_barriers(buffer, image_index, frame_index, m_final_barriers);
+}
+void render_graph::execute_async(vk::CommandBuffer buffer, u64 image_index, u64 frame_index)
+{
+   assert(m_is_compiled); // NOLINT
+
+   MANNELE_TRACE_ZONE_CAT("render_graph::execute_async", "render");
+
+   for (auto& node : m_passes)
+   {
+      if (node.is_culled || !node.is_async)
+      {
+         continue;
+      }
+
+      record_barriers(buffer, image_index, frame_index, node.barriers);
+
+      if (node.dispatch_calls)
+      {
+         const auto scope =
+            mp_profiler ? mp_profiler->scope(buffer, node.info.name) : cacao::gpu_scope{};
+
+         std::invoke(node.dispatch_calls, buffer, frame_index);
+      }
+   }
+
+   record_barriers(buffer, image_index, frame_index, m_async_release_barriers);
+}
+
+auto render_graph::pass(pass_handle handle) const -> const render_pass&
+{
+   assert(m_is_compiled); // NOLINT
+
+   return m_passes.at(handle).pass;
+}
+auto render_graph::is_culled(pass_handle handle) const -> bool
+{
+   return m_passes.at(handle).is_culled;
+}
+auto render_graph::graphics_pass_count() const noexcept -> u32
+{
+   return m_graphics_pass_count;
+}
+auto render_graph::has_async_passes() const noexcept -> bool
+{
+   return std::ranges::any_of(m_passes, [](const pass_node& node) {
+      return !node.is_culled && node.is_async;
+   });
+}
+auto render_graph::async_wait_stages() const noexcept -> vk::PipelineStageFlags
+{
+   return m_async_wait_stages;
+}
+
+void render_graph::cull_passes()
+{
+   // Imported resources are observed outside of the graph, everything else only matters if a live
+   // pass reads it
+   std::vector<bool> is_needed(std::size(m_resources));
+   for (auto i : vi::iota(0U, std::size(m_resources)))
+   {
+      is_needed[i] = m_resources[i].is_imported;
+   }
+
+   for (auto& node : m_passes | std::views::reverse)
+   {
+      const bool is_live =
+         node.info.has_side_effects || std::ranges::any_of(node.info.uses, [&](const auto& use) {
+            return to_access_info(use).is_write && is_needed[use.resource];
+         });
+
+      node.is_culled = !is_live;
+
+      if (node.is_culled)
+      {
+         m_logger.debug(R"(Render graph pass "{}" culled)", node.info.name);
+
+         continue;
+      }
+
+      // A cleared attachment doesn't depend on the passes that wrote it before
+      for (const auto& use : node.info.uses)
+      {
+         if (to_access_info(use).is_write && use.clear && !m_resources[use.resource].is_imported)
+         {
+            is_needed[use.resource] = false;
+         }
+      }
+
+      for (const auto& use : node.info.uses)
+      {
+         if (!to_access_info(use).is_write || !use.clear)
+         {
+            is_needed[use.resource] = true;
+         }
+      }
+   }
+}
+
+void render_graph::assign_queues()
+{
+   for (auto i : vi::iota(0U, std::size(m_passes)))
+   {
+      auto& node = m_passes[i];
+      if (node.is_culled || node.info.queue != queue_type::async_compute)
+      {
+         continue;
+      }
+
+      if (node.info.type != pass_type::compute || !m_has_async_queue)
+      {
+         m_logger.debug(R"(Render graph pass "{}" runs on the graphics queue)", node.info.name);
+
+         continue;
+      }
+
+      // Async passes run before the graphics passes of the frame, so they can't depend on them
+      const auto is_used_by_graphics = [&](resource_handle resource) {
+         for (auto j : vi::iota(0U, i))
+         {
+            const auto& other = m_passes[j];
+            if (other.is_culled || other.is_async)
+            {
+               continue;
+            }
+
+            if (std::ranges::any_of(other.info.uses,
+                                    [&](const auto& use) { return use.resource == resource; }))
+            {
+               return true;
+            }
+         }
+
+         return false;
+      };
+
+      const bool is_independent = std::ranges::all_of(node.info.uses, [&](const auto& use) {
+         const auto& resource = m_resources[use.resource];
+
+         return resource.is_imported && !resource.is_image && !is_used_by_graphics(use.resource);
+      });
+
+      if (!is_independent)
+      {
+         m_logger.warning(
+            R"(Render graph pass "{}" depends on graphics work, running it on the graphics queue)",
+            node.info.name);
+
+         continue;
+      }
+
+      node.is_async = true;
+   }
+}
+
+void render_graph::compute_lifetimes()
+{
+   for (auto i : vi::iota(0U, std::size(m_passes)))
+   {
+      const auto& node = m_passes[i];
+      if (node.is_culled)
+      {
+         continue;
+      }
+
+      for (const auto& use : node.info.uses)
+      {
+         auto& resource = m_resources[use.resource];
+
+         resource.first_use = std::min(resource.first_use, static_cast<u32>(i));
+         resource.last_use = std::max(resource.last_use, static_cast<u32>(i));
+         resource.usage |= to_access_info(use).usage;
+      }
+   }
+
+   for (auto& resource : m_resources)
+   {
+      if ((resource.usage & vk::ImageUsageFlagBits::eDepthStencilAttachment) ==
+          vk::ImageUsageFlagBits::eDepthStencilAttachment)
+      {
+         resource.aspect = has_stencil_component(resource.format)
+            ? vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil
+            : vk::ImageAspectFlagBits::eDepth;
+      }
+      else
+      {
+         resource.aspect = vk::ImageAspectFlagBits::eColor;
+      }
+   }
+}
+
+void render_graph::create_transient_images()
+{
+   struct memory_slot
+   {
+      vk::MemoryRequirements requirements{};
+      std::vector<resource_handle> members;
+   };
+
+   const auto device = mp_device->logical();
+
+   std::vector<resource_handle> transients;
+   std::vector<vk::MemoryRequirements> requirements(std::size(m_resources));
+
+   for (auto i : vi::iota(0U, std::size(m_resources)))
+   {
+      auto& resource = m_resources[i];
+      if (!resource.is_image || resource.is_imported ||
+          resource.first_use == std::numeric_limits<u32>::max())
+      {
+         continue;
+      }
+
+      resource.owned_image = device.createImageUnique(
+         {.imageType = vk::ImageType::e2D,
+          .format = resource.format,
+          .extent = {.width = resource.extent.width, .height = resource.extent.height, .depth = 1},
+          .mipLevels = 1,
+          .arrayLayers = 1,
+          .samples = vk::SampleCountFlagBits::e1,
+          .tiling = vk::ImageTiling::eOptimal,
+          .usage = resource.usage,
+          .sharingMode = vk::SharingMode::eExclusive,
+          .initialLayout = vk::ImageLayout::eUndefined});
+
+      requirements[i] = device.getImageMemoryRequirements(resource.owned_image.get());
+      transients.push_back(static_cast<resource_handle>(i));
+   }
+
+   // Placing the largest images first lets the smaller ones fit in their memory
+   std::ranges::stable_sort(transients, std::greater<>{}, [&](resource_handle handle) {
+      return requirements[handle].size;
+   });
+
+   const auto overlaps = [&](resource_handle lhs, resource_handle rhs) {
+      const auto& a = m_resources[lhs];
+      const auto& b = m_resources[rhs];
+
+      return a.first_use <= b.last_use && b.first_use <= a.last_use;
+   };
+
+   std::vector<memory_slot> slots;
+   for (auto handle : transients)
+   {
+      const auto& reqs = requirements[handle];
+
+      auto it = std::ranges::find_if(slots, [&](const memory_slot& slot) {
+         return (slot.requirements.memoryTypeBits & reqs.memoryTypeBits) != 0 &&
+            std::ranges::none_of(slot.members, [&](resource_handle member) {
+                   return overlaps(member, handle);
+                });
+      });
+
+      if (it == std::end(slots))
+      {
+         slots.push_back({.requirements = reqs, .members = {handle}});
+      }
+      else
+      {
+         it->requirements.size = std::max(it->requirements.size, reqs.size);
+         it->requirements.alignment = std::max(it->requirements.alignment, reqs.alignment);
+         it->requirements.memoryTypeBits &= reqs.memoryTypeBits;
+         it->members.push_back(handle);
+      }
+   }
+
+   u64 requested_size = 0;
+   u64 reserved_size = 0;
+
+   for (auto& slot : slots)
+   {
+      auto allocation =
+         mp_allocator->allocate({.requirements = slot.requirements,
+                                 .desired_mem_flags = vk::MemoryPropertyFlagBits::eDeviceLocal,
+                                 .is_linear = false});
+
+      std::ranges::sort(slot.members, std::less<>{},
+                        [&](resource_handle handle) { return m_resources[handle].first_use; });
+
+      for (auto i : vi::iota(0U, std::size(slot.members)))
+      {
+         auto& resource = m_resources[slot.members[i]];
+
+         device.bindImageMemory(resource.owned_image.get(), allocation.memory(),
+                                allocation.offset());
+
+         resource.owned_view = device.createImageViewUnique(
+            {.image = resource.owned_image.get(),
+             .viewType = vk::ImageViewType::e2D,
+             .format = resource.format,
+             .subresourceRange = {.aspectMask = resource.aspect,
+                                  .baseMipLevel = 0,
+                                  .levelCount = 1,
+                                  .baseArrayLayer = 0,
+                                  .layerCount = 1}});
+
+         resource.images = {resource.owned_image.get()};
+         resource.views = {resource.owned_view.get()};
+
+         if (i > 0)
+         {
+            resource.aliased_predecessor = some(slot.members[i - 1]);
+         }
+
+         requested_size += requirements[slot.members[i]].size;
+      }
+
+      reserved_size += slot.requirements.size;
+      m_transient_memory.push_back(std::move(allocation));
+   }
+
+   m_logger.debug("Render graph placed {} transient images in {} bytes instead of {}",
+                  std::size(transients), reserved_size, requested_size);
+}
+
+void render_graph::derive_barriers()
+{
+   std::vector<resource_state> states(std::size(m_resources));
+   std::vector<vk::PipelineStageFlags> used_stages(std::size(m_resources));
+   std::vector<vk::AccessFlags> written_access(std::size(m_resources));
+
+   for (auto i : vi::iota(0U, std::size(m_resources)))
+   {
+      const auto& resource = m_resources[i];
+      if (resource.is_imported && resource.is_image)
+      {
+         states[i] = {.layout = resource.initial_layout, .write_stages = resource.initial_stages};
+      }
+   }
+
+   // Stages and writes touching the memory of each transient image over a whole frame, gathered
+   // on the first image of its memory slot. That image follows the last one of the slot from the
+   // previous frame, which may still be in flight
+   std::vector<vk::PipelineStageFlags> slot_stages(std::size(m_resources));
+   std::vector<vk::AccessFlags> slot_written_access(std::size(m_resources));
+
+   const auto find_slot_head = [&](resource_handle handle) {
+      while (m_resources[handle].aliased_predecessor)
+      {
+         handle = m_resources[handle].aliased_predecessor.borrow();
+      }
+
+      return handle;
+   };
+
+   for (const auto& node : m_passes)
+   {
+      if (node.is_culled)
+      {
+         continue;
+      }
+
+      for (const auto& use : node.info.uses)
+      {
+         if (m_resources[use.resource].is_imported)
+         {
+            continue;
+         }
+
+         const auto head = find_slot_head(use.resource);
+         const auto access = to_access_info(use);
+
+         slot_stages[head] |= access.stages;
+         if (access.is_write)
+         {
+            slot_written_access[head] |= access.access & write_access_mask;
+         }
+      }
+   }
+
+   const bool is_transfer_needed = m_compute_family != m_graphics_family;
+
+   const auto derive = [&](pass_node& node, u32 pass_index) {
+      for (const auto& use : node.info.uses)
+      {
+         const auto& resource = m_resources[use.resource];
+         const auto access = to_access_info(use);
+
+         auto& state = states[use.resource];
+
+         if (!resource.is_imported && resource.first_use == pass_index)
+         {
+            // The content is discarded, but the memory must not be reused before the previous
+            // image living in it is done with it
+            state = {};
+            if (resource.aliased_predecessor)
+            {
+               const auto predecessor = resource.aliased_predecessor.borrow();
+
+               state.write_stages = used_stages[predecessor];
+               state.write_access = written_access[predecessor];
+            }
+            else
+            {
+               // Render passes don't carry an external dependency, the previous frame's uses of
+               // the memory have to be waited on here
+               state.write_stages = slot_stages[use.resource];
+               state.write_access = slot_written_access[use.resource];
+            }
+         }
+
+         if (state.is_owned_by_compute && !node.is_async)
+         {
+            // The compute submission is waited on by the graphics one, only the ownership of the
+            // resource has to move between queue families
+            if (is_transfer_needed)
+            {
+               const barrier_record transfer{.resource = use.resource,
+                                             .src_stages = state.write_stages | state.read_stages,
+                                             .dst_stages = access.stages,
+                                             .src_access = state.write_access,
+                                             .dst_access = access.access,
+                                             .src_queue_family = m_compute_family,
+                                             .dst_queue_family = m_graphics_family};
+
+               auto release = transfer;
+               release.dst_stages = vk::PipelineStageFlagBits::eBottomOfPipe;
+               release.dst_access = {};
+               m_async_release_barriers.push_back(release);
+
+               auto acquire = transfer;
+               acquire.src_stages = vk::PipelineStageFlagBits::eTopOfPipe;
+               acquire.src_access = {};
+               node.barriers.push_back(acquire);
+            }
+
+            m_async_wait_stages |= access.stages;
+
+            // Later accesses from other stages chain on the semaphore wait through this one
+            state = {};
+            if (!access.is_write)
+            {
+               state = {.write_stages = access.stages,
+                        .read_stages = access.stages,
+                        .read_access = access.access};
+            }
+         }
+
+         const bool is_transition = resource.is_image && state.layout != access.layout;
+         const bool is_hazard = access.is_write
+            ? (state.write_stages || state.read_stages)
+            : (state.write_stages &&
+               ((access.stages & ~state.read_stages) || (access.access & ~state.read_access)));
+
+         if (is_transition || is_hazard)
+         {
+            node.barriers.push_back(
+               {.resource = use.resource,
+                .src_stages = state.write_stages | state.read_stages,
+                .dst_stages = access.stages,
+                .src_access = state.write_access,
+                .dst_access = access.access,
+                .old_layout = state.layout,
+                .new_layout = resource.is_image ? access.layout : vk::ImageLayout::eUndefined});
+         }
+
+         if (access.is_write)
+         {
+            state = {.layout = access.layout,
+                     .write_stages = access.stages,
+                     .write_access = access.access & write_access_mask};
+         }
+         else if (is_transition)
+         {
+            // The transition is a write made visible to this access only, later reads chain on it
+            state = {.layout = access.layout,
+                     .write_stages = access.stages,
+                     .read_stages = access.stages,
+                     .read_access = access.access};
+         }
+         else
+         {
+            state.read_stages |= access.stages;
+            state.read_access |= access.access;
+         }
+
+         state.is_owned_by_compute = node.is_async;
+
+         used_stages[use.resource] |= access.stages;
+         if (access.is_write)
+         {
+            written_access[use.resource] |= access.access & write_access_mask;
+         }
+      }
+   };
+
+   // Async passes are submitted ahead of the graphics passes of the frame
+   for (auto i : vi::iota(0U, std::size(m_passes)))
+   {
+      if (!m_passes[i].is_culled && m_passes[i].is_async)
+      {
+         derive(m_passes[i], static_cast<u32>(i));
+      }
+   }
+   for (auto i : vi::iota(0U, std::size(m_passes)))
+   {
+      if (!m_passes[i].is_culled && !m_passes[i].is_async)
+      {
+         derive(m_passes[i], static_cast<u32>(i));
+      }
+   }
+
+   for (auto i : vi::iota(0U, std::size(m_resources)))
+   {
+      const auto& resource = m_resources[i];
+      const auto& state = states[i];
+
+      if (!resource.is_imported || !resource.is_image ||
+          resource.first_use == std::numeric_limits<u32>::max() ||
+          resource.final_layout == vk::ImageLayout::eUndefined ||
+          resource.final_layout == state.layout)
+      {
+         continue;
+      }
+
+      m_final_barriers.push_back({.resource = static_cast<resource_handle>(i),
+                                  .src_stages = state.write_stages | state.read_stages,
+                                  .dst_stages = vk::PipelineStageFlagBits::eBottomOfPipe,
+                                  .src_access = state.write_access,
+                                  .dst_access = {},
+                                  .old_layout = state.layout,
+                                  .new_layout = resource.final_layout});
+   }
+}
+
+void render_graph::create_render_passes()
+{
+   for (auto i : vi::iota(0U, std::size(m_passes)))
+   {
+      auto& node = m_passes[i];
+      if (node.is_culled || node.info.type != pass_type::graphics)
+      {
+         continue;
+      }
+
+      maybe<vk::AttachmentDescription> colour_attachment = none;
+      maybe<vk::AttachmentDescription> depth_stencil_attachment = none;
+
+      maybe<resource_handle> colour = none;
+      maybe<resource_handle> depth_stencil = none;
+
+      vk::ClearValue colour_clear{};
+      vk::ClearValue depth_stencil_clear{};
+
+      u32 framebuffer_count = 1;
+
+      for (const auto& use : node.info.uses)
+      {
+         if (!is_attachment(use))
+         {
+            continue;
+         }
+
+         const auto& resource = m_resources[use.resource];
+         const auto access = to_access_info(use);
+
+         const bool is_loaded = resource.first_use < i ||
+            (resource.is_imported && resource.initial_layout != vk::ImageLayout::eUndefined);
+         const bool is_stored = resource.last_use > i || resource.is_imported;
+
+         vk::AttachmentLoadOp load_op = vk::AttachmentLoadOp::eDontCare;
+         if (use.clear)
+         {
+            load_op = vk::AttachmentLoadOp::eClear;
+         }
+         else if (is_loaded)
+         {
+            load_op = vk::AttachmentLoadOp::eLoad;
+         }
+
+         const vk::AttachmentDescription description{
+            .format = resource.format,
+            .samples = vk::SampleCountFlagBits::e1,
+            .loadOp = load_op,
+            .storeOp = is_stored ? vk::AttachmentStoreOp::eStore : vk::AttachmentStoreOp::eDontCare,
+            .stencilLoadOp = vk::AttachmentLoadOp::eDontCare,
+            .stencilStoreOp = vk::AttachmentStoreOp::eDontCare,
+            .initialLayout = access.layout,
+            .finalLayout = access.layout};
+
+         if (use.access == resource_access::colour_attachment)
+         {
+            colour_attachment = some(description);
+            colour = some(use.resource);
+            colour_clear = use.clear ? use.clear.borrow() : vk::ClearValue{};
+         }
+         else
+         {
+            depth_stencil_attachment = some(description);
+            depth_stencil = some(use.resource);
+            depth_stencil_clear = use.clear ? use.clear.borrow() : vk::ClearValue{};
+         }
+
+         node.render_area = {.offset = {0, 0}, .extent = resource.extent};
+         framebuffer_count =
+            std::max(framebuffer_count, static_cast<u32>(std::size(resource.views)));
+      }
+
+      node.clear_values.clear();
+      if (colour)
+      {
+         node.clear_values.push_back(colour_clear);
+      }
+      if (depth_stencil)
+      {
+         node.clear_values.push_back(depth_stencil_clear);
+      }
+
+      std::vector<framebuffer_create_info> framebuffer_infos;
+      for (auto j : vi::iota(0U, framebuffer_count))
+      {
+         const auto view_at = [&](resource_handle handle) {
+            const auto& views = m_resources[handle].views;
+
+            return std::size(views) > 1 ? views[j] : views[0];
+         };
+
+         framebuffer_create_info framebuffer_info{
+            .device = mp_device->logical(),
+            .dimensions = {node.render_area.extent.width, node.render_area.extent.height},
+            .layers = 1,
+            .logger = m_logger};
+
+         if (colour)
+         {
+            framebuffer_info.attachments.push_back(view_at(colour.borrow()));
+         }
+         if (depth_stencil)
+         {
+            framebuffer_info.attachments.push_back(view_at(depth_stencil.borrow()));
+         }
+
+         framebuffer_infos.push_back(std::move(framebuffer_info));
+      }
+
+      node.pass = render_pass({.device = *mp_device,
+                               .colour_attachment = colour_attachment,
+                               .depth_stencil_attachment = depth_stencil_attachment,
+                               .framebuffer_create_infos = framebuffer_infos,
+                               .is_synchronized_externally = true,
+                               .p_profiler = mp_profiler,
+                               .name = node.info.name,
+                               .logger = m_logger});
+      node.framebuffer_count = framebuffer_count;
+      node.graphics_index = m_graphics_pass_count++;
+   }
+}
+
+void render_graph::forward_render_calls(pass_node& node)
+{
+   if (!m_is_compiled || node.is_culled || node.info.type != pass_type::graphics)
+   {
+      return;
+   }
+
+   if (node.parallel_render_calls)
+   {
+      node.pass.record_parallel_render_calls(node.parallel_render_calls);
+   }
+   else if (node.render_calls)
+   {
+      node.pass.record_render_calls(node.render_calls);
+   }
+}
+
+void render_graph::record_barriers(vk::CommandBuffer buffer, u64 image_index, u64 frame_index,
+                                   std::span<const barrier_record> barriers) const
+{
+   if (std::empty(barriers))
+   {
+      return;
+   }
+
+   vk::PipelineStageFlags src_stages{};
+   vk::PipelineStageFlags dst_stages{};
+
+   std::vector<vk::ImageMemoryBarrier> image_barriers;
+   std::vector<vk::BufferMemoryBarrier> buffer_barriers;
+
+   for (const auto& barrier : barriers)
+   {
+      const auto& resource = m_resources[barrier.resource];
+
+      src_stages |= barrier.src_stages;
+      dst_stages |= barrier.dst_stages;
+
+      if (resource.is_image)
+      {
+         const auto image =
+            std::size(resource.images) > 1 ? resource.images[image_index] : resource.images[0];
+
+         image_barriers.push_back({.srcAccessMask = barrier.src_access,
+                                   .dstAccessMask = barrier.dst_access,
+                                   .oldLayout = barrier.old_layout,
+                                   .newLayout = barrier.new_layout,
+                                   .srcQueueFamilyIndex = barrier.src_queue_family,
+                                   .dstQueueFamilyIndex = barrier.dst_queue_family,
+                                   .image = image,
+                                   .subresourceRange = {.aspectMask = resource.aspect,
+                                                        .baseMipLevel = 0,
+                                                        .levelCount = 1,
+                                                        .baseArrayLayer = 0,
+                                                        .layerCount = 1}});
+      }
+      else
+      {
+         const auto target =
+            std::size(resource.buffers) > 1 ? resource.buffers[frame_index] : resource.buffers[0];
+
+         buffer_barriers.push_back({.srcAccessMask = barrier.src_access,
+                                    .dstAccessMask = barrier.dst_access,
+                                    .srcQueueFamilyIndex = barrier.src_queue_family,
+                                    .dstQueueFamilyIndex = barrier.dst_queue_family,
+                                    .buffer = target,
+                                    .offset = 0,
+                                    .size = VK_WHOLE_SIZE});
+      }
+   }
+
+   if (!src_stages)
+   {
+      src_stages = vk::PipelineStageFlagBits::eTopOfPipe;
+   }
+
+   buffer.pipelineBarrier(src_stages, dst_stages, {}, {}, buffer_barriers, image_barriers);
+}
@@ -0,0 +1,363 @@
+#ifndef SPH_SIMULATION_RENDER_RENDER_GRAPH_HPP
+#define SPH_SIMULATION_RENDER_RENDER_GRAPH_HPP
+
+#include <sph-simulation/render/core/render_pass.hpp>
+
+#include <libcacao/allocator.hpp>
+#include <libcacao/command_pool.hpp>
+#include <libcacao/device.hpp>
+#include <libcacao/gpu_profiler.hpp>
+
+#include <libmannele/core.hpp>
+#include <libmannele/logging/log_ptr.hpp>
+
+#include <libreglisse/maybe.hpp>
+
+#include <functional>
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+using resource_handle = mannele::u32;
+using pass_handle = mannele::u32;
+
+struct render_graph_create_info
+{
+   const cacao::device& device;
+   cacao::allocator& allocator;
+
+   /**
+    * @brief Profiler measuring the GPU time of every live pass under its name, if any.
+    */
+   cacao::gpu_profiler* p_profiler{nullptr};
+
+   mannele::log_ptr logger;
+};
+
+/**
+ * @brief An image owned by the render graph. Its memory is shared with other transient images
+ * whose lifetimes in the frame don't overlap, so its content does not survive across frames.
+ */
+struct transient_image_info
+{
+   std::string name;
+
+   vk::Format format{};
+   vk::Extent2D extent{};
+};
+
+/**
+ * @brief An image owned outside of the render graph, one per framebuffer index, such as the
+ * swapchain images.
+ */
+struct imported_image_info
+{
+   std::string name;
+
+   vk::Format format{};
+   vk::Extent2D extent{};
+
+   std::vector<vk::Image> images;
+   std::vector<vk::ImageView> views;
+
+   vk::ImageLayout initial_layout{vk::ImageLayout::eUndefined};
+   /**
+    * @brief Stages the image is made available at when the frame starts, such as the wait stage of
+    * the swapchain acquire semaphore.
+    */
+   vk::PipelineStageFlags initial_stages{vk::PipelineStageFlagBits::eTopOfPipe};
+
+   vk::ImageLayout final_layout{vk::ImageLayout::eUndefined};
+};
+
+/**
+ * @brief A buffer owned outside of the render graph.
+ */
+struct imported_buffer_info
+{
+   std::string name;
+
+   /**
+    * @brief One buffer per frame in flight, or a single buffer used by every frame. Buffers
+    * written by async compute passes need one per frame in flight so the compute queue never
+    * writes a buffer the graphics queue is still reading.
+    */
+   std::vector<vk::Buffer> buffers;
+};
+
+enum struct resource_access
+{
+   colour_attachment,
+   depth_stencil_attachment,
+   sampled,
+   storage_read,
+   storage_write
+};
+
+struct resource_use
+{
+   resource_handle resource{};
+   resource_access access{};
+
+   /**
+    * @brief Shader stages of sampled and storage accesses. Attachment accesses ignore it.
+    */
+   vk::PipelineStageFlags stages{vk::PipelineStageFlagBits::eFragmentShader};
+
+   /**
+    * @brief Clear value of an attachment. Attachments without one keep the content written by
+    * previous passes.
+    */
+   reglisse::maybe<vk::ClearValue> clear{reglisse::none};
+};
+
+enum struct pass_type
+{
+   graphics,
+   compute
+};
+
+enum struct queue_type
+{
+   graphics,
+   async_compute
+};
+
+struct render_graph_pass_info
+{
+   std::string name;
+   pass_type type{pass_type::graphics};
+
+   std::vector<resource_use> uses;
+
+   /**
+    * @brief Queue the pass is submitted to. Async compute passes run ahead of the graphics passes
+    * of the frame on the compute queue, and may only access imported buffers not used by earlier
+    * graphics passes. Passes that can't run asynchronously fall back to the graphics queue.
+    */
+   queue_type queue{queue_type::graphics};
+
+   /**
+    * @brief Keep the pass even if nothing in the graph reads what it writes.
+    */
+   bool has_side_effects{false};
+};
+
+/**
+ * @brief Describes the passes of a frame and the resources they read and write.
+ *
+ * Once compiled, passes not contributing to an imported resource are culled, pipeline barriers and
+ * layout transitions between the remaining passes are derived from their resource uses, and the
+ * transient images are created, sharing memory when their lifetimes don't overlap. Passes are
+ * executed in the order they are added.
+ *
+ * Async compute passes are recorded separately through execute_async(). Their results are
+ * released by the compute queue and acquired by the graphics queue when the queue families differ,
+ * and the graphics submission of the frame must wait on the compute submission at
+ * async_wait_stages().
+ *
+ * Graphics passes support at most one colour attachment and one depth stencil attachment.
+ */
+class render_graph
+{
+public:
+   /**
+    * @brief Records the dispatches of a compute pass, given the frame index that selects the
+    * buffer of imported buffers with one buffer per frame in flight.
+    */
+   using compute_calls = std::function<void(vk::CommandBuffer, mannele::u64)>;
+
+   /**
+    * @brief Resources replaced by reimport_image(), which frames already submitted may still use.
+    */
+   struct retired_resources
+   {
+      std::vector<render_pass> passes;
+
+      std::vector<vk::UniqueImageView> views;
+      std::vector<vk::UniqueImage> images;
+      std::vector<cacao::memory_allocation> memory;
+   };
+
+public:
+   render_graph(const render_graph_create_info& info);
+
+   auto create_image(const transient_image_info& info) -> resource_handle;
+   auto import_image(const imported_image_info& info) -> resource_handle;
+   auto import_buffer(const imported_buffer_info& info) -> resource_handle;
+
+   auto add_pass(const render_graph_pass_info& info) -> pass_handle;
+
+   void set_render_calls(pass_handle pass, const render_pass::render_calls& calls);
+   void set_parallel_render_calls(pass_handle pass,
+                                  const render_pass::parallel_render_calls& calls);
+   void set_compute_calls(pass_handle pass, const compute_calls& calls);
+
+   /**
+    * @brief Cull unused passes, derive the barriers between passes and create the render passes
+    * and transient images. Must be called once all passes are added and before render passes are
+    * accessed.
+    */
+   void compile();
+
+   /**
+    * @brief Replace the images of an imported image, such as the swapchain images once the
+    * swapchain is recreated. Transient images that had the extent of the old images take the new
+    * one, and the transient images, framebuffers and render passes are recreated. The new render
+    * passes stay compatible with the pipelines created from the old ones as long as the format
+    * doesn't change.
+    *
+    * @return The replaced resources, to be destroyed once the frames using them are complete.
+    */
+   [[nodiscard]] auto reimport_image(resource_handle handle, const imported_image_info& info)
+      -> retired_resources;
+
+   /**
+    * @brief Record every live pass of the graphics queue and the barriers between them in
+    * `buffer`.
+    *
+    * @param recording_pools Command pools of the threads recording graphics passes in parallel,
+    * each holding graphics_pass_count() secondary buffers. Graphics passes are recorded inline when
+    * empty.
+    */
+   void execute(vk::CommandBuffer buffer, mannele::u64 image_index, mannele::u64 frame_index,
+                std::span<const cacao::command_pool> recording_pools = {});
+   /**
+    * @brief Record the async compute passes in `buffer`, to be submitted on the compute queue.
+    */
+   void execute_async(vk::CommandBuffer buffer, mannele::u64 image_index,
+                      mannele::u64 frame_index);
+
+   /**
+    * @brief Access the render pass of a live graphics pass, to create its pipelines.
+    */
+   [[nodiscard]] auto pass(pass_handle handle) const -> const render_pass&;
+
+   [[nodiscard]] auto is_culled(pass_handle handle) const -> bool;
+   [[nodiscard]] auto graphics_pass_count() const noexcept -> mannele::u32;
+
+   [[nodiscard]] auto has_async_passes() const noexcept -> bool;
+   /**
+    * @brief Stages of the graphics queue consuming the results of the async compute passes.
+    */
+   [[nodiscard]] auto async_wait_stages() const noexcept -> vk::PipelineStageFlags;
+
+private:
+   struct resource_state
+   {
+      vk::ImageLayout layout{vk::ImageLayout::eUndefined};
+
+      vk::PipelineStageFlags write_stages{};
+      vk::AccessFlags write_access{};
+
+      vk::PipelineStageFlags read_stages{};
+      vk::AccessFlags read_access{};
+
+      bool is_owned_by_compute{false};
+   };
+
+   struct resource_node
+   {
+      std::string name;
+
+      bool is_image{true};
+      bool is_imported{false};
+
+      vk::Format format{};
+      vk::Extent2D extent{};
+      vk::ImageUsageFlags usage{};
+      vk::ImageAspectFlags aspect{};
+
+      std::vector<vk::Image> images;
+      std::vector<vk::ImageView> views;
+      std::vector<vk::Buffer> buffers;
+
+      vk::ImageLayout initial_layout{vk::ImageLayout::eUndefined};
+      vk::PipelineStageFlags initial_stages{vk::PipelineStageFlagBits::eTopOfPipe};
+      vk::ImageLayout final_layout{vk::ImageLayout::eUndefined};
+
+      // Lifetime in the live passes, for transient images
+      mannele::u32 first_use{std::numeric_limits<mannele::u32>::max()};
+      mannele::u32 last_use{0};
+
+      reglisse::maybe<resource_handle> aliased_predecessor{reglisse::none};
+
+      vk::UniqueImage owned_image;
+      vk::UniqueImageView owned_view;
+   };
+
+   struct barrier_record
+   {
+      resource_handle resource{};
+
+      vk::PipelineStageFlags src_stages{};
+      vk::PipelineStageFlags dst_stages{};
+      vk::AccessFlags src_access{};
+      vk::AccessFlags dst_access{};
+
+      vk::ImageLayout old_layout{};
+      vk::ImageLayout new_layout{};
+
+      mannele::u32 src_queue_family{VK_QUEUE_FAMILY_IGNORED};
+      mannele::u32 dst_queue_family{VK_QUEUE_FAMILY_IGNORED};
+   };
+
+   struct pass_node
+   {
+      render_graph_pass_info info;
+
+      bool is_culled{false};
+      bool is_async{false};
+
+      render_pass::render_calls render_calls;
+      render_pass::parallel_render_calls parallel_render_calls;
+      render_graph::compute_calls dispatch_calls;
+
+      render_pass pass;
+      mannele::u32 framebuffer_count{0};
+      mannele::u32 graphics_index{0};
+      vk::Rect2D render_area{};
+      std::vector<vk::ClearValue> clear_values;
+
+      std::vector<barrier_record> barriers;
+   };
+
+   void cull_passes();
+   void assign_queues();
+   void compute_lifetimes();
+   void create_transient_images();
+   void derive_barriers();
+   void create_render_passes();
+   void forward_render_calls(pass_node& node);
+
+   void record_barriers(vk::CommandBuffer buffer, mannele::u64 image_index,
+                        mannele::u64 frame_index, std::span<const barrier_record> barriers) const;
+
+private:
+   const cacao::device* mp_device;
+   cacao::allocator* mp_allocator;
+   cacao::gpu_profiler* mp_profiler;
+
+   std::vector<resource_node> m_resources;
+   std::vector<pass_node> m_passes;
+
+   std::vector<barrier_record> m_final_barriers;
+   std::vector<barrier_record> m_async_release_barriers;
+   std::vector<cacao::memory_allocation> m_transient_memory;
+
+   mannele::u32 m_graphics_family{};
+   mannele::u32 m_compute_family{};
+   bool m_has_async_queue{false};
+
+   vk::PipelineStageFlags m_async_wait_stages{};
+
+   mannele::u32 m_graphics_pass_count{0};
+   bool m_is_compiled{false};
+
+   std::vector<vk::CommandBuffer> m_secondary_buffers;
+
+   mannele::log_ptr m_logger;
+};
+
+#endif // SPH_SIMULATION_RENDER_RENDER_GRAPH_HPP
@@ -3,6 +3,7 @@
 #include <sph-simulation/data_types/vertex.hpp>
 #include <sph-simulation/render/core/index_buffer.hpp>
 #include <sph-simulation/render/core/vertex_buffer.hpp>
+#include <sph-simulation/render/mesh_cache.hpp>
 
 #include <glm/mat4x4.hpp>
 
@@ -18,16 +19,42 @@ struct renderable
    glm::mat4 model{};
 };
 
-inline auto create_renderable(const cacao::device& device, const cacao::command_pool& pool,
-                              const renderable_data& data, mannele::log_ptr logger)
-   -> renderable
+inline auto create_renderable(const cacao::device& device, cacao::allocator& allocator,
+                              cacao::upload_service& uploads, const renderable_data& data,
+                              mannele::log_ptr logger) -> renderable
 {
-   return renderable{
-      .vertex_buff = vertex_buffer(
-         {.device = device, .pool = pool, .vertices = data.vertices, .logger = logger}),
-      .index_buff = index_buffer(
-         {.device = device, .pool = pool, .indices = data.indices, .logger = logger}),
-      .model = data.model};
+   return renderable{.vertex_buff = vertex_buffer({.device = device,
+                                                   .allocator = allocator,
+                                                   .uploads = uploads,
+                                                   .vertices = data.vertices,
+                                                   .logger = logger}),
+                     .index_buff = index_buffer({.device = device,
+                                                 .allocator = allocator,
+                                                 .uploads = uploads,
+                                                 .indices = data.indices,
+                                                 .logger = logger}),
+                     .model = data.model};
+}
+
+/**
+ * @brief Create a renderable from a mesh mapped out of its binary cache, the vertices and indices
+ * are copied from the mapping straight into the staging buffer.
+ */
+inline auto create_renderable(const cacao::device& device, cacao::allocator& allocator,
+                              cacao::upload_service& uploads, const cached_mesh& mesh,
+                              const glm::mat4& model, mannele::log_ptr logger) -> renderable
+{
+   return renderable{.vertex_buff = vertex_buffer({.device = device,
+                                                   .allocator = allocator,
+                                                   .uploads = uploads,
+                                                   .vertices = mesh.vertices(),
+                                                   .logger = logger}),
+                     .index_buff = index_buffer({.device = device,
+                                                 .allocator = allocator,
+                                                 .uploads = uploads,
+                                                 .indices = mesh.indices(),
+                                                 .logger = logger}),
+                     .model = model};
 }
 
 inline auto load_obj(const std::filesystem::path& path) -> renderable_data
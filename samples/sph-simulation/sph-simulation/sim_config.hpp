@@ -17,6 +17,17 @@ struct sim_config
 
    mannele::dimension_u32 dimensions;
    mannele::u32 frame_count;
+   /**
+    * @brief How many frames the CPU may record ahead of the GPU. Deeper queues favour throughput,
+    * shallower ones latency.
+    */
+   mannele::u32 frames_in_flight{2};
+   /**
+    * @brief Run a GPU density pass on the async compute queue next to the rendering. It only
+    * demonstrates the compute queue: the CPU solver still computes the densities the simulation
+    * uses, so it is off by default.
+    */
+   bool is_gpu_density_demo_enabled{false};
 
    std::chrono::duration<float, std::milli> time_step;
 
@@ -293,6 +293,30 @@ auto extract_scene_data(std::string&& str) -> result<sim_config, mannele::runtim
    data.frame_count = *it_frame_count;
    data.time_step = std::chrono::duration<float, std::milli>(*it_time_step);
 
+   if (const auto it = sph.find("frames_in_flight"); it != std::end(sph))
+   {
+      if (!it->is_number_unsigned() || *it == 0)
+      {
+         return err(mannele::runtime_error(
+            make_error_condition(scene_parse_error::e_frames_in_flight_field_error),
+            "The \"frames_in_flight\" field is not a positive integer"));
+      }
+
+      data.frames_in_flight = *it;
+   }
+
+   if (const auto it = sph.find("enable_gpu_density_demo"); it != std::end(sph))
+   {
+      if (!it->is_boolean())
+      {
+         return err(mannele::runtime_error(
+            make_error_condition(scene_parse_error::e_gpu_density_demo_field_error),
+            "The \"enable_gpu_density_demo\" field is not a bool"));
+      }
+
+      data.is_gpu_density_demo_enabled = *it;
+   }
+
    if (auto rendering = extract_rendering_data(*it_rendering))
    {
       data.is_onscreen_rendering_enabled = rendering.borrow().first;
@@ -19,6 +19,8 @@ enum class scene_parse_error
    e_rendering_field_error,
    e_framecount_field_error,
    e_time_step_field_error,
+   e_frames_in_flight_field_error,
+   e_gpu_density_demo_field_error,
    e_variables_field_error
 };
 
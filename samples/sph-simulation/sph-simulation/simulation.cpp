@@ -12,10 +12,16 @@
 #include <sph-simulation/physics/rigid_body.hpp>
 #include <sph-simulation/physics/system.hpp>
 
+#include <sph-simulation/sph/density_pass.hpp>
+#include <sph-simulation/sph/specialization.hpp>
 #include <sph-simulation/sph/system.hpp>
 
 #include <sph-simulation/render/core/camera.hpp>
+#include <sph-simulation/render/core/image.hpp>
 #include <sph-simulation/render/frame_manager.hpp>
+#include <sph-simulation/render/render_graph.hpp>
+
+#include <libmannele/tracing/trace.hpp>
 
 #include <range/v3/algorithm/max_element.hpp>
 #include <range/v3/range/conversion.hpp>
@@ -38,8 +44,11 @@
 #   pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
 #include <execution>
 #include <future>
+#include <optional>
+#include <thread>
 
 namespace vi = ranges::views;
 
@@ -48,55 +57,36 @@ using mannele::u64;
 
 using namespace reglisse;
 
+static constexpr u64 uniform_bytes_per_frame = 64ULL * 1024ULL;
+
+static const auto pipeline_cache_path = filepath("cache/pipeline_cache.bin"); // NOLINT
+
 struct mesh_data
 {
    glm::mat4 model;
    glm::vec3 colour;
 };
 
-auto main_colour_attachment(vk::Format format) -> vk::AttachmentDescription
-{
-   return {.format = format,
-           .samples = vk::SampleCountFlagBits::e1,
-           .loadOp = vk::AttachmentLoadOp::eClear,
-           .storeOp = vk::AttachmentStoreOp::eStore,
-           .stencilLoadOp = vk::AttachmentLoadOp::eDontCare,
-           .stencilStoreOp = vk::AttachmentStoreOp::eDontCare,
-           .initialLayout = vk::ImageLayout::eUndefined,
-           .finalLayout = vk::ImageLayout::ePresentSrcKHR};
-}
-
-auto main_depth_attachment(cacao::device& device) -> vk::AttachmentDescription
+struct draw_call
 {
-   if (auto val = find_depth_format(device))
-   {
-      return {.format = val.borrow(),
-              .samples = vk::SampleCountFlagBits::e1,
-              .loadOp = vk::AttachmentLoadOp::eClear,
-              .storeOp = vk::AttachmentStoreOp::eDontCare,
-              .stencilLoadOp = vk::AttachmentLoadOp::eDontCare,
-              .stencilStoreOp = vk::AttachmentStoreOp::eDontCare,
-              .initialLayout = vk::ImageLayout::eUndefined,
-              .finalLayout = vk::ImageLayout::eDepthStencilAttachmentOptimal};
-   }
-
-   return {};
-}
+   const renderable* p_mesh;
+   mesh_data data;
+};
 
 auto create_window(const sim_config& config) -> maybe<cacao::window>;
-auto create_render_command_pools(const cacao::device& device, mannele::log_ptr logger)
-   -> std::array<cacao::command_pool, max_frames_in_flight>;
+auto create_render_command_pools(const cacao::device& device, u32 frame_count,
+                                 mannele::log_ptr logger) -> std::vector<cacao::command_pool>;
+auto create_compute_command_pools(const cacao::device& device, u32 frame_count,
+                                  mannele::log_ptr logger) -> std::vector<cacao::command_pool>;
+auto create_recording_command_pools(const cacao::device& device, u32 frame_count,
+                                    u64 worker_count, u32 render_pass_count,
+                                    mannele::log_ptr logger)
+   -> std::vector<std::vector<cacao::command_pool>>;
 auto compute_matrices(const vk::Extent2D& extent) -> camera::matrices;
+auto make_backbuffer_info(const frame_manager& frame_man) -> imported_image_info;
 void setup_particles(entt::registry& registry, const sim_variables& variables,
                      const renderable& renderable);
-
-struct render_pass_data
-{
-   render_pass pass;
-
-   vk::Rect2D render_area;
-   std::array<vk::ClearValue, 2> clear_values;
-};
+void gather_draw_calls(entt::registry& registry, std::vector<draw_call>& draw_calls);
 
 struct update_info
 {
@@ -112,11 +102,21 @@ struct render_info
 
    frame_manager& frame_man;
    std::span<cacao::command_pool> pools;
+   std::span<std::vector<cacao::command_pool>> recording_pools;
+   std::span<cacao::command_pool> compute_pools;
 
-   std::span<render_pass_data> render_passes;
+   cacao::upload_service& uploads;
 
+   render_graph& graph;
+   resource_handle backbuffer;
+
+   cacao::gpu_profiler& profiler;
+
+   cacao::uniform_ring_buffer& uniforms;
    camera& main_camera;
 
+   sph::density_pass* p_density;
+
    entt::registry& registry;
 };
 
@@ -127,57 +127,190 @@ auto start_simulation(const simulation_info& info) -> int
 {
    auto logger = info.logger;
    auto window = cacao::window(
-      {.title = info.config.name, .dimension = info.config.dimensions, .is_resizable = false});
+      {.title = info.config.name, .dimension = info.config.dimensions, .is_resizable = true});
    auto context =
-      cacao::context({.min_vulkan_version = VK_MAKE_VERSION(1, 0, 0), .logger = logger});
+      cacao::context({.min_vulkan_version = VK_MAKE_VERSION(1, 2, 0), .logger = logger});
    auto surface = window.create_surface(context).take();
    auto device = cacao::device(
-      {.ctx = context, .surface = surface.get(), .use_transfer_queue = true, .logger = logger});
+      {.ctx = context,
+       .surface = surface.get(),
+       .use_transfer_queue = true,
+       .use_compute_queue = true,
+       .use_timeline_semaphores = true,
+       .use_host_query_reset = true,
+       .logger = logger});
+   const u32 frames_in_flight = info.config.frames_in_flight;
+
+   auto allocator = cacao::allocator(
+      {.device = device, .transient_frame_count = frames_in_flight, .logger = logger});
+
+   // Outlives the upload service, which may flush the frame submissions when destroyed
+   auto frame_man = frame_manager({.window = window,
+                                   .device = device,
+                                   .surface = surface.get(),
+                                   .image_usage = vk::ImageUsageFlagBits::eColorAttachment |
+                                      vk::ImageUsageFlagBits::eTransferSrc,
+                                   .frames_in_flight = frames_in_flight,
+                                   .logger = logger});
 
-   std::array render_command_pools = create_render_command_pools(device, logger);
-   auto transfer_pool = cacao::command_pool(cacao::command_pool_create_info{
-      .device = device,
-      .queue_family_index =
-         some(device.find_best_suited_queue(cacao::queue_flag_bits::transfer).family_index),
-      .primary_buffer_count = 0,
-      .secondary_buffer_count = 0,
-      .logger = logger});
+   auto uploads =
+      cacao::upload_service({.device = device, .allocator = allocator, .logger = logger});
+
+   auto render_command_pools = create_render_command_pools(device, frames_in_flight, logger);
+   auto compute_command_pools = create_compute_command_pools(device, frames_in_flight, logger);
 
    auto shaders = shader_registry(device, logger);
-   shaders.insert("shaders/test_vert.spv", cacao::shader_type::vertex);
-   shaders.insert("shaders/test_frag.spv", cacao::shader_type::fragment);
+   std::vector shader_infos = {
+      shader_load_info{.path = "shaders/test_vert.spv", .type = cacao::shader_type::vertex},
+      shader_load_info{.path = "shaders/test_frag.spv", .type = cacao::shader_type::fragment}};
+   if (info.config.is_gpu_density_demo_enabled)
+   {
+      shader_infos.push_back({.path = "shaders/sph/compute_density_pressure.comp.spv",
+                              .type = cacao::shader_type::compute});
+   }
+
+   for (const auto& res : shaders.insert_all(shader_infos))
+   {
+      if (res.is_err())
+      {
+         logger.error("Failed to load shader: {}",
+                      make_error_condition(res.borrow_err()).message());
+      }
+   }
 
    entt::registry entity_registry;
 
    std::vector<renderable> renderables;
-   renderables.push_back(create_renderable(
-      device, transfer_pool, load_obj(asset_default_dir / "meshes/sphere.obj"), logger));
-   renderables.push_back(create_renderable(
-      device, transfer_pool, load_obj(asset_default_dir / "meshes/cube.obj"), logger));
+   for (const auto* p_name : {"meshes/sphere.obj", "meshes/cube.obj"})
+   {
+      // The mapping only needs to live until the data is copied in the staging buffer
+      const auto mesh = load_mesh(asset_default_dir / p_name, logger);
+      if (mesh.is_err())
+      {
+         logger.error("Failed to load mesh {}: {}", p_name,
+                      make_error_condition(mesh.borrow_err()).message());
 
-   auto frame_man = frame_manager({.window = window,
-                                   .device = device,
-                                   .surface = surface.get(),
-                                   .image_usage = vk::ImageUsageFlagBits::eColorAttachment |
-                                      vk::ImageUsageFlagBits::eTransferSrc,
-                                   .logger = logger});
+         return EXIT_FAILURE;
+      }
+
+      renderables.push_back(
+         create_renderable(device, allocator, uploads, mesh.borrow(), glm::mat4{1}, logger));
+   }
+
+   // Mesh data is copied while the rest of the renderer is being set up
+   const auto mesh_upload = uploads.submit();
+
+   // The particle count is baked in the density pipeline
+   setup_particles(entity_registry, info.config.variables, renderables[0]);
+
+   auto cache = cacao::pipeline_cache(
+      {.device = device, .path = pipeline_cache_path, .logger = logger});
+   auto pipelines = pipeline_registry(cache, logger);
+
+   const auto depth_format = find_depth_format(device);
+   if (!depth_format)
+   {
+      logger.error("No supported depth format found");
+      logger.error("Application cannot proceed forward. Shutting down...");
+
+      return EXIT_FAILURE;
+   }
+
+   // Sets living as long as the simulation, never reset
+   auto descriptors = cacao::descriptor_allocator({.device = device, .logger = logger});
+
+   // Only there to exercise the async compute queue, nothing reads the densities it computes
+   std::optional<sph::density_pass> density;
+   if (info.config.is_gpu_density_demo_enabled)
+   {
+      const auto particle_count =
+         static_cast<u32>(entity_registry.view<sph::particle>().size());
+
+      auto density_shader_info =
+         shaders.lookup("shaders/sph/compute_density_pressure.comp.spv").borrow();
+      auto specialization = sph::make_density_pressure_specialization(
+         info.config.variables, particle_count, sph::density_pass::workgroup_size);
+
+      auto insertion_result = pipelines.insert(compute_pipeline_create_info{
+         .device = device,
+         .shader_info = {.p_shader = &density_shader_info.value(),
+                         .set_layouts = {{.name = "particles",
+                                          .bindings = {{.binding = 0,
+                                                        .descriptor_type =
+                                                           vk::DescriptorType::eStorageBuffer,
+                                                        .descriptor_count = 1}}}},
+                         .specialization = std::move(specialization)},
+         .logger = logger});
+
+      if (insertion_result.is_err())
+      {
+         logger.error("Failed to create SPH density pipeline");
+         logger.error("Application cannot proceed forward. Shutting down...");
 
-   auto pipelines = pipeline_registry(logger);
+         return EXIT_FAILURE;
+      }
+
+      const auto density_pipeline_key = insertion_result.borrow().key();
+      density.emplace(sph::density_pass_create_info{
+         .device = device,
+         .allocator = allocator,
+         .descriptors = descriptors,
+         .density_pipeline =
+            pipelines.lookup<pipeline_type::compute>(density_pipeline_key).borrow().value(),
+         .particle_count = particle_count,
+         .frame_count = frames_in_flight,
+         .logger = logger});
+   }
+
+   auto profiler =
+      cacao::gpu_profiler({.device = device, .frame_count = frames_in_flight, .logger = logger});
+
+   auto graph = render_graph(
+      {.device = device, .allocator = allocator, .p_profiler = &profiler, .logger = logger});
+
+   const auto backbuffer = graph.import_image(make_backbuffer_info(frame_man));
+   const auto depth = graph.create_image(
+      {.name = "depth", .format = depth_format.borrow(), .extent = frame_man.extent()});
+
+   // No graphics pass touches the particle buffers and there is one per frame in flight, so the
+   // pass runs on the compute queue alongside the rendering of the previous frame
+   std::optional<pass_handle> sph_density_pass;
+   if (density)
+   {
+      const auto particles =
+         graph.import_buffer({.name = "particles", .buffers = density->buffers()});
+
+      sph_density_pass =
+         graph.add_pass({.name = "sph_density",
+                         .type = pass_type::compute,
+                         .uses = {{.resource = particles,
+                                   .access = resource_access::storage_write,
+                                   .stages = vk::PipelineStageFlagBits::eComputeShader}},
+                         .queue = queue_type::async_compute});
+   }
 
-   std::array<vk::ClearValue, 2> clear_values{};
-   clear_values[0].color = {std::array{0.0F, 0.0F, 0.0F, 0.0F}};
-   clear_values[1].depthStencil = vk::ClearDepthStencilValue{1.0f, 0};
+   vk::ClearValue colour_clear{};
+   colour_clear.color = {std::array{0.0F, 0.0F, 0.0F, 0.0F}};
+   vk::ClearValue depth_clear{};
+   depth_clear.depthStencil = vk::ClearDepthStencilValue{1.0f, 0};
 
-   std::vector<render_pass_data> render_passes;
-   render_passes.push_back(
-      {.pass =
-          render_pass({.device = device,
-                       .colour_attachment = some(main_colour_attachment(frame_man.frame_format())),
-                       .depth_stencil_attachment = some(main_depth_attachment(device)),
-                       .framebuffer_create_infos = frame_man.get_framebuffer_info(),
-                       .logger = logger}),
-       .render_area = {.offset = {0, 0}, .extent = frame_man.extent()},
-       .clear_values = clear_values});
+   const auto main_pass = graph.add_pass(
+      {.name = "main",
+       .uses = {{.resource = backbuffer,
+                 .access = resource_access::colour_attachment,
+                 .clear = some(colour_clear)},
+                {.resource = depth,
+                 .access = resource_access::depth_stencil_attachment,
+                 .clear = some(depth_clear)}}});
+
+   graph.compile();
+
+   if (sph_density_pass)
+   {
+      graph.set_compute_calls(*sph_density_pass, [&](vk::CommandBuffer buffer, u64 frame_index) {
+         density->record(buffer, frame_index);
+      });
+   }
 
    pipeline_registry::key_type main_pipeline_key = 0;
    {
@@ -197,7 +330,8 @@ auto start_simulation(const simulation_info& info) -> int
             .p_shader = &vert_shader_info.value(),
             .set_layouts = {{.name = "camera_layout",
                              .bindings = {{.binding = 0,
-                                           .descriptor_type = vk::DescriptorType::eUniformBuffer,
+                                           .descriptor_type =
+                                              vk::DescriptorType::eUniformBufferDynamic,
                                            .descriptor_count = 1}}}},
             .push_constants = {{.name = "mesh_data", .size = sizeof(mesh_data), .offset = 0}}},
          pipeline_shader_data{.p_shader = &frag_shader_info.value()}};
@@ -220,12 +354,14 @@ auto start_simulation(const simulation_info& info) -> int
                                              .offset = offsetof(vertex, colour)}};
 
       auto insertion_result = pipelines.insert({.device = device,
-                                                .pass = render_passes.at(0).pass,
+                                                .pass = graph.pass(main_pass),
                                                 .logger = logger,
                                                 .bindings = bindings,
                                                 .attributes = attributes,
                                                 .viewports = viewports,
                                                 .scissors = scissors,
+                                                .dynamic_states = {vk::DynamicState::eViewport,
+                                                                   vk::DynamicState::eScissor},
                                                 .shader_infos = shader_data});
 
       if (insertion_result.is_ok())
@@ -241,86 +377,143 @@ auto start_simulation(const simulation_info& info) -> int
       }
    }
 
+   auto uniforms = cacao::uniform_ring_buffer({.device = device,
+                                               .allocator = allocator,
+                                               .frame_count = frames_in_flight,
+                                               .bytes_per_frame = uniform_bytes_per_frame,
+                                               .logger = logger});
+
    auto& main_pipeline =
       pipelines.lookup<pipeline_type::graphics>(main_pipeline_key).borrow().value();
    auto main_camera = camera({.device = device,
                               .layout = main_pipeline.get_descriptor_set_layout("camera_layout"),
-                              .image_count = static_cast<u32>(frame_man.image_count()),
+                              .uniforms = uniforms,
+                              .descriptors = descriptors,
                               .logger = logger});
 
-   render_passes[0].pass.record_render_calls([&](vk::CommandBuffer buffer, u64 image_index) {
-      auto& pipeline =
-         pipelines.lookup<pipeline_type::graphics>(main_pipeline_key).borrow().value();
+   std::vector<draw_call> draw_calls;
 
-      buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.value());
+   graph.set_parallel_render_calls(
+      main_pass, [&](vk::CommandBuffer buffer, u64 /*image_index*/, render_slice slice) {
+         const u64 first = slice.first(std::size(draw_calls));
+         const u64 last = slice.last(std::size(draw_calls));
 
-      buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline.layout(), 0,
-                                {main_camera.lookup_set(image_index)}, {});
+         if (first == last)
+         {
+            return;
+         }
 
-      auto view = entity_registry.view<component::mesh, transform>();
+         auto& pipeline =
+            pipelines.lookup<pipeline_type::graphics>(main_pipeline_key).borrow().value();
+         const auto push_stages = pipeline.get_push_constant_ranges("mesh_data").stageFlags;
 
-      for (auto& renderable : renderables)
-      {
-         buffer.bindVertexBuffers(0, {renderable.vertex_buff.buffer().value()},
-                                  {vk::DeviceSize{0}});
-         buffer.bindIndexBuffer(renderable.index_buff.buffer().value(), 0, vk::IndexType::eUint32);
+         buffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.value());
 
-         for (auto entity : view | vi::filter([&](auto e) {
-                               return view.get<component::mesh>(e).p_mesh == &renderable;
-                            }))
-         {
-            const auto& render = view.get<component::mesh>(entity);
-            const auto& transform = view.get<::transform>(entity);
+         // Dynamic so the pipeline survives swapchain recreation
+         const auto extent = frame_man.extent();
+         buffer.setViewport(0, {vk::Viewport{.x = 0.0F,
+                                             .y = 0.0F,
+                                             .width = static_cast<float>(extent.width),
+                                             .height = static_cast<float>(extent.height),
+                                             .minDepth = 0.0F,
+                                             .maxDepth = 1.0F}});
+         buffer.setScissor(0, {vk::Rect2D{.offset = {0, 0}, .extent = extent}});
 
-            const auto translate = glm::translate(glm::mat4(1), transform.position);
-            const auto scale = glm::scale(glm::mat4(1), transform.scale);
+         buffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline.layout(), 0,
+                                   {main_camera.descriptor_set()}, {main_camera.dynamic_offset()});
 
-            mesh_data md{.model = translate * scale, .colour = render.colour}; // NOLINT
+         const renderable* p_bound = nullptr;
+         for (const auto& call : std::span(draw_calls).subspan(first, last - first))
+         {
+            if (call.p_mesh != p_bound)
+            {
+               buffer.bindVertexBuffers(0, {call.p_mesh->vertex_buff.buffer().value()},
+                                        {vk::DeviceSize{0}});
+               buffer.bindIndexBuffer(call.p_mesh->index_buff.buffer().value(), 0,
+                                      vk::IndexType::eUint32);
+
+               p_bound = call.p_mesh;
+            }
 
-            buffer.pushConstants(pipeline.layout(),
-                                 pipeline.get_push_constant_ranges("mesh_data").stageFlags, 0,
-                                 sizeof(mesh_data) * 1, &md);
+            buffer.pushConstants(pipeline.layout(), push_stages, 0, sizeof(mesh_data) * 1,
+                                 &call.data);
 
-            buffer.drawIndexed(static_cast<std::uint32_t>(renderable.index_buff.index_count()), 1,
-                               0, 0, 0);
+            buffer.drawIndexed(static_cast<std::uint32_t>(call.p_mesh->index_buff.index_count()),
+                               1, 0, 0, 0);
          }
-      }
-   });
+      });
 
-   setup_particles(entity_registry, info.config.variables, renderables[0]);
+   // One pool per recording thread and frame in flight, holding a secondary buffer per pass
+   const u64 worker_count = std::max(1U, std::thread::hardware_concurrency());
+   auto recording_pools = create_recording_command_pools(
+      device, frames_in_flight, worker_count, graph.graphics_pass_count(), logger);
+
+   uploads.wait(mesh_upload);
 
    logger.info("Starting render...");
 
+   frame_stats total_stats{};
+
    u32 current_frame = 0;
    while (current_frame < info.config.frame_count)
    {
+      MANNELE_TRACE_ZONE_CAT("frame", "frame");
+
+      window.poll_events();
+
       update({.registry = entity_registry,
               .variables = info.config.variables,
               .time_step = info.config.time_step});
+      gather_draw_calls(entity_registry, draw_calls);
       render({.device = device,
               .frame_man = frame_man,
               .pools = render_command_pools,
-              .render_passes = render_passes,
+              .recording_pools = recording_pools,
+              .compute_pools = compute_command_pools,
+              .uploads = uploads,
+              .graph = graph,
+              .backbuffer = backbuffer,
+              .profiler = profiler,
+              .uniforms = uniforms,
               .main_camera = main_camera,
+              .p_density = density ? &density.value() : nullptr,
               .registry = entity_registry});
 
       ++current_frame;
 
+      const auto& stats = frame_man.last_frame_stats();
+      total_stats.cpu_wait += stats.cpu_wait;
+      total_stats.gpu_wait += stats.gpu_wait;
+
+      logger.debug("Frame {} waits: cpu {:.3f}ms, gpu {:.3f}ms", current_frame,
+                   stats.cpu_wait.count(), stats.gpu_wait.count());
+
       const float completion_rate =
          static_cast<float>(current_frame) / static_cast<float>(info.config.frame_count);
       logger.info("Render status: {:0>6.2f}%", 100.0f * completion_rate);
    }
 
    logger.info("Render Finished");
+   logger.info("Average waits with {} frames in flight: cpu {:.3f}ms, gpu {:.3f}ms",
+               frame_man.frames_in_flight(), total_stats.cpu_wait.count() / current_frame,
+               total_stats.gpu_wait.count() / current_frame);
+   profiler.log_statistics();
    logger.info("Closing program...");
 
    device.logical().waitIdle();
 
+   if (cache.save().is_err())
+   {
+      logger.warning("Failed to save the pipeline cache to {}", cache.path().string());
+   }
+
    return EXIT_SUCCESS;
 }
 
 void update(const update_info& info)
 {
+   MANNELE_TRACE_ZONE_CAT("update", "simulation");
+
    const auto particle_view = info.registry.view<PARTICLE_COMPONENTS>();
    const auto sphere_view = info.registry.view<SPHERE_COMPONENTS>();
    const auto plane_view = info.registry.view<PLANE_COMPONENTS>();
@@ -339,34 +532,84 @@ void update(const update_info& info)
 }
 void render(const render_info& info)
 {
+   MANNELE_TRACE_ZONE_CAT("render", "render");
+
    auto device = info.device.logical();
    auto& main_camera = info.main_camera;
 
-   const auto [image_index, frame_index] = info.frame_man.begin_frame().take();
+   const auto frame = info.frame_man.begin_frame();
+   if (!frame)
+   {
+      return;
+   }
+
+   const auto [image_index, frame_index, is_swapchain_recreated] = frame.borrow();
+
+   if (is_swapchain_recreated)
+   {
+      // Frames still in flight use the old framebuffers and transient images
+      info.frame_man.defer_destruction(
+         info.graph.reimport_image(info.backbuffer, make_backbuffer_info(info.frame_man)));
+   }
 
-   main_camera.update(image_index, compute_matrices(info.frame_man.extent()));
+   info.profiler.begin_frame(frame_index);
+   info.uniforms.begin_frame(frame_index);
+   main_camera.update(info.uniforms, compute_matrices(info.frame_man.extent()));
+   info.uniforms.flush_frame();
+   if (info.p_density)
+   {
+      info.p_density->update(info.registry.view<PARTICLE_COMPONENTS>(), frame_index);
+   }
    device.resetCommandPool(info.pools[frame_index].value(), {});
 
-   for (auto& buffer : info.pools[frame_index].primary_buffers())
+   const auto& recording_pools = info.recording_pools[frame_index];
+   for (const auto& pool : recording_pools)
    {
-      buffer.begin(vk::CommandBufferBeginInfo{});
+      device.resetCommandPool(pool.value(), {});
+   }
+
+   if (info.graph.has_async_passes())
+   {
+      // Submitted right away so it overlaps with the graphics work of the previous frame
+      const auto& compute_pool = info.compute_pools[frame_index];
+      device.resetCommandPool(compute_pool.value(), {});
+
+      MANNELE_TRACE_ZONE_CAT("record_async_compute", "render");
 
-      for (auto& render_pass : info.render_passes)
+      for (auto& buffer : compute_pool.primary_buffers())
       {
-         render_pass.pass.submit_render_calls(buffer, image_index, render_pass.render_area,
-                                              render_pass.clear_values);
+         buffer.begin(vk::CommandBufferBeginInfo{});
+
+         info.graph.execute_async(buffer, image_index, frame_index);
+
+         buffer.end();
       }
 
+      info.frame_man.submit_async_compute(compute_pool.primary_buffers(),
+                                          info.graph.async_wait_stages());
+   }
+
+   // Uploads recorded during the frame are flushed along with its graphics submission
+   info.uploads.submit(info.frame_man.submissions());
+
+   for (auto& buffer : info.pools[frame_index].primary_buffers())
+   {
+      buffer.begin(vk::CommandBufferBeginInfo{});
+
+      info.uploads.record_acquire_barriers(buffer);
+
+      info.graph.execute(buffer, image_index, frame_index, recording_pools);
+
       buffer.end();
    }
 
    info.frame_man.end_frame(info.pools);
 }
 
-auto create_render_command_pools(const cacao::device& device, mannele::log_ptr logger)
-   -> std::array<cacao::command_pool, max_frames_in_flight>
+auto create_render_command_pools(const cacao::device& device, u32 frame_count,
+                                 mannele::log_ptr logger) -> std::vector<cacao::command_pool>
 {
-   std::array<cacao::command_pool, max_frames_in_flight> pools;
+   std::vector<cacao::command_pool> pools(frame_count);
 
    for (auto& pool : pools)
    {
@@ -381,6 +624,60 @@ auto create_render_command_pools(const cacao::device& device, mannele::log_ptr l
 
    return pools;
 }
+auto create_compute_command_pools(const cacao::device& device, u32 frame_count,
+                                  mannele::log_ptr logger) -> std::vector<cacao::command_pool>
+{
+   std::vector<cacao::command_pool> pools(frame_count);
+
+   for (auto& pool : pools)
+   {
+      const cacao::queue desired_queue =
+         device.find_best_suited_queue(cacao::queue_flag_bits::compute);
+
+      pool = cacao::command_pool({.device = device,
+                                  .queue_family_index = some(desired_queue.family_index),
+                                  .primary_buffer_count = 1,
+                                  .logger = logger});
+   }
+
+   return pools;
+}
+auto create_recording_command_pools(const cacao::device& device, u32 frame_count,
+                                    u64 worker_count, u32 render_pass_count,
+                                    mannele::log_ptr logger)
+   -> std::vector<std::vector<cacao::command_pool>>
+{
+   const cacao::queue desired_queue = device.find_best_suited_queue(
+      cacao::queue_flag_bits::graphics | cacao::queue_flag_bits::present);
+
+   std::vector<std::vector<cacao::command_pool>> pools(frame_count);
+
+   for (auto& frame_pools : pools)
+   {
+      frame_pools.reserve(worker_count);
+
+      for ([[maybe_unused]] auto i : vi::iota(0U, worker_count))
+      {
+         frame_pools.emplace_back(
+            cacao::command_pool_create_info{.device = device,
+                                            .queue_family_index = some(desired_queue.family_index),
+                                            .secondary_buffer_count = render_pass_count,
+                                            .logger = logger});
+      }
+   }
+
+   return pools;
+}
+auto make_backbuffer_info(const frame_manager& frame_man) -> imported_image_info
+{
+   return {.name = "backbuffer",
+           .format = frame_man.frame_format(),
+           .extent = frame_man.extent(),
+           .images = {std::begin(frame_man.images()), std::end(frame_man.images())},
+           .views = frame_man.image_views(),
+           .initial_stages = vk::PipelineStageFlagBits::eColorAttachmentOutput,
+           .final_layout = vk::ImageLayout::ePresentSrcKHR};
+}
 auto compute_matrices(const vk::Extent2D& extent) -> camera::matrices
 {
    const auto width = static_cast<float>(extent.width);
@@ -396,6 +693,29 @@ auto compute_matrices(const vk::Extent2D& extent) -> camera::matrices
 
    return matrices;
 }
+void gather_draw_calls(entt::registry& registry, std::vector<draw_call>& draw_calls)
+{
+   MANNELE_TRACE_ZONE_CAT("gather_draw_calls", "render");
+
+   auto view = registry.view<component::mesh, transform>();
+
+   draw_calls.clear();
+   for (auto entity : view)
+   {
+      const auto& render = view.get<component::mesh>(entity);
+      const auto& transform = view.get<::transform>(entity);
+
+      const auto translate = glm::translate(glm::mat4(1), transform.position);
+      const auto scale = glm::scale(glm::mat4(1), transform.scale);
+
+      draw_calls.push_back(
+         {.p_mesh = render.p_mesh,
+          .data = {.model = translate * scale, .colour = render.colour}}); // NOLINT
+   }
+
+   // Keeps the draws of a mesh together so each slice rebinds its buffers as rarely as possible
+   std::ranges::stable_sort(draw_calls, std::less<>{}, &draw_call::p_mesh);
+}
 void setup_particles(entt::registry& registry, const sim_variables& variables,
                      const renderable& renderable)
 {
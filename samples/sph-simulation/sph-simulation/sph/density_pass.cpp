@@ -0,0 +1,111 @@
+#include <sph-simulation/sph/density_pass.hpp>
+
+#include <libmannele/tracing/trace.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace sph
+{
+   density_pass::density_pass(const density_pass_create_info& info) :
+      mp_pipeline(&info.density_pipeline), m_particle_count(info.particle_count),
+      m_logger(info.logger)
+   {
+      const auto& layout = mp_pipeline->get_descriptor_set_layout("particles");
+
+      m_buffers.reserve(info.frame_count);
+      m_descriptor_sets.reserve(info.frame_count);
+
+      for ([[maybe_unused]] mannele::u32 i = 0; i < info.frame_count; ++i)
+      {
+         const auto& buffer = m_buffers.emplace_back(cacao::buffer(
+            {.device = info.device,
+             .allocator = info.allocator,
+             .buffer_size = std::max<mannele::u64>(m_particle_count, 1) * sizeof(gpu_particle),
+             .usage = vk::BufferUsageFlagBits::eStorageBuffer,
+             .desired_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible |
+                vk::MemoryPropertyFlagBits::eHostCoherent,
+             .fallback_mem_flags = vk::MemoryPropertyFlagBits::eHostVisible,
+             .logger = info.logger}));
+
+         const auto set = m_descriptor_sets.emplace_back(info.descriptors.allocate(layout));
+
+         const std::array buffer_info = {vk::DescriptorBufferInfo{
+            .buffer = buffer.value(), .offset = 0, .range = VK_WHOLE_SIZE}};
+
+         const vk::WriteDescriptorSet write{.dstSet = set,
+                                            .dstBinding = 0,
+                                            .dstArrayElement = 0,
+                                            .descriptorCount = std::size(buffer_info),
+                                            .descriptorType = vk::DescriptorType::eStorageBuffer,
+                                            .pBufferInfo = std::data(buffer_info)};
+
+         info.device.logical().updateDescriptorSets({write}, {});
+      }
+
+      m_logger.debug("SPH density pass created for {} particles", m_particle_count);
+   }
+
+   void density_pass::update(const particle_view& particles, mannele::u64 frame_index)
+   {
+      MANNELE_TRACE_ZONE_CAT("sph::density_pass::update", "sph");
+
+      const auto& buffer = m_buffers[frame_index];
+      const auto memory = buffer.mapped();
+
+      // The pipeline is specialized for a particle count, extra particles are left out
+      mannele::u64 index = 0;
+      for (auto entity : particles)
+      {
+         if (index == m_particle_count)
+         {
+            break;
+         }
+
+         const auto& particle = particles.get<sph::particle>(entity);
+
+         gpu_particle data;
+         data.position = particles.get<transform>(entity).position;
+         data.velocity = particle.velocity;
+         data.force = particle.force;
+         data.normal = particle.normal;
+         data.radius = particle.radius;
+         data.mass = particle.mass;
+         data.density = particle.density;
+         data.pressure = particle.pressure;
+
+         std::memcpy(std::data(memory) + index * sizeof(gpu_particle), &data, sizeof(data));
+
+         ++index;
+      }
+
+      buffer.flush();
+   }
+
+   void density_pass::record(vk::CommandBuffer cmd, mannele::u64 frame_index) const
+   {
+      if (m_particle_count == 0)
+      {
+         return;
+      }
+
+      cmd.bindPipeline(vk::PipelineBindPoint::eCompute, mp_pipeline->value());
+      cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, mp_pipeline->layout(), 0,
+                             {m_descriptor_sets[frame_index]}, {});
+      cmd.dispatch((m_particle_count + workgroup_size - 1) / workgroup_size, 1, 1);
+   }
+
+   auto density_pass::buffers() const -> std::vector<vk::Buffer>
+   {
+      std::vector<vk::Buffer> buffers;
+      buffers.reserve(std::size(m_buffers));
+
+      for (const auto& buffer : m_buffers)
+      {
+         buffers.push_back(buffer.value());
+      }
+
+      return buffers;
+   }
+} // namespace sph
@@ -0,0 +1,106 @@
+#ifndef SPH_SIMULATION_SPH_DENSITY_PASS_HPP
+#define SPH_SIMULATION_SPH_DENSITY_PASS_HPP
+
+#include <sph-simulation/core/pipeline.hpp>
+#include <sph-simulation/sph/solver.hpp>
+
+#include <libcacao/allocator.hpp>
+#include <libcacao/buffer.hpp>
+#include <libcacao/descriptor_allocator.hpp>
+
+#include <libmannele/core.hpp>
+#include <libmannele/logging/log_ptr.hpp>
+
+#include <glm/ext/vector_float3.hpp>
+
+#include <vector>
+
+namespace sph
+{
+   /**
+    * @brief A particle laid out like the std430 `Particle` struct of
+    * `shaders/sph/compute_density_pressure.comp`, where every vec3 is aligned on 16 bytes.
+    */
+   struct gpu_particle
+   {
+      glm::vec3 position{};
+      float padding_0{};
+      glm::vec3 velocity{};
+      float padding_1{};
+      glm::vec3 force{};
+      float padding_2{};
+      glm::vec3 normal{};
+
+      float radius{};
+      float mass{};
+      float density{};
+      float pressure{};
+
+      float padding_3{};
+   };
+
+   static_assert(sizeof(gpu_particle) == 80); // NOLINT
+
+   struct density_pass_create_info
+   {
+      const cacao::device& device;
+      cacao::allocator& allocator;
+      cacao::descriptor_allocator& descriptors;
+
+      /**
+       * Pipeline of the shader specialized by make_density_pressure_specialization() for
+       * `particle_count` particles and density_pass::workgroup_size, with the particle buffer
+       * in its "particles" set layout.
+       */
+      const pipeline<pipeline_type::compute>& density_pipeline;
+
+      mannele::u32 particle_count{};
+      mannele::u32 frame_count{};
+
+      mannele::log_ptr logger;
+   };
+
+   /**
+    * @brief Compute the density and pressure of the particles on the GPU.
+    *
+    * The particles are copied in a host visible buffer per frame in flight, so the pass can run
+    * on the async compute queue without ever writing a buffer an earlier frame is still using.
+    * Nothing reads the results back, the pass only demonstrates the compute queue and is enabled
+    * by sim_config::is_gpu_density_demo_enabled.
+    */
+   class density_pass
+   {
+   public:
+      static constexpr mannele::u32 workgroup_size = 64;
+
+   public:
+      density_pass(const density_pass_create_info& info);
+
+      /**
+       * @brief Copy the particles in the buffer of `frame_index`. The GPU must be done with the
+       * previous frame that used it.
+       */
+      void update(const particle_view& particles, mannele::u64 frame_index);
+      /**
+       * @brief Record the dispatch computing the particles in the buffer of `frame_index`.
+       */
+      void record(vk::CommandBuffer cmd, mannele::u64 frame_index) const;
+
+      /**
+       * @brief The particle buffers, indexed by frame, to import in the render graph.
+       */
+      [[nodiscard]] auto buffers() const -> std::vector<vk::Buffer>;
+
+   private:
+      const pipeline<pipeline_type::compute>* mp_pipeline;
+
+      mannele::u32 m_particle_count{};
+
+      std::vector<cacao::buffer> m_buffers;
+      std::vector<vk::DescriptorSet> m_descriptor_sets;
+
+      mannele::log_ptr m_logger;
+   };
+} // namespace sph
+
+#endif // SPH_SIMULATION_SPH_DENSITY_PASS_HPP
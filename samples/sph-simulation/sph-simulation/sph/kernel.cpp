@@ -2,6 +2,19 @@
 
 namespace kernel
 {
+   auto compute_constants(float kernel_radius) -> constants
+   {
+      return {.radius = kernel_radius,
+              .radius2 = mannele::square(kernel_radius),
+              .poly6 = poly6_constant(kernel_radius),
+              .poly6_grad = poly6_grad_constant(kernel_radius),
+              .spiky = spiky_constant(kernel_radius),
+              .spiky_grad = spiky_grad_constant(kernel_radius),
+              .viscosity = viscosity_constant(kernel_radius),
+              .cohesion = cohesion_constant(kernel_radius),
+              .cohesion_offset = std::pow(kernel_radius, 6.0f) / 64.0f}; // NOLINT
+   }
+
    auto poly6_constant(float kernel_radius) -> float
    {
       return 315.0F / (65.0F * pi * std::pow(kernel_radius, 9.0F)); // NOLINT
@@ -40,13 +53,14 @@ namespace kernel
    {
       return 32.0f / (pi * std::pow(kernel_radius, 9.0f)); // NOLINT
    }
-   auto cohesion(float kernel_radius, float r) -> float
+   auto cohesion(const constants& values, float r) -> float
    {
+      const float kernel_radius = values.radius;
+
       if (r <= kernel_radius / 2.0f) // NOLINT
       {
-         const float offset = std::pow(kernel_radius, 6.0f) / 64.0f;
-
-         return 2.0f * mannele::cube(kernel_radius - r) * mannele::cube(r) - offset; // NOLINT
+         return 2.0f * mannele::cube(kernel_radius - r) * mannele::cube(r) - // NOLINT
+            values.cohesion_offset;
       }
 
       return mannele::cube(kernel_radius - r) * mannele::cube(r);
@@ -6,6 +6,26 @@
 
 namespace kernel
 {
+   /**
+    * @brief Normalization constants of every kernel for a given radius. They only depend on the
+    * scene, so they are computed once instead of for every particle.
+    */
+   struct constants
+   {
+      float radius;
+      float radius2;
+
+      float poly6;
+      float poly6_grad;
+      float spiky;
+      float spiky_grad;
+      float viscosity;
+      float cohesion;
+      float cohesion_offset;
+   };
+
+   auto compute_constants(float kernel_radius) -> constants;
+
    auto poly6_constant(float kernel_radius) -> float;
    auto poly6_grad_constant(float kernel_radius) -> float;
    auto poly6(float kernel_radius, float r) -> float;
@@ -20,5 +40,5 @@ namespace kernel
    auto viscosity(float kernel_radius, float r) -> float;
 
    auto cohesion_constant(float kernel_radius) -> float;
-   auto cohesion(float kernel_radius, float r) -> float;
+   auto cohesion(const constants& values, float r) -> float;
 }; // namespace kernel
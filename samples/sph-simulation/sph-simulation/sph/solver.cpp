@@ -5,11 +5,15 @@
 #include <glm/ext/quaternion_geometric.hpp>
 #include <glm/gtx/norm.hpp>
 
+#include <libmannele/tracing/trace.hpp>
+
 namespace sph
 {
-   void compute_density_pressure(const particle_view& particles, float m_kernel_radius,
-                                 float rest_density)
+   void compute_density_pressure(const particle_view& particles,
+                                 const kernel::constants& kernel_consts, float rest_density)
    {
+      MANNELE_TRACE_ZONE_CAT("sph::compute_density_pressure", "sph");
+
       parallel_for(particles, [&](const entt::entity& entity_i) {
          const auto& i_transform = particles.get<transform>(entity_i);
          auto& i_particle = particles.get<sph::particle>(entity_i);
@@ -24,21 +28,23 @@ namespace sph
             const auto r_ij = i_transform.position - j_transform.position;
             const auto r2 = glm::length2(r_ij);
 
-            if (r2 <= mannele::square(m_kernel_radius))
+            if (r2 <= kernel_consts.radius2)
             {
-               density += j_particle.mass * kernel::poly6(m_kernel_radius, r2);
+               density += j_particle.mass * kernel::poly6(kernel_consts.radius, r2);
             }
          }
 
-         i_particle.density = density * kernel::poly6_constant(m_kernel_radius);
+         i_particle.density = density * kernel_consts.poly6;
 
          float ratio = i_particle.density / rest_density;
          i_particle.pressure = ratio < 1.0f ? 0.0f : std::pow(ratio, 7.0f) - 1.0f; // NOLINT
       });
    }
 
-   void compute_normals(const particle_view& particles, float kernel_radius)
+   void compute_normals(const particle_view& particles, const kernel::constants& kernel_consts)
    {
+      MANNELE_TRACE_ZONE_CAT("sph::compute_normals", "sph");
+
       parallel_for(particles, [&](const entt::entity& entity_i) {
          const auto& i_transform = particles.get<transform>(entity_i);
          auto& i_particle = particles.get<sph::particle>(entity_i);
@@ -52,22 +58,27 @@ namespace sph
 
             const auto r_ij = i_transform.position - j_transform.position;
             const auto r2 = glm::length2(r_ij);
-            const auto h2 = mannele::square(kernel_radius);
 
-            if (r2 <= h2)
+            if (r2 <= kernel_consts.radius2)
             {
-               normal += (j_particle.mass / j_particle.density) * kernel::poly6_grad(r_ij, h2, r2);
+               normal += (j_particle.mass / j_particle.density) *
+                  kernel::poly6_grad(r_ij, kernel_consts.radius2, r2);
             }
          }
 
-         i_particle.normal = normal *
-            (i_particle.radius * kernel_radius * kernel::poly6_grad_constant(kernel_radius));
+         i_particle.normal =
+            normal * (i_particle.radius * kernel_consts.radius * kernel_consts.poly6_grad);
       });
    }
 
-   void compute_forces(const particle_view& view, float kernel_radius, float rest_density,
-                       float viscosity, float surface_tension, float gravity_mult)
+   void compute_forces(const particle_view& view, const kernel::constants& kernel_consts,
+                       float rest_density, float viscosity, float surface_tension,
+                       float gravity_mult)
    {
+      const float kernel_radius = kernel_consts.radius;
+
+      MANNELE_TRACE_ZONE_CAT("sph::compute_forces", "sph");
+
       const glm::vec3 gravity_vector{0.0f, gravity * gravity_mult, 0.0f};
 
       parallel_for(view, [&](const entt::entity& entity_i) {
@@ -110,17 +121,17 @@ namespace sph
                      (2.0f * rest_density) / (particle_i.density + particle_j.density);
 
                   cohesion_force += ((transform_i.position - transform_j.position) / r) *
-                     (kernel::cohesion(kernel_radius, r) * correction_factor);
+                     (kernel::cohesion(kernel_consts, r) * correction_factor);
                   curvature_force += correction_factor * (particle_i.normal - particle_j.normal);
                }
             }
          }
 
          gravity_force += gravity_vector * particle_i.density;
-         pressure_force *= kernel::spiky_constant(kernel_radius);
-         viscosity_force *= viscosity * kernel::viscosity_constant(kernel_radius);
+         pressure_force *= kernel_consts.spiky;
+         viscosity_force *= viscosity * kernel_consts.viscosity;
 
-         cohesion_force *= -surface_tension * kernel::cohesion_constant(kernel_radius) *
+         cohesion_force *= -surface_tension * kernel_consts.cohesion *
             mannele::square(particle_i.mass);
          curvature_force *= -surface_tension;
 
@@ -131,6 +142,8 @@ namespace sph
 
    void integrate(const particle_view& particles, duration<float> time_step)
    {
+      MANNELE_TRACE_ZONE_CAT("sph::integrate", "sph");
+
       parallel_for(particles, [&](const entt::entity& entity) {
          auto& transform = particles.get<::transform>(entity);
          auto& particle = particles.get<sph::particle>(entity);
@@ -143,11 +156,11 @@ namespace sph
    void solve(const particle_view& particles, const sim_variables& variables,
               duration<float> time_step)
    {
-      const auto kernel_radius = compute_kernel_radius(variables);
+      const auto kernel_consts = kernel::compute_constants(compute_kernel_radius(variables));
 
-      compute_density_pressure(particles, kernel_radius, variables.rest_density);
-      compute_normals(particles, kernel_radius);
-      compute_forces(particles, kernel_radius, variables.rest_density, variables.viscosity_constant,
+      compute_density_pressure(particles, kernel_consts, variables.rest_density);
+      compute_normals(particles, kernel_consts);
+      compute_forces(particles, kernel_consts, variables.rest_density, variables.viscosity_constant,
                      variables.surface_tension_coefficient, variables.gravity_multiplier);
       integrate(particles, time_step);
    }
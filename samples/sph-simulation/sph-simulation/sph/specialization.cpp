@@ -0,0 +1,29 @@
+#include <sph-simulation/sph/specialization.hpp>
+
+#include <sph-simulation/sph/kernel.hpp>
+
+namespace sph
+{
+   auto make_density_pressure_specialization(const sim_variables& variables,
+                                             mannele::u32 particle_count,
+                                             mannele::u32 workgroup_size) -> specialization_data
+   {
+      using constant = density_pressure_constant;
+
+      const auto kernel_consts = kernel::compute_constants(compute_kernel_radius(variables));
+
+      const auto id = [](constant value) {
+         return static_cast<mannele::u32>(value);
+      };
+
+      specialization_data data;
+      data.set(id(constant::workgroup_size), workgroup_size)
+         .set(id(constant::particle_count), particle_count)
+         .set(id(constant::kernel_radius2), kernel_consts.radius2)
+         .set(id(constant::poly6_constant), kernel_consts.poly6)
+         .set(id(constant::rest_density), variables.rest_density)
+         .set(id(constant::kernel_radius), kernel_consts.radius);
+
+      return data;
+   }
+} // namespace sph
@@ -0,0 +1,37 @@
+#ifndef SPH_SIMULATION_SPH_SPECIALIZATION_HPP
+#define SPH_SIMULATION_SPH_SPECIALIZATION_HPP
+
+#include <sph-simulation/core/pipeline.hpp>
+#include <sph-simulation/sim_variables.hpp>
+
+#include <libmannele/core.hpp>
+
+namespace sph
+{
+   /**
+    * @brief Ids of the specialization constants declared by
+    * `shaders/sph/compute_density_pressure.comp`.
+    */
+   enum struct density_pressure_constant : mannele::u32
+   {
+      workgroup_size = 0,
+      particle_count = 1,
+      kernel_radius2 = 2,
+      poly6_constant = 3,
+      rest_density = 4,
+      kernel_radius = 5
+   };
+
+   /**
+    * @brief Specialize the density and pressure compute shader for a scene. The particle count
+    * bounds the neighbour loop and the kernel constants are precomputed, so the driver can unroll
+    * and fold them instead of reading them from a buffer every dispatch. Each distinct scene gets
+    * its own pipeline variant in the pipeline_registry.
+    */
+   auto make_density_pressure_specialization(const sim_variables& variables,
+                                             mannele::u32 particle_count,
+                                             mannele::u32 workgroup_size = 64)
+      -> specialization_data;
+} // namespace sph
+
+#endif // SPH_SIMULATION_SPH_SPECIALIZATION_HPP
@@ -3,12 +3,18 @@
 #include <sph-simulation/sph/collision/detection.hpp>
 #include <sph-simulation/sph/solver.hpp>
 
+#include <libmannele/tracing/trace.hpp>
+
 namespace sph
 {
    void update(const system_update_info &info)
    {
+      MANNELE_TRACE_ZONE_CAT("sph::update", "sph");
+
       solve(info.particles, info.variables, info.time_step);
 
+      MANNELE_TRACE_ZONE_CAT("sph::resolve_plane_collisions", "sph");
+
       auto contacts = detect_particle_and_plane_collision(info.particles, info.planes);
 
       for (auto contact_data : contacts)